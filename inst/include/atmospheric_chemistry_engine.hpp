@@ -0,0 +1,101 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef ATMOSPHERIC_CHEMISTRY_ENGINE_HPP
+#define ATMOSPHERIC_CHEMISTRY_ENGINE_HPP
+/*
+ *  atmospheric_chemistry_engine.hpp
+ *  hector
+ *
+ *  Advance OH lifetime, CH4, and N2O together.
+ *
+ */
+
+#include <vector>
+
+namespace Hector {
+
+class Core;
+class IModelComponent;
+class OHComponent;
+class CH4Component;
+class N2OComponent;
+class SimpleNbox;
+
+//------------------------------------------------------------------------------
+/*! \brief Runs the OH, CH4, and N2O chemistry in a single routine per year.
+ *
+ *  Normally OHComponent asks the CH4 component for last year's
+ *  concentration, CH4Component asks for this year's OH lifetime and the
+ *  carbon cycle's CH4 respiration, and both look up their emissions (and OH
+ *  its first-year emissions) in their time series each year.  The engine
+ *  instead keeps the state in plain doubles, tabulates the emissions and
+ *  constraints by year, caches the first-year emissions, and reads the
+ *  carbon cycle's CH4 respiration directly.  The equations themselves are
+ *  the components', so the results are identical to the per-component
+ *  calculation.
+ *
+ *  The components are kept as the engine's front ends: they still take the
+ *  inputs, and the engine stores its results in their time series, so every
+ *  existing capability works unchanged.  Changing any input of an attached
+ *  component, resetting it, or preparing it to run makes the engine reload
+ *  its tables before the next year.
+ */
+class AtmosphericChemistryEngine {
+public:
+  AtmosphericChemistryEngine(Core *core,
+                             const std::vector<IModelComponent *> &components);
+
+  void run(const double runToDate);
+
+  //! Reload parameters, inputs, and state before the next year is run.
+  void invalidate() { stale = true; }
+
+  //! True if the engine runs the OH and CH4 components.
+  bool hasMethane() const { return oh && ch4; }
+
+  //! True if the engine runs the N2O component.
+  bool hasN2O() const { return n2o != NULL; }
+
+private:
+  void load(const double runToDate);
+
+  void extend(const double newLastDate);
+
+  void runMethane(const double runToDate, const std::size_t y);
+
+  void runN2O(const double runToDate, const std::size_t y);
+
+  Core *core;
+  OHComponent *oh;
+  CH4Component *ch4;
+  N2OComponent *n2o;
+  SimpleNbox *cc; //!< carbon cycle, for CH4 respiration (may be NULL)
+
+  //! First-year emissions of NOX (Tg N), CO (Tg CO), and NMVOC (Tg NMVOC)
+  double NOX0, CO0, NMVOC0;
+
+  // State at lastDate
+  double ch4Conc; //!< ppbv CH4
+  double n2oConc; //!< ppbv N2O
+
+  //! Inputs by year, starting at firstDate.  Constraints are NaN where there
+  //! isn't one; emissions are NaN where they can't be found, which is only an
+  //! error if they're needed.
+  std::vector<double> E_NOX, E_CO, E_NMVOC, E_CH4, E_CH4N, CH4_constrain;
+  std::vector<double> E_N2O, E_N2ON, N2O_constrain;
+  double firstDate;
+  double lastTableDate;
+
+  //! Last date run.
+  double lastDate;
+
+  bool stale;
+};
+
+} // namespace Hector
+
+#endif // ATMOSPHERIC_CHEMISTRY_ENGINE_HPP
@@ -20,12 +20,18 @@
 #include "tseries.hpp"
 #include "unitval.hpp"
 
+//! Converts permafrost CH4 respiration (Pg C) to CH4 emissions (Tg CH4)
+#define PG_C_TO_TG_CH4 (1000.0 * 16.04 / 12.01)
+
 namespace Hector {
 
+class AtmosphericChemistryEngine;
+
 //------------------------------------------------------------------------------
 /*! \brief Methane model component.
  */
 class CH4Component : public IModelComponent {
+  friend class AtmosphericChemistryEngine;
 
 public:
   CH4Component();
@@ -46,6 +52,8 @@ public:
 
   virtual void run(const double runToDate);
 
+  virtual bool runAhead(const double firstDate, const double lastDate);
+
   virtual void reset(double time);
 
   virtual void shutDown();
@@ -55,6 +63,11 @@ public:
 
 private:
   virtual unitval getData(const std::string &varName, const double date);
+
+  double step(const double previous_ch4, const double toh,
+              const double emissions, const double rh_ch4,
+              const double natural) const;
+
   //! emissions time series
   tseries<unitval> CH4_emissions;
   tseries<unitval> CH4;           // CH4 concentrations, ppbv CH4
@@ -70,6 +83,10 @@ private:
 
   Core *core;
   double oldDate;
+  double aheadDate; // last date computed by runAhead()
+
+  //! Engine that runs this component, if any.
+  AtmosphericChemistryEngine *engine;
 };
 
 } // namespace Hector
@@ -27,6 +27,10 @@
 #define D_TRACKING_DATE "trackingDate"
 #define D_DO_SPINUP "do_spinup"
 #define D_MAX_SPINUP "max_spinup"
+#define D_COMPONENT_THREADS "component_threads"
+#define D_HALOCARBON_ENGINE "halocarbon_engine"
+#define D_SHORT_LIVED_ENGINE "short_lived_engine"
+#define D_CHEMISTRY_ENGINE "chemistry_engine"
 #define D_ENABLED "enabled"
 #define D_OUTPUT_ENABLED "output"
 
@@ -18,6 +18,9 @@
 
 #define CORE_COMPONENT_NAME "core"
 
+//! Not a component: the input section that lists the outputs to write
+#define OUTPUT_SECTION_NAME "output"
+
 #define CCS_COMPONENT_NAME "carbon-cycle-solver"
 #define BOX_MODEL_COMPONENT_NAME "carbon-box-model"
 #define SIMPLENBOX_COMPONENT_NAME "simpleNbox"
@@ -0,0 +1,131 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef COMPONENT_SCHEDULER_HPP
+#define COMPONENT_SCHEDULER_HPP
+/*
+ *  component_scheduler.hpp
+ *  hector
+ *
+ *  Run independent model components concurrently within a year.
+ *
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logger.hpp"
+
+namespace Hector {
+
+class IModelComponent;
+
+//------------------------------------------------------------------------------
+/*! \brief Runs a core's components for one year, in parallel where possible.
+ *
+ *  Components are grouped into levels such that no two components in a level
+ *  depend on each other or exchange any messages; the levels are run in
+ *  order, and the components within a level are run concurrently on a small
+ *  thread pool.
+ *
+ *  Declared dependencies alone aren't enough to build the levels, because
+ *  components also read each other's state without declaring it (e.g. the
+ *  previous year's value of a variable from a component that runs later).
+ *  So the first year is run sequentially, in the core's dependency order,
+ *  and every message between components is recorded.  Any two components
+ *  that exchanged a message are then kept in different levels, in the same
+ *  relative order as before, so every component sees exactly the data it
+ *  would have seen in a sequential run and results are identical.  (Since a
+ *  component may also act directly on a component it depends on, anything
+ *  that exchanges messages with a component is also kept apart from that
+ *  component's dependents.  Declared dependencies are treated the same way,
+ *  as components may not use all of them in the first year.)
+ *
+ *  In later years, messages are checked against this record.  A new exchange
+ *  between components that may run concurrently, or out of their original
+ *  order, would make the results depend on thread timing; so the component
+ *  sending it is stopped, run() reports that the year must be rerun, and the
+ *  next call runs the year sequentially again, recording its messages and
+ *  rebuilding the levels.
+ */
+class ComponentScheduler {
+public:
+  ComponentScheduler(const std::vector<IModelComponent *> &components,
+                     const std::vector<std::vector<bool>> &dependencies,
+                     const int nthreads, Logger &glog);
+  ~ComponentScheduler();
+
+  bool run(const double date);
+
+  void noteMessage(const IModelComponent *target);
+
+  //! The component levels (as indices into the component list); empty until
+  //! the first year has been run.
+  const std::vector<std::vector<std::size_t>> &getLevels() const {
+    return levels;
+  }
+
+private:
+  // Not copyable
+  ComponentScheduler(const ComponentScheduler &);
+  ComponentScheduler &operator=(const ComponentScheduler &);
+
+  void buildLevels();
+  bool apart(const std::size_t a, const std::size_t b) const;
+  void runLevel(const std::vector<std::size_t> &level, const double date);
+  void runComponent(const std::size_t idx, const double date);
+  void work(const std::vector<std::size_t> &level, const double date);
+  void workerLoop();
+
+  //! Components in the core's (sequential) run order.
+  std::vector<IModelComponent *> components;
+  //! dependencies[i][j]: component j declared a dependency on component i.
+  std::vector<std::vector<bool>> dependencies;
+  //! Position of each component in the components list.
+  std::map<const IModelComponent *, std::size_t> componentIndex;
+  //! messaged[i][j]: component i has sent a message to component j.
+  std::vector<std::vector<char>> messaged;
+  //! linked[i][j]: components i and j must not run concurrently, and must
+  //! run in their original order.  Built from declared dependencies and
+  //! observed messages.
+  std::vector<std::vector<char>> linked;
+  //! Level of each component.
+  std::vector<std::size_t> levelOf;
+  std::vector<std::vector<std::size_t>> levels;
+
+  //! Exception thrown by each component in the current level, if any.
+  std::vector<std::exception_ptr> errors;
+  //! Set when a component sends a message the levels don't allow for.
+  std::atomic<bool> stale;
+  //! The first such message, for the log.
+  std::string staleNote;
+
+  Logger &glog;
+
+  // Thread pool state.  The main thread posts a level by bumping generation;
+  // workers (and the main thread) then claim components with next.
+  std::vector<std::thread> pool;
+  std::mutex poolMutex;
+  std::condition_variable workReady;
+  std::condition_variable workDone;
+  unsigned long generation;
+  bool stopping;
+  const std::vector<std::size_t> *currentLevel;
+  double currentDate;
+  std::atomic<std::size_t> next;
+  std::size_t pending;
+  std::size_t busyWorkers;
+};
+
+} // namespace Hector
+
+#endif // COMPONENT_SCHEDULER_HPP
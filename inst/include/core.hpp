@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,12 @@ namespace Hector {
 class unitval;
 struct message_data;
 class IModelComponent;
+class ComponentScheduler;
+class AtmosphericChemistryEngine;
+class HalocarbonEngine;
+class ShortLivedForcerEngine;
+class Scenario;
+struct ScenarioSetting;
 
 //------------------------------------------------------------------------------
 /*! \brief Core class.
@@ -37,7 +44,7 @@ class IModelComponent;
 class Core : public IVisitable {
 public:
   Core(Logger::LogLevel loglvl = Logger::DEBUG, bool echotoscreen = true,
-       bool echotofile = true);
+       bool echotofile = true, std::size_t logrecords = 0);
   ~Core();
 
   const std::string &getComponentName() const;
@@ -47,6 +54,10 @@ public:
   void setData(const std::string &componentName, const std::string &varName,
                const message_data &data);
 
+  void applyScenario(const Scenario &scenario);
+  void applyScenario(const Scenario &scenario,
+                     const std::vector<ScenarioSetting> &overrides);
+
   void addVisitor(AVisitor *visitor);
 
   void prepareToRun();
@@ -80,13 +91,57 @@ public:
 
   unitval getData(const std::string &varName, const double date);
 
+  void getDataBlock(const std::vector<std::string> &datums,
+                    const std::vector<double> &dates,
+                    std::vector<double> &values,
+                    std::vector<std::string> &units);
+
   double getStartDate() const { return startDate; };
   double getEndDate() const { return endDate; };
   double getTrackingDate() const { return trackingDate; };
   std::string getTrackingData() const;
+  //! The last date run; during a run, the date whose time step has just
+  //! finished, which is the date visitors are visiting
   double getCurrentDate() const { return lastDate; }
   std::string getRun_name() const { return run_name; };
   bool inSpinup() const { return in_spinup; };
+  //! The halocarbon engine, or NULL if the halocarbons are run separately.
+  HalocarbonEngine *getHalocarbonEngine() const {
+    return halocarbonEngine.get();
+  }
+  //! The chemistry engine, or NULL if OH, CH4, and N2O run as separate
+  //! components.
+  AtmosphericChemistryEngine *getChemistryEngine() const {
+    return chemistryEngine.get();
+  }
+  //! The short-lived forcer engine, or NULL if the forcings are computed
+  //! year by year.
+  const ShortLivedForcerEngine *getShortLivedForcerEngine() const {
+    return shortLivedEngine.get();
+  }
+  //! A variable that output visitors should write, and the years to write.
+  struct OutputSubscription {
+    //! The component to ask for the datum, or empty to ask the one that
+    //! provides it as a capability
+    std::string componentName;
+    std::string datum; //!< variable name, optionally with a biome prefix
+    double first;      //!< first year to write
+    double last;       //!< last year to write
+    //! The component to ask (NULL if it's the core); set when the model is
+    //! set up
+    IModelComponent *component;
+    //! How the datum is fetched: by date, or only as its current value;
+    //! found when the model is set up if possible, else when first written
+    enum { DATING_UNKNOWN, DATED, UNDATED } dating;
+  };
+  void subscribeOutput(const std::string &datum, const double first,
+                       const double last);
+  unitval getOutput(const std::size_t i, const double date);
+  void clearOutputSubscriptions() { outputSubscriptions.clear(); }
+  //! The outputs to write; if there are none, visitors write everything.
+  const std::vector<OutputSubscription> &getOutputSubscriptions() const {
+    return outputSubscriptions;
+  }
   bool outputEnabled(std::string componentName) {
     return std::find(disabledOutputComponents.begin(),
                      disabledOutputComponents.end(),
@@ -114,6 +169,8 @@ public:
   void renameBiome(const std::string &oldname, const std::string &newname);
 
 private:
+  friend class Scenario;
+
   //! Registry of instantiated cores
   //! \details This is used when you are instantiating hector cores
   //! from a language other than C++.  Instead of trying to convert
@@ -131,6 +188,9 @@ private:
   //! Cause all components to run their spinup procedure.
   bool run_spinup();
 
+  //! Strip an optional biome prefix from a datum, leaving the capability.
+  static std::string getDatumCapability(const std::string &datum);
+
   //------------------------------------------------------------------------------
   //! Current run name.
   std::string run_name;
@@ -163,6 +223,42 @@ private:
   //! Maximum number of spinup steps allowed.
   int max_spinup;
 
+  //------------------------------------------------------------------------------
+  //! Number of threads to run components on within each year (1 = run them
+  //! sequentially).
+  int component_threads;
+
+  //------------------------------------------------------------------------------
+  //! Runs the components each year when component_threads > 1.
+  std::unique_ptr<ComponentScheduler> scheduler;
+
+  //------------------------------------------------------------------------------
+  //! A flag (can be set from input) to run all halocarbons together in a
+  //! HalocarbonEngine.
+  bool use_halocarbon_engine;
+
+  //------------------------------------------------------------------------------
+  //! Runs the halocarbons each year when use_halocarbon_engine is set.
+  std::unique_ptr<HalocarbonEngine> halocarbonEngine;
+
+  //------------------------------------------------------------------------------
+  //! A flag (can be set from input) to run OH, CH4, and N2O in an
+  //! AtmosphericChemistryEngine.
+  bool use_chemistry_engine;
+
+  //------------------------------------------------------------------------------
+  //! Runs OH, CH4, and N2O when use_chemistry_engine is set.
+  std::unique_ptr<AtmosphericChemistryEngine> chemistryEngine;
+
+  //------------------------------------------------------------------------------
+  //! A flag (can be set from input) to compute the short-lived forcings in a
+  //! ShortLivedForcerEngine.
+  bool use_short_lived_engine;
+
+  //------------------------------------------------------------------------------
+  //! Computes the short-lived forcings when use_short_lived_engine is set.
+  std::unique_ptr<ShortLivedForcerEngine> shortLivedEngine;
+
   //------------------------------------------------------------------------------
   //! A comparison object to ensure modelComponents are ordered according to
   //! dependencies.
@@ -220,6 +316,17 @@ private:
   // A list of components whose output has been disabled
   std::vector<std::string> disabledOutputComponents;
 
+  // The outputs that visitors should write, if only some are wanted
+  std::vector<OutputSubscription> outputSubscriptions;
+
+  void resolveOutputSubscription(OutputSubscription &sub);
+  unitval fetchOutput(const OutputSubscription &sub, const double date);
+  void findOutputDating(OutputSubscription &sub, const double date);
+
+  //! If set, every setData() call is added to it; used by Scenario to record
+  //! an input file.
+  std::vector<ScenarioSetting> *settingsLog;
+
   // Some helpful typedefs to clean up syntax
   typedef std::multimap<std::string, std::string>::iterator
       componentMapIterator;
@@ -17,12 +17,18 @@
 #include <string>
 
 #include "avisitor.hpp"
+#include "unitval.hpp"
 
 #define DELIMITER ","
 
 namespace Hector {
 
+class IModelComponent;
+
 /*! \brief A visitor which will report all results at each model period.
+ *
+ *  If the core has output subscriptions (see Core::subscribeOutput()), only
+ *  the subscribed outputs are reported, and the components aren't visited.
  */
 class CSVOutputStreamVisitor : public AVisitor {
 public:
@@ -30,6 +36,8 @@ public:
                          const bool printHeader = true);
   ~CSVOutputStreamVisitor();
 
+  void flush();
+
   virtual bool shouldVisit(const bool in_spinup, const double date);
 
   virtual void visit(Core *c);
@@ -65,8 +73,28 @@ private:
   //! Name of current run
   std::string run_name;
 
-  //! Helper function: prints beginning of each output line
-  std::string linestamp();
+  //! Text that starts every output line (date, run name, and spinup flag),
+  //! rendered whenever one of them changes
+  std::string linestamp;
+
+  //! Helper function: re-render linestamp
+  void updateLinestamp();
+
+  //! Helper function: should a component's outputs all be written?
+  bool outputEnabled(const IModelComponent *c) const;
+
+  //! Helper function: write the subscribed outputs for current_date
+  void writeSubscriptions();
+
+  //! Helper function: append one output line to the buffer
+  void writeLine(const std::string &component, const std::string &name,
+                 const unitval &x);
+
+  //! Output lines not yet written to csvFile
+  std::string buffer;
+
+  //! Buffer size at which it's written to csvFile
+  static const std::size_t BLOCK_SIZE = 1 << 16;
 
   //! pointers to other components and stuff
   Core *core;
@@ -15,6 +15,8 @@
  */
 
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "h_exception.hpp"
 
@@ -35,8 +37,9 @@ class Core;
  *
  *  When instructed to process the class requires routing information including
  *  the variable to set so that it can identify which column to process.  It
- * will then route data as each row is read.  Note that the file will remain
- * open and available for reprocessing until it is destructed.
+ * will then route data from each row.  The file is read and split into cells
+ * the first time it is processed, and the cells are kept, so processing other
+ * columns of the same table doesn't read it again.
  */
 class CSVTableReader {
 public:
@@ -56,8 +59,27 @@ private:
   //! Current line (that has just been read)
   int lineNum;
 
+  //! Whether the table has been read into header and rows yet
+  bool loaded;
+
+  //! The header row, trimmed
+  std::vector<std::string> header;
+
+  //! A row of the table, with its cells trimmed
+  struct Row {
+    int lineNum;                    //!< line in the file, for errors
+    bool isUnits;                   //!< true for a UNITS row
+    double date;                    //!< the index, for data rows
+    std::vector<std::string> cells; //!< all cells, including the first
+  };
+
+  //! The rows after the header, in file order
+  std::vector<Row> rows;
+
   // Helper function to find next non-commented line
   std::string csv_getline();
+
+  void load();
 };
 
 } // namespace Hector
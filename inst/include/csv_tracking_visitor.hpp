@@ -14,7 +14,11 @@
  *
  */
 
+#include <fstream>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "avisitor.hpp"
 #include "fluxpool.hpp"
@@ -25,10 +29,23 @@
 namespace Hector {
 /*! \brief A visitor which will the contents of each tracked pool at each model
  * period.
+ *
+ * Output lines are appended to a buffer as they're generated.  If the visitor
+ * was given an output file or stream, the buffer is written to it in blocks,
+ * so memory use is bounded however long the run; otherwise all the output is
+ * kept, for outputTrackingData().  Either way, the visitor records where each
+ * year's output starts, so that reset() can discard the output for later
+ * years.  Output that has already been written to a file is rewound by
+ * seeking back in it, and the file is truncated when the visitor is done if
+ * the output is then shorter; output already written to a stream can't be
+ * rewound.
  */
 class CSVFluxPoolVisitor : public AVisitor {
 public:
+  CSVFluxPoolVisitor();
   CSVFluxPoolVisitor(std::ostream &outputStream, const bool printHeader = true);
+  CSVFluxPoolVisitor(const std::string &fileName,
+                     const bool printHeader = true);
   ~CSVFluxPoolVisitor();
 
   virtual bool shouldVisit(const bool in_spinup, const double date);
@@ -40,14 +57,41 @@ public:
   virtual void outputTrackingData(std::ostream &tracking_out) const;
 
 private:
-  //! The file output stream in which the csv output will be written to.
-  std::ostream &csvFile;
+  //! The file output stream in which the csv output will be written to, or
+  //! NULL to keep the output in memory.
+  std::ostream *csvFile;
+
+  //! The output file, if the visitor was given a file name
+  std::unique_ptr<std::ofstream> ownedFile;
+  std::string fileName;
 
   //! The buffer—holds output until ready to be returned to the core or written
   //! to the csv file
-  tseries<string> csvBuffer;
+  string csvBuffer;
   string header;
 
+  //! Date and position (in the output, not counting the header) at which each
+  //! year's output starts
+  std::vector<std::pair<double, std::streamoff>> yearStarts;
+
+  //! Bytes of output written to csvFile; csvBuffer holds what follows
+  std::streamoff written;
+
+  //! Furthest extent of the output written to csvFile, which is further than
+  //! written if it has been rewound
+  std::streamoff writtenEnd;
+
+  //! True once the header has been written to csvFile
+  bool started;
+
+  //! Position in csvFile at which the output starts (after the header)
+  std::streampos origin;
+
+  //! Buffer size at which it's written to csvFile
+  static const std::size_t BLOCK_SIZE = 1 << 16;
+
+  void writeBuffer();
+
   // Data retained while the visitor is operating
   double current_date;
   double tracking_date;
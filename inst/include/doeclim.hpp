@@ -0,0 +1,349 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef DOECLIM_HPP
+#define DOECLIM_HPP
+/*
+ *  doeclim.hpp
+ *  hector
+ *
+ *  The DOECLIM equations, templated on the number type.
+ *
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "doeclim_kernel.hpp"
+#include "h_exception.hpp"
+
+namespace Hector {
+
+template <std::size_t N> class Dual;
+
+//------------------------------------------------------------------------------
+/*! \brief DOECLIM's coefficients and time step.
+ *
+ *  The one implementation of the model's equations (Kriegler 2005; Tanaka
+ *  and Kriegler 2007): prepare() derives the coefficients from the
+ *  parameters, and inputs(), solve() and heatFlux() take one time step.
+ *  TemperatureComponent runs it in doubles; LinearTemperatureResponse steps
+ *  it to find its impulse responses, and TemperatureSensitivity runs it in
+ *  dual numbers (see Dual) to get derivatives by parameter.
+ */
+template <class T> class DOECLIM {
+public:
+  typedef std::shared_ptr<const std::vector<T>> kernel_ptr;
+
+  void prepare(const int ns, const T &S, const T &diff, const T &qco2);
+
+  void inputs(const double Q, const double Qprev, T &DQ1, T &DQ2) const;
+
+  void solve(const int tstep, const T &DQ1, const T &DQ2,
+             std::vector<T> &temp_landair, std::vector<T> &temp_sst) const;
+
+  void heatFlux(const int tstep, const std::vector<T> &temp_sst,
+                std::vector<T> &heatflux_mixed,
+                std::vector<T> &heatflux_interior, std::vector<T> &heat_mixed,
+                std::vector<T> &heat_interior) const;
+
+  //! Global air temperature, from the land air and sea surface temperatures
+  T airTemperature(const T &landair, const T &sst) const {
+    return flnd * landair + (1.0 - flnd) * bsi * sst;
+  }
+
+  //! Global surface temperature, from the land air and sea surface
+  //! temperatures
+  T surfaceTemperature(const T &landair, const T &sst) const {
+    return flnd * landair + (1.0 - flnd) * sst;
+  }
+
+  // Hard-coded DOECLIM parameters
+  const double dt = 1;    // years per timestep (this is implicit in Hector)
+  const double ak = 0.31; // slope in climate feedback - land-sea heat exchange
+                          // linear relationship (W/m2/K)
+  const double bk = 1.59; // offset in climate feedback - land-sea heat exchange
+                          // linear relationship,(W/m2/K)
+  const double csw = 0.13; // specific heat capacity of seawater (Wyr/(m3K))
+  const double earth_area = 5100656E8; // (m2)
+  const double secs_per_Year =
+      60.0 * 60.0 * 24.0 *
+      365.2422; //  secs. * min. * hrs. * tropical calendar days (seconds)
+  const double rlam = 1.43;   // factor between land clim. sens. and sea surface
+                              // clim. sens. T_L2x = rlam*T_S2x (unitless)
+  const double zbot = 4000.0; // bottom depth of the interior ocean (m)
+  const double bsi = 1.3; // warming factor for marine surface air over SST due
+                          // to retreating sea ice, (unitless)
+  const double cal =
+      0.52; // effective heat capacity of land-troposphere system (W*yr/m2/K)
+  const double cas = 7.80; // effective heat capacity of mixed layer-troposphere
+                           // system (W*yr/m2/K)
+  const double flnd = 0.29; // fractional land area (unitless)
+  const double fso = 0.95;  // ocean fractional area below 60m (unitless)
+
+  // DOECLIM parameters calculated from constants above
+  int ns;            // number of timesteps
+  double kcon;       // conversion from cm2/s to m2/yr
+  double ocean_area; // m2
+  double cnum; // factor from sea-surface climate sensitivity to global mean
+  double cden; // denominator used to figure out the climate senstivity feedback
+               // parameters over land & sea
+  double powtoheat; // convert flux to total ocean heat 1E22 m2*s
+  T cfl;            // land climate feedback parameter, W/m2/K
+  T cfs;            // sea climate feedback parameter, W/m2/K
+  T kls;            // land-sea heat exchange coefficient, W/m2/K
+  T keff;           // ocean heat diffusivity, m2/yr
+  T taubot;         // ocean bottom diffusion time scale, yr
+  T taucfs;         // sea climate feedback time scale, yr
+  T taucfl;         // land climate feedback time scale, yr
+  T taudif;         // interior ocean heat uptake time scale, yr
+  T tauksl;         // sea-land heat exchange time scale, yr
+  T taukls;         // land-sea heat exchange time scale, yr
+
+  // Components of the difference equation system B*T(i+1) = Q(i) + A*T(i)
+  T B[4];
+  T C[4];
+  kernel_ptr Ker; //!< for doubles, shared with other cores; see DOECLIMKernel
+  T A[4];
+  T IB[4];
+
+private:
+  static void invert_1d_2x2_matrix(const T *x, T *y);
+
+  //! The value of a number, dual or not
+  static double valueOf(const double x) { return x; }
+  template <std::size_t N> static double valueOf(const Dual<N> &x) {
+    return x.value();
+  }
+
+  //! The kernel for doubles comes from the cache; others are computed
+  static std::shared_ptr<const std::vector<double>>
+  kernel(const int ns, const double taubot, const double dt) {
+    return DOECLIMKernel::get(ns, taubot, dt);
+  }
+  template <class U>
+  static std::shared_ptr<const std::vector<U>>
+  kernel(const int ns, const U &taubot, const double dt) {
+    return std::make_shared<const std::vector<U>>(
+        DOECLIMKernel::compute(ns, taubot, dt));
+  }
+};
+
+//------------------------------------------------------------------------------
+/*! \brief              Calculates inverse of x and stores in y
+ *  \param[in] x        Assume x is setup like x = [a,b,c,d] -> x = |a, b|
+ *                                                |c, d|
+ *  \param[out] y        Inverted 1-d matrix
+ */
+template <class T>
+void DOECLIM<T>::invert_1d_2x2_matrix(const T *x, T *y) {
+  T temp_d = (x[0] * x[3] - x[1] * x[2]);
+
+  if (valueOf(temp_d) == 0) {
+    H_THROW("Temperature: Matrix inversion divide by zero.");
+  }
+  T temp = 1 / temp_d;
+  y[0] = temp * x[3];
+  y[1] = temp * -1 * x[1];
+  y[2] = temp * -1 * x[2];
+  y[3] = temp * x[0];
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Derive the coefficients of the difference equations.
+ *  \param ns   Number of timesteps in the run.
+ *  \param S    Climate sensitivity for 2xCO2, degC.
+ *  \param diff Ocean heat diffusivity, cm2/s.
+ *  \param qco2 Radiative forcing for 2xCO2, W/m2.
+ */
+template <class T>
+void DOECLIM<T>::prepare(const int ns, const T &S, const T &diff,
+                         const T &qco2) {
+  using std::pow;
+
+  this->ns = ns;
+  for (int i = 0; i < 3; i++) {
+    B[i] = 0.0;
+    C[i] = 0.0;
+  }
+
+  // DOECLIM model parameters, based on constants set in the header
+  //
+  // Constants & conversion factors
+  kcon = secs_per_Year / 10000; // conversion factor from cm2/s to m2/yr;
+  ocean_area = (1.0 - flnd) * earth_area; // m2
+
+  // Calculate climate feedback parameterisation
+  cnum = rlam * flnd +
+         bsi * (1.0 - flnd); // denominator used to calculate climate senstivity
+                             // feedback parameters over land & sea
+  cden = rlam * flnd -
+         ak * (rlam - bsi); // another denominator use to calculate climate
+                            // senstivity feedback parameters over land & sea
+  cfl = flnd * cnum / cden * qco2 / S -
+        bk * (rlam - bsi) / cden; // calculate the land climate feedback
+                                  // parameter (W/(m2K)) eq A.19 Kriegler 2005
+  cfs = (rlam * flnd - ak / (1.0 - flnd) * (rlam - bsi)) * cnum / cden * qco2 /
+            S +
+        rlam * flnd / (1.0 - flnd) * bk * (rlam - bsi) /
+            cden; // calculate the sea climate feedback parameter (W/(m2K)) eq
+                  // A.20 Kriegler 2005
+  kls = bk * rlam * flnd / cden -
+        ak * flnd * cnum / cden * qco2 /
+            S; // land-sea heat exchange coefficient
+               // (W/(m2K)) eq A.21 Kriegler 2005
+
+  // Calculate ocean heat flux parameters & conversion factors
+  keff = kcon * diff; // covert units of ocean heat diffusivity (m2/yr)
+  powtoheat =
+      ocean_area * secs_per_Year /
+      pow(10.0,
+          22); // conversion factor to convert total ocean heat flux to (m2*s)
+
+  // Get the six different times scales used in the numerical aproximation of
+  // the heat flux into the interior ocean See eq A.22 Kriegler 2005 for more
+  // details.
+  taubot = pow(zbot, 2) /
+           keff; // number of years for the ocean to equilibrates, bottom water
+                 // has warmed as much as the surface (yr)
+  taucfs = cas / cfs; // sea climate feedback time scale (yr)
+  taucfl = cal / cfl; // land climate feedback time scale (yr)
+  taudif = pow(cas, 2) / pow(csw, 2) * M_PI /
+           keff; // interior ocean heat uptake time scale (yr)
+  tauksl = (1.0 - flnd) * cas / kls; // sea-land heat exchange time scale (yr)
+  taukls = flnd * cal / kls;         // land-sea heat exchange time scale (yr)
+
+  // The kernel of the analytical solution to the integral found in the
+  // temperature difference equation depends only on ns, taubot, and dt
+  Ker = kernel(ns, taubot, dt);
+
+  // Correction terms, remove oscillation artefacts due to short-term forcings
+  // (Equation 2.3.27, TK07)
+  C[0] = 1.0 / pow(taucfl, 2.0) + 1.0 / pow(taukls, 2.0) +
+         2.0 / taucfl / taukls + bsi / taukls / tauksl;
+  C[1] = -1 * bsi / pow(taukls, 2.0) - bsi / taucfl / taukls -
+         bsi / taucfs / taukls - pow(bsi, 2.0) / taukls / tauksl;
+  C[2] = -1 * bsi / pow(tauksl, 2.0) - 1.0 / taucfs / tauksl -
+         1.0 / taucfl / tauksl - 1.0 / taukls / tauksl;
+  C[3] = 1.0 / pow(taucfs, 2.0) + pow(bsi, 2.0) / pow(tauksl, 2.0) +
+         2.0 * bsi / taucfs / tauksl + bsi / taukls / tauksl;
+
+  for (int i = 0; i < 4; i++) {
+    C[i] = C[i] * (pow(dt, 2.0) / 12.0);
+  }
+
+  //------------------------------------------------------------------
+  // Matrices of difference equation system, see A.27 Kriegler 2005.
+  // B*T(i+1) = Q(i) + A*T(i)
+  // T = (TL,TS)
+  // successor temperatures (TL;i+1; TS;i+1)
+  B[0] = 1.0 + dt / (2.0 * taucfl) + dt / (2.0 * taukls);
+  B[1] = -dt / (2.0 * taukls) * bsi;
+  B[2] = -dt / (2.0 * tauksl);
+  B[3] = 1.0 + dt / (2.0 * taucfs) + dt / (2.0 * tauksl) * bsi +
+         2.0 * fso * pow((dt / taudif), 0.5);
+
+  // predecessors temperatures
+  A[0] = 1.0 - dt / (2.0 * taucfl) - dt / (2.0 * taukls);
+  A[1] = dt / (2.0 * taukls) * bsi;
+  A[2] = dt / (2.0 * tauksl);
+  A[3] = 1.0 - dt / (2.0 * taucfs) - dt / (2.0 * tauksl) * bsi +
+         (*Ker)[ns - 1] * fso * pow((dt / taudif), 0.5);
+
+  // The algorithm to integrate Model
+  for (int i = 0; i < 4; i++) {
+    B[i] = B[i] + C[i];
+    A[i] = A[i] + C[i];
+  }
+  // Calculate the inverse of B
+  invert_1d_2x2_matrix(B, IB);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief The inputs to the land (DQ1) and ocean (DQ2) boxes over a time
+ *         step, from the forcing (W/m2) at its end (Q) and start (Qprev).
+ *  \details Land and ocean forcings are taken as equal to the global one.
+ */
+template <class T>
+void DOECLIM<T>::inputs(const double Q, const double Qprev, T &DQ1,
+                        T &DQ2) const {
+  using std::pow;
+
+  const double DelQ = Q - Qprev;
+
+  // Assume linear forcing change between tstep and tstep+1
+  T QC1 =
+      (DelQ / cal * (1.0 / taucfl + 1.0 / taukls) - bsi * DelQ / cas / taukls);
+  T QC2 = (DelQ / cas * (1.0 / taucfs + bsi / tauksl) - DelQ / cal / tauksl);
+  QC1 = QC1 * pow(dt, 2.0) / 12.0;
+  QC2 = QC2 * pow(dt, 2.0) / 12.0;
+
+  // Factor 1/2 in front of Q in Equation A.27, EK05, and Equation 2.3.27,
+  // TK07 is a typo! Assumption: linear forcing change between n and n+1
+  DQ1 = 0.5 * dt / cal * (Q + Qprev) + QC1;
+  DQ2 = 0.5 * dt / cas * (Q + Qprev) + QC2;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Solve for the land air and sea surface temperatures at tstep > 0,
+ *         given the inputs to the boxes and the temperatures before it.
+ */
+template <class T>
+void DOECLIM<T>::solve(const int tstep, const T &DQ1, const T &DQ2,
+                       std::vector<T> &temp_landair,
+                       std::vector<T> &temp_sst) const {
+  using std::pow;
+
+  T DPAST2 = 0.0;
+  for (int i = 0; i < tstep; i++) {
+    DPAST2 = DPAST2 + temp_sst[i] * (*Ker)[ns - tstep + i - 1];
+  }
+  DPAST2 = DPAST2 * fso * pow((dt / taudif), 0.5);
+
+  const T DTEAUX1 =
+      A[0] * temp_landair[tstep - 1] + A[1] * temp_sst[tstep - 1];
+  const T DTEAUX2 =
+      A[2] * temp_landair[tstep - 1] + A[3] * temp_sst[tstep - 1];
+
+  temp_landair[tstep] =
+      IB[0] * (DQ1 + DTEAUX1) + IB[1] * (DQ2 + DPAST2 + DTEAUX2);
+  temp_sst[tstep] =
+      IB[2] * (DQ1 + DTEAUX1) + IB[3] * (DQ2 + DPAST2 + DTEAUX2);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Ocean heat uptake at tstep > 0, from the sea surface temperatures
+ *         through it.
+ *  \details heatflux[tstep] is the heat flux (W/m2) between tstep-1 and
+ *           tstep: a numerical implementation of Equation 2.7, EK05, or
+ *           Equation 2.3.13, TK07.
+ */
+template <class T>
+void DOECLIM<T>::heatFlux(const int tstep, const std::vector<T> &temp_sst,
+                          std::vector<T> &heatflux_mixed,
+                          std::vector<T> &heatflux_interior,
+                          std::vector<T> &heat_mixed,
+                          std::vector<T> &heat_interior) const {
+  using std::pow;
+
+  heatflux_mixed[tstep] = cas * (temp_sst[tstep] - temp_sst[tstep - 1]);
+  T interior = 0.0;
+  for (int i = 0; i < tstep; i++) {
+    interior = interior + temp_sst[i] * (*Ker)[ns - tstep + i];
+  }
+  heatflux_interior[tstep] =
+      cas * fso / pow((taudif * dt), 0.5) * (2.0 * temp_sst[tstep] - interior);
+  heat_mixed[tstep] =
+      heat_mixed[tstep - 1] + heatflux_mixed[tstep] * (powtoheat * dt);
+  heat_interior[tstep] = heat_interior[tstep - 1] +
+                         heatflux_interior[tstep] * (fso * powtoheat * dt);
+}
+
+} // namespace Hector
+
+#endif // DOECLIM_HPP
@@ -0,0 +1,152 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef DOECLIM_KERNEL_HPP
+#define DOECLIM_KERNEL_HPP
+/*
+ *  doeclim_kernel.hpp
+ *  hector
+ *
+ *  The DOECLIM ocean diffusion kernel, shared between cores.
+ *
+ */
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// The MinGW C++ compiler doesn't seem to pull in the cmath constants? (see
+// #384) As a workaround, we define M_PI here if needed
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief The kernel of DOECLIM's interior ocean heat uptake integral.
+ *
+ *  The kernel (Kriegler 2005, eq. A.25) takes several exp, erf, and pow calls
+ *  per year of the run, and depends only on the number of time steps, the
+ *  time step, and the ocean bottom diffusion time scale.  Kernels are kept in
+ *  a process-wide cache, so that cores with the same run length and ocean
+ *  diffusivity (e.g. members of an ensemble that vary other parameters) share
+ *  a single, immutable copy, computed once.  A kernel is freed when the last
+ *  core using it lets go of it.
+ */
+class DOECLIMKernel {
+public:
+  typedef std::shared_ptr<const std::vector<double>> kernel_ptr;
+
+  static kernel_ptr get(const int ns, const double taubot, const double dt);
+
+  template <class T>
+  static std::vector<T> compute(const int ns, const T &taubot,
+                                const double dt);
+};
+
+//------------------------------------------------------------------------------
+/*! \brief Compute the kernel: the analytical solution of the integral in the
+ *         temperature difference equation, with bottom correction terms.
+ *  \details Third order bottom correction terms will be "more than
+ *           sufficient" for simulations out to 2500 (Equation A.25, EK05, or
+ *           2.3.23, TK07).
+ *
+ *           Templated on the number type, so that it can be computed with
+ *           derivatives (see Dual); get() gives the shared double kernels.
+ */
+template <class T>
+std::vector<T> DOECLIMKernel::compute(const int ns, const T &taubot,
+                                      const double dt) {
+  using std::erf;
+  using std::exp;
+  using std::pow;
+
+  std::vector<T> KT0(ns, 0.0);
+  std::vector<T> KTA1(ns, 0.0);
+  std::vector<T> KTB1(ns, 0.0);
+  std::vector<T> KTA2(ns, 0.0);
+  std::vector<T> KTB2(ns, 0.0);
+  std::vector<T> KTA3(ns, 0.0);
+  std::vector<T> KTB3(ns, 0.0);
+
+  // First order
+  KT0[ns - 1] = 4.0 - 2.0 * pow(2.0, 0.5);
+  KTA1[ns - 1] =
+      -8.0 * exp(-taubot / dt) + 4.0 * pow(2.0, 0.5) * exp(-0.5 * taubot / dt);
+  KTB1[ns - 1] = 4.0 * pow((M_PI * taubot / dt), 0.5) *
+                 (1.0 + erf(pow(0.5 * taubot / dt, 0.5)) -
+                  2.0 * erf(pow(taubot / dt, 0.5)));
+
+  // Second order
+  KTA2[ns - 1] = 8.0 * exp(-4.0 * taubot / dt) -
+                 4.0 * pow(2.0, 0.5) * exp(-2.0 * taubot / dt);
+  KTB2[ns - 1] = -8.0 * pow((M_PI * taubot / dt), 0.5) *
+                 (1.0 + erf(pow((2.0 * taubot / dt), 0.5)) -
+                  2.0 * erf(2.0 * pow((taubot / dt), 0.5)));
+
+  // Third order
+  KTA3[ns - 1] = -8.0 * exp(-9.0 * taubot / dt) +
+                 4.0 * pow(2.0, 0.5) * exp(-4.5 * taubot / dt);
+  KTB3[ns - 1] = 12.0 * pow((M_PI * taubot / dt), 0.5) *
+                 (1.0 + erf(pow((4.5 * taubot / dt), 0.5)) -
+                  2.0 * erf(3.0 * pow((taubot / dt), 0.5)));
+
+  // Calculate the kernel component vectors
+  for (int i = 0; i < (ns - 1); i++) {
+
+    // First order
+    KT0[i] = 4.0 * pow(double(ns - i), 0.5) -
+             2.0 * pow(double(ns + 1 - i), 0.5) -
+             2.0 * pow(double(ns - 1 - i), 0.5);
+    KTA1[i] =
+        -8.0 * pow(double(ns - i), 0.5) * exp(-taubot / dt / double(ns - i)) +
+        4.0 * pow(double(ns + 1 - i), 0.5) *
+            exp(-taubot / dt / double(ns + 1 - i)) +
+        4.0 * pow(double(ns - 1 - i), 0.5) *
+            exp(-taubot / dt / double(ns - 1 - i));
+    KTB1[i] = 4.0 * pow((M_PI * taubot / dt), 0.5) *
+              (erf(pow((taubot / dt / double(ns - 1 - i)), 0.5)) +
+               erf(pow((taubot / dt / double(ns + 1 - i)), 0.5)) -
+               2.0 * erf(pow((taubot / dt / double(ns - i)), 0.5)));
+
+    // Second order
+    KTA2[i] = 8.0 * pow(double(ns - i), 0.5) *
+                  exp(-4.0 * taubot / dt / double(ns - i)) -
+              4.0 * pow(double(ns + 1 - i), 0.5) *
+                  exp(-4.0 * taubot / dt / double(ns + 1 - i)) -
+              4.0 * pow(double(ns - 1 - i), 0.5) *
+                  exp(-4.0 * taubot / dt / double(ns - 1 - i));
+    KTB2[i] = -8.0 * pow((M_PI * taubot / dt), 0.5) *
+              (erf(2.0 * pow((taubot / dt / double(ns - 1 - i)), 0.5)) +
+               erf(2.0 * pow((taubot / dt / double(ns + 1 - i)), 0.5)) -
+               2.0 * erf(2.0 * pow((taubot / dt / double(ns - i)), 0.5)));
+
+    // Third order
+    KTA3[i] = -8.0 * pow(double(ns - i), 0.5) *
+                  exp(-9.0 * taubot / dt / double(ns - i)) +
+              4.0 * pow(double(ns + 1 - i), 0.5) *
+                  exp(-9.0 * taubot / dt / double(ns + 1 - i)) +
+              4.0 * pow(double(ns - 1 - i), 0.5) *
+                  exp(-9.0 * taubot / dt / double(ns - 1 - i));
+    KTB3[i] = 12.0 * pow((M_PI * taubot / dt), 0.5) *
+              (erf(3.0 * pow((taubot / dt / double(ns - 1 - i)), 0.5)) +
+               erf(3.0 * pow((taubot / dt / double(ns + 1 - i)), 0.5)) -
+               2.0 * erf(3.0 * pow((taubot / dt / double(ns - i)), 0.5)));
+  }
+
+  // Sum up the kernel components
+  std::vector<T> Ker(ns);
+  for (int i = 0; i < ns; i++) {
+
+    Ker[i] = KT0[i] + KTA1[i] + KTB1[i] + KTA2[i] + KTB2[i] + KTA3[i] + KTB3[i];
+  }
+  return Ker;
+}
+
+} // namespace Hector
+
+#endif // DOECLIM_KERNEL_HPP
@@ -0,0 +1,160 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef DUAL_HPP
+#define DUAL_HPP
+/*
+ *  dual.hpp
+ *  hector
+ *
+ *  Dual numbers, for forward-mode automatic differentiation.
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief A value together with its derivatives with respect to N inputs.
+ *
+ *  Arithmetic on dual numbers carries the derivatives along by the chain
+ *  rule, so code written for a generic number type computes a result and its
+ *  gradient in one pass.  Only the operations the model's numeric code needs
+ *  are defined.  Functions are found by argument-dependent lookup, so code
+ *  templated on the number type should call them unqualified, after
+ *  `using std::exp;` etc., so that they resolve for double too.
+ */
+template <std::size_t N> class Dual {
+public:
+  //! A constant: all derivatives zero.
+  Dual(const double v = 0.0) : val(v) { deriv.fill(0.0); }
+
+  //! Input i: its derivative with respect to itself is one.
+  Dual(const double v, const std::size_t i) : val(v) {
+    deriv.fill(0.0);
+    deriv[i] = 1.0;
+  }
+
+  double value() const { return val; }
+  double derivative(const std::size_t i) const { return deriv[i]; }
+
+  Dual &operator+=(const Dual &x) {
+    val += x.val;
+    for (std::size_t i = 0; i < N; ++i) {
+      deriv[i] += x.deriv[i];
+    }
+    return *this;
+  }
+  Dual &operator-=(const Dual &x) {
+    val -= x.val;
+    for (std::size_t i = 0; i < N; ++i) {
+      deriv[i] -= x.deriv[i];
+    }
+    return *this;
+  }
+  Dual &operator*=(const Dual &x) {
+    for (std::size_t i = 0; i < N; ++i) {
+      deriv[i] = deriv[i] * x.val + val * x.deriv[i];
+    }
+    val *= x.val;
+    return *this;
+  }
+  Dual &operator/=(const Dual &x) {
+    const double q = val / x.val;
+    for (std::size_t i = 0; i < N; ++i) {
+      deriv[i] = (deriv[i] - q * x.deriv[i]) / x.val;
+    }
+    val = q;
+    return *this;
+  }
+
+  Dual operator-() const {
+    Dual r(*this);
+    r.val = -val;
+    for (std::size_t i = 0; i < N; ++i) {
+      r.deriv[i] = -deriv[i];
+    }
+    return r;
+  }
+
+  //! f(x), given f(x) and f'(x).
+  Dual apply(const double f, const double fprime) const {
+    Dual r(f);
+    for (std::size_t i = 0; i < N; ++i) {
+      r.deriv[i] = fprime * deriv[i];
+    }
+    return r;
+  }
+
+private:
+  double val;
+  std::array<double, N> deriv;
+};
+
+template <std::size_t N> Dual<N> operator+(Dual<N> x, const Dual<N> &y) {
+  return x += y;
+}
+template <std::size_t N> Dual<N> operator+(Dual<N> x, const double y) {
+  return x += y;
+}
+template <std::size_t N> Dual<N> operator+(const double x, Dual<N> y) {
+  return y += x;
+}
+template <std::size_t N> Dual<N> operator-(Dual<N> x, const Dual<N> &y) {
+  return x -= y;
+}
+template <std::size_t N> Dual<N> operator-(Dual<N> x, const double y) {
+  return x -= y;
+}
+template <std::size_t N> Dual<N> operator-(const double x, const Dual<N> &y) {
+  return Dual<N>(x) -= y;
+}
+template <std::size_t N> Dual<N> operator*(Dual<N> x, const Dual<N> &y) {
+  return x *= y;
+}
+template <std::size_t N> Dual<N> operator*(Dual<N> x, const double y) {
+  return x *= y;
+}
+template <std::size_t N> Dual<N> operator*(const double x, Dual<N> y) {
+  return y *= x;
+}
+template <std::size_t N> Dual<N> operator/(Dual<N> x, const Dual<N> &y) {
+  return x /= y;
+}
+template <std::size_t N> Dual<N> operator/(Dual<N> x, const double y) {
+  return x /= y;
+}
+template <std::size_t N> Dual<N> operator/(const double x, const Dual<N> &y) {
+  return Dual<N>(x) /= y;
+}
+
+template <std::size_t N> Dual<N> exp(const Dual<N> &x) {
+  const double e = std::exp(x.value());
+  return x.apply(e, e);
+}
+template <std::size_t N> Dual<N> log(const Dual<N> &x) {
+  return x.apply(std::log(x.value()), 1.0 / x.value());
+}
+template <std::size_t N> Dual<N> sqrt(const Dual<N> &x) {
+  const double s = std::sqrt(x.value());
+  return x.apply(s, 0.5 / s);
+}
+template <std::size_t N> Dual<N> pow(const Dual<N> &x, const double p) {
+  return x.apply(std::pow(x.value(), p),
+                 p * std::pow(x.value(), p - 1.0));
+}
+template <std::size_t N> Dual<N> erf(const Dual<N> &x) {
+  const double two_over_sqrt_pi = 1.12837916709551257390;
+  return x.apply(std::erf(x.value()),
+                 two_over_sqrt_pi * std::exp(-x.value() * x.value()));
+}
+
+} // namespace Hector
+
+#endif // DUAL_HPP
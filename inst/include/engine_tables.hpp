@@ -0,0 +1,38 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef ENGINE_TABLES_HPP
+#define ENGINE_TABLES_HPP
+/*
+ *  engine_tables.hpp
+ *  hector
+ *
+ *  Yearly tables of component inputs, shared by the engines.
+ *
+ */
+
+#include <vector>
+
+#include "tseries.hpp"
+#include "unitval.hpp"
+
+namespace Hector {
+
+// Tables of inputs by year, for the engines; see engine_tables.cpp
+void tabulate(const tseries<unitval> &ts, const unit_types units,
+              const double firstDate, const double lastDate,
+              std::vector<double> &values);
+
+void tabulateConstraint(const tseries<unitval> &ts, const unit_types units,
+                        const double firstDate, const double lastDate,
+                        std::vector<double> &values);
+
+double tableInput(const std::vector<double> &values, const std::size_t y,
+                  const tseries<unitval> &ts, const double date);
+
+} // namespace Hector
+
+#endif // ENGINE_TABLES_HPP
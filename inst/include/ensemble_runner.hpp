@@ -0,0 +1,79 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef ENSEMBLE_RUNNER_HPP
+#define ENSEMBLE_RUNNER_HPP
+/*
+ *  ensemble_runner.hpp
+ *  hector
+ *
+ *  Run a parameter ensemble on worker threads.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "core.hpp"
+#include "scenario.hpp"
+#include "unitval.hpp"
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief Run many parameter sets on worker threads.
+ *
+ *  Workers repeatedly claim the next unrun ensemble member, set up a fresh
+ *  core from a Scenario with the member's parameters, run it to the end date,
+ *  and copy the requested outputs into a shared results array.  Because a
+ *  core is only ever touched by the worker that created it, the cores need no
+ *  locking, and a member's results are the same whichever worker ran it.
+ *
+ *  Results are laid out as a dates x variables x members array in
+ *  column-major order, which is the layout of an array in R.
+ */
+class EnsembleRunner {
+public:
+  EnsembleRunner(const std::vector<std::string> &paramNames,
+                 const std::vector<unit_types> &paramUnits,
+                 const std::vector<std::string> &vars,
+                 const std::vector<double> &dates);
+
+  void run(const Scenario &scenario, const std::size_t nthreads,
+           const double *paramValues, const std::size_t nmember,
+           double *results);
+
+  //! Units of each output value of a member, laid out like its values
+  //! (valid after a successful run)
+  const std::vector<std::string> &getUnits() const { return units; }
+
+  //! Error messages, one per member; empty for members that ran successfully
+  const std::vector<std::string> &getErrors() const { return errors; }
+
+  //! Number of values written per member
+  size_t memberSize() const { return vars.size() * dates.size(); }
+
+private:
+  void runMember(const Scenario &scenario, const double *paramValues,
+                 const std::size_t nmember, const std::size_t member,
+                 double *results, std::vector<std::string> &memberUnits);
+
+  //! Parameter capabilities, one per column of the parameter matrix
+  std::vector<std::string> paramNames;
+  //! Units for each parameter
+  std::vector<unit_types> paramUnits;
+  //! Output variables to retrieve from each member
+  std::vector<std::string> vars;
+  //! Dates to retrieve for each output variable
+  std::vector<double> dates;
+
+  std::vector<std::string> units;
+  std::vector<std::string> errors;
+};
+
+} // namespace Hector
+
+#endif // ENSEMBLE_RUNNER_HPP
@@ -97,18 +97,18 @@ inline fluxpool::fluxpool(unitval v, unordered_map<string, double> pool_map,
   ctmap = pool_map;
   name = pool_name;
 
-  if (v < 0) {
-    H_ASSERT(v >= 0, "Flux and pool values may not be negative in " + name);
-  }
+  H_CHECK(v >= 0, "Flux and pool values may not be negative in " + name);
 
+#if HECTOR_CHECKED
   // check pool_map data
   double frac = 0.0;
   for (auto src : ctmap) {
-    H_ASSERT(src.second >= 0 && src.second <= 1,
-             "fractions must be 0-1 for " + pool_name);
+    H_CHECK(src.second >= 0 && src.second <= 1,
+            "fractions must be 0-1 for " + pool_name);
     frac += src.second;
   }
-  H_ASSERT(frac - 1.0 < 1e-6, "pool_map must sum to ~1.0 for " + pool_name)
+  H_CHECK(frac - 1.0 < 1e-6, "pool_map must sum to ~1.0 for " + pool_name);
+#endif
 }
 
 //-----------------------------------------------------------------------
@@ -118,9 +118,7 @@ inline fluxpool::fluxpool(unitval v, unordered_map<string, double> pool_map,
 inline void fluxpool::set(double v, unit_types u, bool track = false,
                           string pool_name = "?") {
   name = pool_name;
-  if (v < 0) {
-    H_ASSERT(v >= 0, "Flux and pool values may not be negative in " + name);
-  }
+  H_CHECK(v >= 0, "Flux and pool values may not be negative in " + name);
   tracking = track;
   ctmap[name] = 1.0;
   unitval::set(v, u, 0.0);
@@ -195,8 +193,8 @@ inline void fluxpool::adjust_pool_to_val(const double solvedSize,
 /*! \brief Operator overload: addition
  */
 inline fluxpool operator+(const fluxpool &lhs, const fluxpool &rhs) {
-  H_ASSERT(lhs.units() == rhs.units(),
-           "units mismatch: " + lhs.name + " and " + rhs.name);
+  H_CHECK(lhs.units() == rhs.units(),
+          "units mismatch: " + lhs.name + " and " + rhs.name);
   H_ASSERT(lhs.tracking == rhs.tracking,
            "tracking mismatch: " + lhs.name + " and " + rhs.name)
 
@@ -261,7 +259,7 @@ inline fluxpool operator+(const fluxpool &lhs, const fluxpool &rhs) {
         You can add a unitval to a fluxpool, resulting in a fluxpool
  */
 inline fluxpool operator+(const fluxpool &lhs, const unitval &rhs) {
-  H_ASSERT(lhs.valUnits == rhs.units(), "units mismatch: " + lhs.name);
+  H_CHECK(lhs.valUnits == rhs.units(), "units mismatch: " + lhs.name);
   H_ASSERT(!lhs.tracking, "Can't add a unitval to a tracking fluxpool");
   return fluxpool(lhs.val + rhs.value(rhs.units()), lhs.valUnits, false,
                   lhs.name);
@@ -271,7 +269,7 @@ inline fluxpool operator+(const fluxpool &lhs, const unitval &rhs) {
 /*! \brief Operator overload: subtraction
  */
 inline fluxpool operator-(const fluxpool &lhs, const fluxpool &rhs) {
-  H_ASSERT(lhs.valUnits == rhs.units(), "units mismatch: " + rhs.name);
+  H_CHECK(lhs.valUnits == rhs.units(), "units mismatch: " + rhs.name);
   H_ASSERT(lhs.tracking == rhs.tracking,
            "tracking mismatch: " + lhs.name + " and " + rhs.name)
   fluxpool diff(unitval(lhs.val - rhs.val, lhs.valUnits), lhs.ctmap,
@@ -284,7 +282,7 @@ inline fluxpool operator-(const fluxpool &lhs, const fluxpool &rhs) {
         You can subtract a unitval from a fluxpool, resulting in a fluxpool
  */
 inline fluxpool operator-(const fluxpool &lhs, const unitval &rhs) {
-  H_ASSERT(lhs.valUnits == rhs.units(), "units mismatch: " + lhs.name);
+  H_CHECK(lhs.valUnits == rhs.units(), "units mismatch: " + lhs.name);
   unitval diff(lhs.val - rhs.value(lhs.valUnits), lhs.units());
   return fluxpool(diff, lhs.ctmap, lhs.tracking, lhs.name);
 }
@@ -312,8 +310,8 @@ inline fluxpool operator/(const fluxpool &lhs, const double rhs) {
 /*! \brief Operator overload: division
  */
 inline double operator/(const fluxpool &lhs, const fluxpool &rhs) {
-  H_ASSERT(lhs.valUnits == rhs.units(),
-           "units mismatch: " + lhs.name + " and " + rhs.name);
+  H_CHECK(lhs.valUnits == rhs.units(),
+          "units mismatch: " + lhs.name + " and " + rhs.name);
   H_ASSERT(lhs.tracking == rhs.tracking,
            "tracking mismatch: " + lhs.name + " and " + rhs.name)
   return lhs.val / rhs.val;
@@ -323,13 +321,13 @@ inline double operator/(const fluxpool &lhs, const fluxpool &rhs) {
 /*! \brief Equality and inequality: same total only
  */
 inline bool operator==(const fluxpool &lhs, const fluxpool &rhs) {
-  H_ASSERT(lhs.valUnits == rhs.units(),
-           "units mismatch: " + lhs.name + " and " + rhs.name);
+  H_CHECK(lhs.valUnits == rhs.units(),
+          "units mismatch: " + lhs.name + " and " + rhs.name);
   return lhs.val == rhs.val;
 }
 inline bool operator!=(const fluxpool &lhs, const fluxpool &rhs) {
-  H_ASSERT(lhs.valUnits == rhs.units(),
-           "units mismatch: " + lhs.name + " and " + rhs.name);
+  H_CHECK(lhs.valUnits == rhs.units(),
+          "units mismatch: " + lhs.name + " and " + rhs.name);
   return lhs.val != rhs.val;
 }
 
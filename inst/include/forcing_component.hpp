@@ -18,6 +18,8 @@
 #include "tseries.hpp"
 #include "tvector.hpp"
 
+#include <vector>
+
 namespace Hector {
 
 // Need to forward declare the components which depend on each other
@@ -30,6 +32,7 @@ class HalocarbonComponent;
  */
 class ForcingComponent : public IModelComponent {
   friend class CSVOutputStreamVisitor;
+  friend class ShortLivedForcerEngine;
 
 public:
   ForcingComponent();
@@ -57,6 +60,10 @@ public:
   //! IVisitable methods
   virtual void accept(AVisitor *visitor);
 
+  virtual void getDataSeries(const std::string &varName,
+                             const std::vector<double> &dates,
+                             std::vector<unitval> &values);
+
   //! A list (map) of all computed forcings, with associated iterator
   typedef std::map<std::string, unitval> forcings_t;
   typedef std::map<std::string, unitval>::iterator forcingsIterator;
@@ -64,10 +71,56 @@ public:
 private:
   virtual unitval getData(const std::string &varName, const double valueIndex);
 
-  //! Base year forcings
-  forcings_t baseyear_forcings;
-  //! Forcings by year
-  tvector<forcings_t> forcings_ts;
+  void cachePreindustrial();
+
+  bool findForcing(const std::string &varName, std::size_t &index) const;
+
+  forcings_t getForcings(const double date) const;
+
+  double ariForcing(const unitval &rho, const double E) const;
+
+  double aciForcing(const double E_SO2, const double E_BC,
+                    const double E_OC) const;
+
+  double volcanicForcing(const double SV) const;
+
+  //! Forcing agents computed here (halocarbons compute their own forcings)
+  enum Agent {
+    RF_CO2,
+    RF_N2O,
+    RF_CH4,
+    RF_H2O_STRAT,
+    RF_O3_TROP,
+    RF_BC,
+    RF_OC,
+    RF_SO2,
+    RF_NH3,
+    RF_ACI,
+    RF_ALBEDO,
+    RF_VOL,
+    RF_MISC,
+    N_AGENTS
+  };
+
+  //! Names of the forcings computed each year (including the total), in
+  //! alphabetical order; set by prepareToRun()
+  std::vector<std::string> forcing_names;
+  //! Position of each forcing in forcing_names
+  std::map<std::string, std::size_t> forcing_index;
+  //! Position of each agent's forcing, or -1 if it isn't computed
+  int agent_index[N_AGENTS];
+  //! Positions of the halocarbon forcings, in the order they're fetched
+  std::vector<std::size_t> halo_index;
+  //! Position of the total forcing
+  std::size_t total_index;
+
+  //! Base year forcings, indexed like forcing_names
+  std::vector<double> baseyear_forcings;
+  //! Forcings by year, indexed like forcing_names
+  tvector<std::vector<double>> forcings_ts;
+
+  //! Preindustrial concentrations: CO2 (ppmv), CH4 (ppbv), N2O (ppbv)
+  double preindustrial_co2, preindustrial_ch4, preindustrial_n2o;
 
   double baseyear;    //! Year which forcing calculations will start
   double currentYear; //! Tracks current year
@@ -138,6 +191,7 @@ private:
   static const char
       *halo_forcing_names[]; //! Internal names of halocarbon forcings
   static std::map<std::string, std::string> forcing_name_map;
+  static const char *agent_names[N_AGENTS]; //! Names of the agents' forcings
 };
 
 } // namespace Hector
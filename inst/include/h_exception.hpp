@@ -86,6 +86,28 @@ GET_3RD_ARG(__VA_ARGS__, H_ASSERT2, H_ASSERT1, )
 #define H_ASSERT(...) H_ASSERT_MACRO_CHOOSER(__VA_ARGS__)(__VA_ARGS__)
 */
 
+//-----------------------------------------------------------------------
+/*!
+ * \brief H_CHECK is an H_ASSERT of an internal invariant, for hot paths
+ *
+ * In the default "checked" build it is H_ASSERT.  A "release" build
+ * (-DHECTOR_CHECKED=0, or HECTOR_BUILD=release; see makefile.standalone)
+ * compiles it out, so it must not be used to validate user input: only for
+ * conditions that hold in a correct model (matching units in arithmetic,
+ * non-negative pools, one-year time steps), which the checked build
+ * verifies when the test suite runs.
+ */
+#ifndef HECTOR_CHECKED
+#define HECTOR_CHECKED 1
+#endif
+
+#if HECTOR_CHECKED
+#define H_CHECK(x, s) H_ASSERT(x, s)
+#else
+// The condition is unevaluated, but still compiled, so it can't go stale
+#define H_CHECK(x, s) static_cast<void>(sizeof(!(x)));
+#endif
+
 /*! \brief Macro for easy exceptions.
  *
  *  Creates an h_exception object, fills in message, and throws it.
@@ -16,7 +16,9 @@
  *  Provides utility services
  */
 
+#include <cstdint>
 #include <iostream>
+#include <string>
 
 #define H_STRINGIFY_VAR(var) #var
 
@@ -34,6 +36,10 @@ namespace Hector {
 
 void ensure_dir_exists(const std::string &dir);
 
+void truncate_file(const std::string &path, const std::uintmax_t size);
+
+void append_double(std::string &s, const double x, const int precision = 6);
+
 }
 
 #endif // H_UTIL_H
@@ -19,17 +19,26 @@
 #include "tseries.hpp"
 #include "unitval.hpp"
 
+//! Converts emissions (Gmol) to concentrations (pptv): 0.1 * this
+#define AtmosphereDryAirConstant 1.8
+
 namespace Hector {
 
+class HalocarbonEngine;
+
 //------------------------------------------------------------------------------
 /*! \brief Model component for a halocarbon.
  *
  *  A halocarbon model component that simply decays in the atmosphere.  Adapted
  *  from Bill Emanuel's python implementation.
  *
+ *  If the core's halocarbon engine is enabled, the engine does the yearly
+ *  calculation for all halocarbons at once (see HalocarbonEngine), and this
+ *  component just holds the inputs and outputs.
  */
 class HalocarbonComponent : public IModelComponent {
   friend class CSVOutputStreamVisitor;
+  friend class HalocarbonEngine;
 
 public:
   HalocarbonComponent(std::string g);
@@ -50,6 +59,8 @@ public:
 
   virtual void run(const double runToDate);
 
+  virtual bool runAhead(const double firstDate, const double lastDate);
+
   virtual void reset(double time);
 
   virtual void shutDown();
@@ -60,6 +71,49 @@ public:
 private:
   virtual unitval getData(const std::string &varName, const double valueIndex);
 
+  void storeConcentration(const double date, const unitval &Ha);
+
+  static double decayFactor(const double tau);
+
+  /*! \brief Concentration after one year of decay and emissions.
+   *  \param Ha        Last year's concentration, pptv.
+   *  \param E         This year's emissions, Gg.
+   *  \param molarMass Molar mass, g/mol.
+   *  \param tau       Lifetime, years.
+   *  \param expfac    decayFactor(tau).
+   *  \details Used by run() and, for all species at once, by the halocarbon
+   *           engine; it's inline so that the engine's loop stays tight.
+   */
+  static double step(const double Ha, const double E, const double molarMass,
+                     const double tau, const double expfac) {
+    const double timestep = 1.0;
+
+    // Compute the delta atmospheric concentration from current emissions
+    const double emissMol = E / molarMass * timestep; // this is in U_GMOL
+    const double concDeltaEmiss =
+        emissMol / (0.1 * AtmosphereDryAirConstant); // U_PPTV
+
+    // Update the atmospheric concentration, accounting for this delta and
+    // exponential decay
+    return Ha * expfac + concDeltaEmiss * tau * (1.0 - expfac);
+  }
+
+  /*! \brief Effective radiative forcing, W/m2, of a concentration (pptv).
+   *  \param Ha    Concentration, pptv.
+   *  \param rho   Radiative efficiency, W/m2/pptv.
+   *  \param delta Tropospheric adjustment, unitless.
+   */
+  static double forcing(const double Ha, const double rho, const double delta) {
+    // First calculate the stratospheric-temperature adjusted radiative
+    // efficiencies using parameter values from IPCC AR6 & Equation 16 from
+    // Hartin 2015.
+    const double rf_unadjusted = rho * Ha;
+    // Now calculate the effective radiative forcing value by adjusting the
+    // radiative forcing by the tropospheric adjustments (the delta
+    // parameter).
+    return rf_unadjusted + delta * rf_unadjusted;
+  }
+
   //! Who are we?
   std::string myGasName;
 
@@ -82,6 +136,10 @@ private:
 
   Core *core;
   double oldDate;
+  double aheadDate; //! Last date computed by runAhead()
+
+  //! Engine that runs this component, if any.
+  HalocarbonEngine *engine;
 };
 
 } // namespace Hector
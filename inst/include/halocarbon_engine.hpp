@@ -0,0 +1,98 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef HALOCARBON_ENGINE_HPP
+#define HALOCARBON_ENGINE_HPP
+/*
+ *  halocarbon_engine.hpp
+ *  hector
+ *
+ *  Advance all halocarbon species together.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+namespace Hector {
+
+class Core;
+class HalocarbonComponent;
+
+//------------------------------------------------------------------------------
+/*! \brief Runs every halocarbon species in a single loop per year.
+ *
+ *  Each halocarbon is normally a separate component, with its own run() that
+ *  looks up its emissions, computes exp(-1/tau), and updates its
+ *  concentration and forcing.  The engine instead keeps the parameters and
+ *  concentrations of all species in arrays, precomputes the decay factors,
+ *  and tabulates emissions and concentration constraints by year, so each
+ *  year is one loop over the species.  The results are identical to the
+ *  per-component calculation.
+ *
+ *  The HalocarbonComponents are kept as the engine's front ends: they still
+ *  take the inputs, and the engine stores its results in their time series,
+ *  so every existing capability (concentrations, forcings, parameters) works
+ *  unchanged.  Changing any input of an attached component, resetting it, or
+ *  preparing it to run makes the engine reload its tables before the next
+ *  year.
+ */
+class HalocarbonEngine {
+public:
+  HalocarbonEngine(Core *core, const std::vector<HalocarbonComponent *> &hcs);
+
+  void run(const double runToDate);
+
+  //! Reload parameters, inputs, and state before the next year is run.
+  void invalidate() { stale = true; }
+
+  //! Number of species.
+  std::size_t size() const { return species.size(); }
+
+  //! Forcing capability (e.g. FCFC11) of species i.
+  const std::string &getForcingName(const std::size_t i) const {
+    return forcingNames[i];
+  }
+
+  //! Forcing of species i in the last year run, W/m2.
+  double getForcing(const std::size_t i) const { return forcing[i]; }
+
+private:
+  void load(const double runToDate);
+
+  void extend(const double newLastDate);
+
+  Core *core;
+  std::vector<HalocarbonComponent *> species;
+  std::vector<std::string> forcingNames;
+
+  // Per-species parameters and state, indexed like species
+  std::vector<double> tau;       //!< lifetime, years
+  std::vector<double> expfac;    //!< exp(-1/tau)
+  std::vector<double> molarMass; //!< g/mol
+  std::vector<double> rho;       //!< radiative efficiency, W/m2/pptv
+  std::vector<double> delta;     //!< tropospheric adjustment
+  std::vector<double> conc;      //!< concentration at lastDate, pptv
+  std::vector<double> forcing;   //!< forcing at lastDate, W/m2
+
+  //! Emissions (Gg) and concentration constraints (pptv) by year, starting
+  //! at firstDate, with one row of species per year.  Constraints are NaN
+  //! where a species isn't constrained; emissions are NaN where they aren't
+  //! needed or can't be found.
+  std::vector<double> emissions;
+  std::vector<double> constraints;
+  double firstDate;
+  double lastTableDate;
+
+  //! Last date run.
+  double lastDate;
+
+  bool stale;
+};
+
+} // namespace Hector
+
+#endif // HALOCARBON_ENGINE_HPP
@@ -33,6 +33,7 @@
 
 /* Setup functions */
 #include "ini_to_core_reader.hpp"
+#include "scenario.hpp"
 
 /* Output functions */
 #include "csv_outputstream_visitor.hpp"
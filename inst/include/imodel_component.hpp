@@ -14,6 +14,8 @@
  *
  */
 
+#include <vector>
+
 #include "component_data.hpp"
 #include "component_names.hpp"
 #include "h_exception.hpp"
@@ -63,6 +65,28 @@ public:
                               const std::string &datum,
                               const message_data info = message_data()) = 0;
 
+  //------------------------------------------------------------------------------
+  /*! \brief Get the values of one variable at several dates.
+   *
+   *  The same as sending a M_GETDATA message for each date, which is what the
+   *  implementation below does.  Components whose getData() looks the
+   *  variable up by name can override it to look the name up once for all of
+   *  the dates (see Core::getDataBlock()).
+   *
+   *  \param varName The variable to get.
+   *  \param dates   The dates to get it at (Core::undefinedIndex() for a
+   *                 variable that has no date).
+   *  \param values  (output) The value at each date.
+   */
+  virtual void getDataSeries(const std::string &varName,
+                             const std::vector<double> &dates,
+                             std::vector<unitval> &values) {
+    values.resize(dates.size());
+    for (std::size_t i = 0; i < dates.size(); ++i) {
+      values[i] = getData(varName, dates[i]);
+    }
+  }
+
   //------------------------------------------------------------------------------
   /*! \brief Sets the variable specified by varName with the given data.
    *
@@ -119,6 +143,25 @@ public:
    */
   virtual bool run_spinup(const int step) { return true; }
 
+  //------------------------------------------------------------------------------
+  /*! \brief Compute a range of years up front, if they depend only on inputs.
+   *
+   *  The core calls this at the start of each run, before any component is
+   *  run for firstDate.  A component whose results over the whole range
+   *  depend only on its inputs (e.g. because they're all constrained) can
+   *  compute and store them all at once and return true; its run() is then
+   *  a no-op for those years.  Most components depend on other components'
+   *  results, and simply inherit the implementation below.
+   *
+   *  \param firstDate The first date that will be run.
+   *  \param lastDate  The last date that will be run.
+   *  \return          Whether the component has computed every year in the
+   *                   range.
+   */
+  virtual bool runAhead(const double firstDate, const double lastDate) {
+    return false;
+  }
+
   //------------------------------------------------------------------------------
   /*! \brief Reset the component's state to what it was at some previous time.
    *
@@ -14,11 +14,16 @@
  *
  */
 
+#include <map>
+#include <memory>
+#include <string>
+
 #include "h_exception.hpp"
 
 namespace Hector {
 
 class Core;
+class CSVTableReader;
 
 /*! \brief An adaptor class to send data read from an INI file directly to the
  *         core for routing to the proper model subcomponent.
@@ -38,6 +43,9 @@ public:
 
   void parse(const std::string &filename);
 
+  static std::string findTable(const std::string &csvFileName,
+                               const std::string &iniFilePath);
+
 private:
   //! Weak reference to a Core object that will handle parsed values
   Core *core;
@@ -45,6 +53,10 @@ private:
   //! Path of the INI file
   std::string iniFilePath;
 
+  //! Tables read so far while parsing, by the name given in the INI file;
+  //! most tables have many columns, each named on its own line
+  std::map<std::string, std::unique_ptr<CSVTableReader>> tables;
+
   //! The exception set by value handler should an exception occur.
   //! Note that this would only be valid if valueHandler returned
   //! an error code.
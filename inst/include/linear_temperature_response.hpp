@@ -0,0 +1,97 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef LINEAR_TEMPERATURE_RESPONSE_HPP
+#define LINEAR_TEMPERATURE_RESPONSE_HPP
+/*
+ *  linear_temperature_response.hpp
+ *  hector
+ *
+ *  Temperature trajectories for given forcing, by impulse response.
+ *
+ */
+
+#include <complex>
+#include <vector>
+
+#include "doeclim.hpp"
+
+namespace Hector {
+
+class TemperatureComponent;
+
+//------------------------------------------------------------------------------
+/*! \brief DOECLIM's response to forcing, as a convolution.
+ *
+ *  Without a temperature constraint, TemperatureComponent::run() is linear
+ *  and time invariant in the forcing: each year's temperatures depend on this
+ *  and last year's forcing, last year's temperatures, and past sea surface
+ *  temperatures through a kernel that depends only on how long ago they
+ *  were.  Every trajectory the component computes is therefore the
+ *  convolution of the forcing (in the two combinations that drive the land
+ *  and ocean boxes) with a fixed impulse response.
+ *
+ *  This class takes the impulse responses from a prepared temperature
+ *  component, by stepping its equations once for a unit input to each box,
+ *  and then computes whole trajectories for any forcing pathway by FFT
+ *  convolution, in O(n log n) rather than run()'s O(n^2).  The results match
+ *  run() to round-off.  Once constructed it doesn't refer to the component,
+ *  and compute() may be called from several threads at once.
+ *
+ *  The forcing is taken as given, so this is for evaluating forcing
+ *  scenarios offline: in a full model run, the forcing depends on the
+ *  temperature through the carbon cycle.
+ */
+class LinearTemperatureResponse {
+public:
+  //! Trajectories by year, from the start date; see TemperatureComponent.
+  struct Trajectories {
+    std::vector<double> temp;              //!< global air temperature, degC
+    std::vector<double> temp_surface;      //!< global surface temp., degC
+    std::vector<double> temp_landair;      //!< air temperature over land, degC
+    std::vector<double> temp_sst;          //!< sea surface temperature, degC
+    std::vector<double> heatflux_mixed;    //!< into the mixed layer, W/m2
+    std::vector<double> heatflux_interior; //!< into the interior ocean, W/m2
+    std::vector<double> heat_mixed;        //!< mixed layer heat, 1e22 J
+    std::vector<double> heat_interior;     //!< interior ocean heat, 1e22 J
+  };
+
+  explicit LinearTemperatureResponse(const TemperatureComponent &temperature);
+
+  void compute(const std::vector<double> &forcing, Trajectories &out) const;
+
+  //! Longest forcing series compute() takes: the model's number of years.
+  std::size_t maxYears() const { return ns; }
+
+private:
+  typedef std::complex<double> complex;
+
+  //! The outputs, in the order of Trajectories.
+  enum { N_OUTPUTS = 8 };
+
+  static std::vector<double> Trajectories::*const OUTPUTS[N_OUTPUTS];
+
+  void simulate(const std::vector<double> &u1, const std::vector<double> &u2,
+                Trajectories &out) const;
+
+  void fft(std::vector<complex> &a, const bool inverse) const;
+
+  //! Copied from the temperature component.
+  std::size_t ns;
+  DOECLIM<double> doeclim;
+
+  //! FFT length: a power of two, at least 2 * ns.
+  std::size_t nfft;
+  //! exp(-2 pi i k / nfft), for k < nfft / 2.
+  std::vector<complex> twiddles;
+  //! Transforms of the responses of each output to a unit input to the land
+  //! (0) and ocean (1) boxes.
+  std::vector<complex> response[N_OUTPUTS][2];
+};
+
+} // namespace Hector
+
+#endif // LINEAR_TEMPERATURE_RESPONSE_HPP
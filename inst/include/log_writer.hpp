@@ -0,0 +1,111 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef LOG_WRITER_HPP
+#define LOG_WRITER_HPP
+/*
+ *  log_writer.hpp
+ *  hector
+ *
+ *  Background thread that does the file I/O for all loggers.
+ *
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief Asynchronous writer shared by every file logger in the process.
+ *
+ *  Loggers don't write to their files directly.  Instead each chunk of log
+ *  text (normally one complete record, since records end with std::endl) is
+ *  copied into a slot of a bounded, lock-free queue, and a single writer
+ *  thread drains the queue and does the actual file I/O.  Slots keep their
+ *  string storage when they are recycled, so once the queue has warmed up
+ *  logging a record does not allocate.
+ *
+ *  Records from one thread always reach the file in the order they were
+ *  written.  If the queue is full the logging thread waits for room; records
+ *  are never dropped.
+ *
+ *  The queue is drained before the process forks, and a child process starts
+ *  its own writer thread with an empty queue.
+ */
+class LogWriter {
+public:
+  static LogWriter &instance();
+
+  void write(std::FILE *file, const char *text, std::size_t n);
+
+  void close(std::FILE *file);
+
+  void flush();
+
+private:
+  LogWriter();
+  ~LogWriter();
+
+  // Not copyable
+  LogWriter(const LogWriter &);
+  LogWriter &operator=(const LogWriter &);
+
+  //! One queued record.  `sequence` says whose turn it is to use the slot
+  //! (see enqueue and dequeue).
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    std::FILE *file;
+    bool closeFile;
+    std::string text;
+  };
+
+  void enqueue(std::FILE *file, const char *text, std::size_t n,
+               bool closeFile);
+
+  bool dequeue();
+
+  void wake();
+
+  void run();
+
+  static void beforeFork();
+  static void afterForkParent();
+  static void afterForkChild();
+
+  //! Number of slots; must be a power of two.
+  static const std::size_t capacity = 4096;
+
+  std::vector<Slot> slots;
+
+  //! Next slot position to be claimed by a producer.
+  std::atomic<std::size_t> enqueuePos;
+
+  //! Next slot position to be written (only touched by the writer thread).
+  std::size_t dequeuePos;
+
+  //! Number of records written so far; used by flush().
+  std::atomic<std::size_t> written;
+
+  //! Files written since the writer thread last went idle; they are flushed
+  //! to the OS before it sleeps.
+  std::vector<std::FILE *> dirty;
+
+  std::atomic<bool> sleeping;
+  std::atomic<bool> stopping;
+  std::mutex wakeMutex;
+  std::condition_variable wakeup;
+  std::thread thread;
+};
+
+} // namespace Hector
+
+#endif // LOG_WRITER_HPP
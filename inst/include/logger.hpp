@@ -14,7 +14,11 @@
  *
  */
 
+#include <cstdio>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 // some boost headers generate warnings under clang; not our problem, ignore
 // 2023 and Boost 1.81.0_1: filtering_stream.hpp still generates one warning
 #pragma clang diagnostic push
@@ -27,6 +31,17 @@
 #define LOG_DIRECTORY "logs/"
 #define LOG_EXTENSION ".log"
 
+/*! \brief Lowest logging priority compiled into the model.
+ *
+ *  H_LOG statements below this level compile to nothing, whatever level a
+ *  logger is opened with at run time.  Build with, e.g.,
+ *  -DHECTOR_MIN_LOG_LEVEL=WARNING to strip the DEBUG and NOTICE messages out
+ *  of the per-timestep code.
+ */
+#ifndef HECTOR_MIN_LOG_LEVEL
+#define HECTOR_MIN_LOG_LEVEL DEBUG
+#endif
+
 namespace Hector {
 
 //------------------------------------------------------------------------------
@@ -35,6 +50,12 @@ namespace Hector {
  *  A basic logger class which can write logs to a file and optionally echo to
  *  the console as well.  Messages are logged with a priority and only messages
  *  with a high enough priority will actually be processed.
+ *
+ *  A logger can also be opened as the child of another, in which case its
+ *  records go wherever the parent's do (other than the console), tagged with
+ *  the child's name.  This is how the components of a core share the core's
+ *  log file.  Optionally the most recent records can be kept in memory
+ *  instead of (or as well as) being written to a file.
  */
 class Logger {
 public:
@@ -42,6 +63,9 @@ public:
    */
   enum LogLevel { DEBUG, NOTICE, WARNING, SEVERE };
 
+  //! Messages below this priority are removed at compile time.
+  static constexpr LogLevel compiledMinLogLevel = HECTOR_MIN_LOG_LEVEL;
+
 private:
   // Make the copy constructs private and undefined to disallow multiple
   // instances of the same log file.
@@ -61,6 +85,16 @@ private:
   //! If false this logger does not log regardless of log level provided.
   bool enabled;
 
+  //! Destination for records, shared with any child loggers.
+  struct Sink;
+  std::shared_ptr<Sink> sink;
+
+  //! Boost.Iostreams device that feeds loggerStream into the sink.
+  class SinkDevice;
+
+  //! Name written into each record by a child logger; empty otherwise.
+  std::string recordTag;
+
   //! The actual output stream which will handle the logging.
   boost::iostreams::filtering_ostream loggerStream;
 
@@ -75,9 +109,17 @@ public:
   ~Logger();
 
   void open(const std::string &logName, bool echoToScreen, bool echoToFile,
-            LogLevel minLogLevel);
+            LogLevel minLogLevel, std::size_t memoryRecords = 0);
+
+  void open(const std::string &logName, const Logger &parent,
+            LogLevel minLogLevel = DEBUG);
 
-  bool shouldWrite(const LogLevel writeLevel) const;
+  //! Indicate whether a message at the given priority will be logged.
+  //! Defined here so that checks against compiledMinLogLevel fold away.
+  bool shouldWrite(const LogLevel writeLevel) const {
+    return writeLevel >= compiledMinLogLevel && enabled &&
+           writeLevel >= minLogLevel;
+  }
 
   std::ostream &write(const LogLevel writeLevel,
                       const std::string &functionInfo);
@@ -89,6 +131,8 @@ public:
   bool getEchoToFile() const { return echoToFile; }
 
   bool isEnabled() const { return enabled; }
+
+  std::vector<std::string> getRecentRecords() const;
 };
 
 } // namespace Hector
@@ -105,7 +149,8 @@ public:
 /*! \brief Macro to perform logging.
  *
  *  This macro will check if the logging level qualifies to be logged.  If not
- *  the no more processing will be done.  Otherwise it will fill in the name of
+ *  the no more processing will be done; if the level is below
+ *  HECTOR_MIN_LOG_LEVEL the whole statement is compiled out.  Otherwise it will fill in the name of
  *  the function and return a reference to the output stream so the rest of the
  *  message may be logged.
  *
@@ -116,4 +161,23 @@ public:
   if (log.shouldWrite(level))                                                  \
   log.write(level, __func__)
 
+//------------------------------------------------------------------------------
+/*! \brief Macro to guard diagnostics that are expensive to compute.
+ *
+ *  H_LOG only skips formatting the message; any values computed beforehand
+ *  just for the log are still paid for.  Put such code in a block guarded by
+ *  this macro, e.g.
+ *
+ *      H_DIAGNOSTICS(logger, Logger::DEBUG) {
+ *          // ...compute things, then H_LOG them...
+ *      }
+ *
+ *  and it is only run when a message at that level will be written (and is
+ *  compiled out entirely below HECTOR_MIN_LOG_LEVEL).
+ *
+ * \param log An instance of the logger to log to.
+ * \param level The logging priority of the diagnostics.
+ */
+#define H_DIAGNOSTICS(log, level) if (log.shouldWrite(level))
+
 #endif
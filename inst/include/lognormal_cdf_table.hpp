@@ -0,0 +1,102 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef LOGNORMAL_CDF_TABLE_HPP
+#define LOGNORMAL_CDF_TABLE_HPP
+/*
+ *  lognormal_cdf_table.hpp
+ *  hector
+ *
+ *  Tabulated lognormal cumulative distribution function.
+ *
+ */
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief A lognormal CDF, tabulated for fast evaluation.
+ *
+ *  Used for permafrost thaw, which evaluates the CDF of each biome's lognormal
+ *  distribution every timestep.  The CDF and its slope are tabulated on a
+ *  uniform grid in log(x), so that the table resolves the distribution's shape
+ *  whatever its parameters, and evaluated between grid points by cubic Hermite
+ *  interpolation.  The grid is refined until the interpolation error, checked
+ *  against the exact CDF between every pair of grid points, is below maxError.
+ *  Below the start of the table the CDF is taken as zero (it is less than
+ *  1e-17 there), and beyond the end the exact CDF is used.  A distribution
+ *  lying entirely beyond the largest tabulated value gets an empty table, and
+ *  the exact CDF everywhere above xmin.
+ *
+ *  Tables are immutable, and are shared by everything that asks for the same
+ *  parameters (e.g. the members of an ensemble) through get().
+ */
+class LognormalCDFTable {
+public:
+  static std::shared_ptr<const LognormalCDFTable> get(double mu, double sigma);
+
+  //! Largest allowed difference from the exact CDF.
+  static constexpr double maxError = 1e-11;
+
+  //! Evaluate the CDF; 0 for x <= 0.
+  //! Defined here so that it can be inlined into the callers' loops.
+  double cdf(const double x) const {
+    if (x <= xmin) {
+      return 0.0;
+    }
+    const double pos = (std::log(x) - umin) * inv_step;
+    // Written so that NaN also goes to exact_cdf, which rejects it
+    if (!(pos < nintervals)) {
+      return exact_cdf(x);
+    }
+    const std::size_t i = static_cast<std::size_t>(pos);
+    const double t = pos - i;
+    const double *p = &table[2 * i];
+    // Cubic Hermite basis, in terms of the values and scaled slopes at the
+    // two ends of the interval
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    const double h00 = 2.0 * t3 - 3.0 * t2 + 1.0;
+    const double h10 = t3 - 2.0 * t2 + t;
+    const double h01 = -2.0 * t3 + 3.0 * t2;
+    const double h11 = t3 - t2;
+    return h00 * p[0] + h10 * p[1] + h01 * p[2] + h11 * p[3];
+  }
+
+  double exact_cdf(double x) const;
+
+  double get_mu() const { return mu; }
+  double get_sigma() const { return sigma; }
+
+  //! Number of grid points.
+  std::size_t size() const { return table.size() / 2; }
+
+private:
+  LognormalCDFTable(double mu, double sigma);
+
+  double exact_pdf(double x) const;
+  void fill(std::size_t npoints);
+  double worst_error() const;
+
+  double mu;    //!< Mean of the log of the variable
+  double sigma; //!< Standard deviation of the log of the variable
+  double umin;  //!< Start of the table, in log(x)
+  double umax;  //!< End of the table, in log(x)
+  double xmin;  //!< exp(umin)
+  double step;  //!< Grid spacing, in log(x)
+  double inv_step;
+  double nintervals; //!< Number of grid intervals (size() - 1)
+
+  //! CDF and (step * dCDF/dlog(x)), interleaved, at each grid point.
+  std::vector<double> table;
+};
+
+} // namespace Hector
+
+#endif // LOGNORMAL_CDF_TABLE_HPP
@@ -21,12 +21,15 @@
 
 namespace Hector {
 
+class AtmosphericChemistryEngine;
+
 //------------------------------------------------------------------------------
 /*! \brief Nitrous oxide model component.
  *
  *  This doesn't do much yet.
  */
 class N2OComponent : public IModelComponent {
+  friend class AtmosphericChemistryEngine;
 
 public:
   N2OComponent();
@@ -47,6 +50,8 @@ public:
 
   virtual void run(const double runToDate);
 
+  virtual bool runAhead(const double firstDate, const double lastDate);
+
   virtual void reset(double time);
 
   virtual void shutDown();
@@ -57,6 +62,11 @@ public:
 private:
   virtual unitval getData(const std::string &varName, const double date);
 
+  double lifetime(const double previous_n2o) const;
+
+  double step(const double previous_n2o, const double tau,
+              const double emissions) const;
+
   unitval N0;     //! preindustrial N2O, ppbv N2O
   unitval UC_N2O; //! conversion from emissions to concentration
   tseries<unitval>
@@ -75,6 +85,10 @@ private:
 
   Core *core;
   double oldDate;
+  double aheadDate; //! last date computed by runAhead()
+
+  //! Engine that runs this component, if any.
+  AtmosphericChemistryEngine *engine;
 };
 
 } // namespace Hector
@@ -27,6 +27,7 @@ namespace Hector {
  *  This doesn't do much yet.
  */
 class NH3Component : public IModelComponent {
+  friend class ShortLivedForcerEngine;
 
 public:
   NH3Component();
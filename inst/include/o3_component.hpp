@@ -26,6 +26,7 @@ namespace Hector {
  *  This doesn't do much yet.
  */
 class OzoneComponent : public IModelComponent {
+  friend class ShortLivedForcerEngine;
 
 public:
   OzoneComponent();
@@ -56,6 +57,12 @@ public:
 private:
   virtual unitval getData(const std::string &varName, const double date);
 
+  static double noxTerm(const double nox);
+  static double coTerm(const double co);
+  static double nmvocTerm(const double nmvoc);
+  static double concentration(const double ch4, const double nox_term,
+                              const double co_term, const double nmvoc_term);
+
   //! Current ozone concentration, relative to preindustrial, Dobson units
   unitval PO3;
   tseries<unitval> O3;
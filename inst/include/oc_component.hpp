@@ -27,6 +27,7 @@ namespace Hector {
  *  This doesn't do much yet.
  */
 class OrganicCarbonComponent : public IModelComponent {
+  friend class ShortLivedForcerEngine;
 
 public:
   OrganicCarbonComponent();
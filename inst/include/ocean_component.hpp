@@ -18,6 +18,7 @@
 #include "logger.hpp"
 #include "ocean_csys.hpp"
 #include "oceanbox.hpp"
+#include "quantity.hpp"
 #include "tseries.hpp"
 #include "tvector.hpp"
 #include "unitval.hpp"
@@ -30,6 +31,13 @@
   0.1 //!< trigger1 to reduce timestep:
       //!< absolute diff between successive annual fluxes (Pg C)
 
+// Ocean boxes, in the order used by the circulation matrix
+#define OCEAN_BOX_LL 0 //!< surface low latitude box
+#define OCEAN_BOX_HL 1 //!< surface high latitude box
+#define OCEAN_BOX_IO 2 //!< intermediate box
+#define OCEAN_BOX_DO 3 //!< deep box
+#define OCEAN_NBOXES 4
+
 namespace Hector {
 
 //------------------------------------------------------------------------------
@@ -100,6 +108,16 @@ private:
   oceanbox inter;     //!< intermediate box 1000m
   oceanbox deep;      //!< deep box 3000m
 
+  //! The boxes, indexed by OCEAN_BOX_*
+  oceanbox *boxes[OCEAN_NBOXES];
+
+  //! Circulation matrix: element [i * OCEAN_NBOXES + j] is the fraction of
+  //! box i's carbon that moves to box j each year
+  std::vector<double> circulation;
+  //! Carbon moved between boxes so far this year (Pg C/yr), laid out like
+  //! circulation
+  std::vector<double> box_fluxes;
+
   // Atmosphere conditions
   unitval SST;      //!< Ocean surface temperature anomaly, degC
   unitval CO2_conc; //!< Atmospheric CO2, ppm
@@ -133,8 +151,10 @@ private:
    * Private helper functions
    *****************************************************************/
   fluxpool totalcpool() const;
-  unitval annual_totalcflux(const double date, const unitval &CO2_conc,
-                            const double cpoolscale = 1.0) const;
+  void circulate(const double yf);
+  quantity<U_PGC_YR> annual_totalcflux(const double date,
+                                       const quantity<U_PPMV_CO2> CO2_conc,
+                                       const double cpoolscale = 1.0) const;
 
   /*****************************************************************
    * Adaptive timestep control
@@ -161,6 +181,7 @@ private:
   tvector<oceanbox> surfaceLL_tv;
   tvector<oceanbox> inter_tv;
   tvector<oceanbox> deep_tv;
+  tvector<std::vector<double>> box_fluxes_tv;
 
   // Ocean conditions over time
   tseries<unitval> SST_ts;
@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 
+#include "quantity.hpp"
 #include "unitval.hpp"
 
 namespace Hector {
@@ -48,13 +49,14 @@ public:
   unitval TCO2o; ///< total CO2 (umol/kg)
   unitval HCO3;  ///< bicarbonate (umol/kg)
   unitval CO3;   ///< carbonate (umol/kg)
-  unitval PCO2o; ///< pCO2 of ocean waters
+  quantity<U_UATM> PCO2o; ///< pCO2 of ocean waters
   unitval pH;    ///< ocean pH
 
   unitval convertToDIC(const unitval carbon);
   void ocean_csys_run(unitval tbox, unitval carbon);
-  unitval calc_annual_surface_flux(const unitval &CO2_conc,
-                                   const double cpoolscale = 1.0) const;
+  quantity<U_PGC_YR>
+  calc_annual_surface_flux(const quantity<U_PPMV_CO2> CO2_conc,
+                           const double cpoolscale = 1.0) const;
   unitval get_K0() const { return K0; };
   unitval get_Tr() const { return Tr; };
 
@@ -62,12 +64,14 @@ public:
   double get_alk() const { return alk; };
 
 private:
-  double calc_monthly_surface_flux(const unitval &CO2_conc,
+  void calc_constants(const double Tc);
+  double calc_monthly_surface_flux(const quantity<U_PPMV_CO2> CO2_conc,
                                    const double cpoolscale = 1.0) const;
 
   unitval
       K0; ///< solubility of CO2 calculated from Weiss 1974 (mol * L-1 * atm-1)
-  unitval Tr; ///< gas transfer coefficient (gC m-2 month-1 uatm-1)
+  quantity<U_gC_m2_month_uatm>
+      Tr; ///< gas transfer coefficient (gC m-2 month-1 uatm-1)
   unitval Kh; ///< solubility of CO2 calculated from Weiss 1974 (mol*kg-1*atm-1)
   unitval Kw; ///< equilirbium relationship of H+ and OH- (mol kg-1)
   unitval K1; ///< equilibrium relationship of CO2 in seawater (mol kg-1)
@@ -78,6 +82,13 @@ private:
       Kspa; ///< equilibrium relationship of aragonite in seawater (mol kg-1)
   unitval Kspc; ///< equilibrium relationship of calcite in seawater (mol kg-1)
 
+  double bor;     ///< total boron (mol/kg)
+  double calcium; ///< calcium (mol/kg)
+
+  double constantsTc; ///< temperature (degC) the constants were calculated at
+  double constantsS;  ///< salinity the constants were calculated at
+  double constantsU;  ///< wind speed the constants were calculated at
+
   double alk; ///< alkilinity (umol/kg)
 
   // logger
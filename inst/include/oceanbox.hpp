@@ -25,6 +25,7 @@
 #include "fluxpool.hpp"
 #include "logger.hpp"
 #include "ocean_csys.hpp"
+#include "quantity.hpp"
 #include "unitval.hpp"
 
 // Mean absolute global tos temperature, preindustrial (deg C), this is used by
@@ -39,21 +40,18 @@ namespace Hector {
 class oceanbox {
   /*! /brief  An ocean box
    *
-   *  Implements an ocean box, which can have arbitrary connections to
-   *  other boxes, may (or not) exchange carbon and heat with the atmosphere,
-   *  and may (or not) have active chemistry.
+   *  Implements an ocean box, which may (or not) exchange carbon and heat with
+   *  the atmosphere, and may (or not) have active chemistry. Circulation
+   *  between the boxes is handled by the ocean component, which tells each box
+   *  how much carbon it gains and loses.
    */
 private:
   fluxpool carbon;
   fluxpool CarbonAdditions, CarbonSubtractions;
-  std::vector<oceanbox *> connection_list; ///< a vector of ocean box pointers
-  std::vector<double> connection_k; ///< a vector of ocean k values (fraction)
-  std::vector<int>
-      connection_window; ///< a vector of connection windows to average over
 
   std::string Name;
 
-  unitval CO2_conc;      ///< Atmospheric [CO2], ppm
+  quantity<U_PPMV_CO2> CO2_conc; ///< Atmospheric [CO2], ppm
   unitval Tbox;          ///< box absolute temperature, degC
   unitval pco2_lastyear; //
   unitval dic_lastyear;  //
@@ -64,13 +62,9 @@ private:
 public:
   oceanbox(); // constructor
 
-  std::map<oceanbox *, unitval>
-      annual_box_fluxes; ///< Map of our fluxes to other boxes
-
   void initbox(double C, std::string name = "");
-  void make_connection(oceanbox *ob, const double k, const int window);
   void compute_fluxes(const unitval current_Ca, const fluxpool atmosphere_cpool,
-                      const double yf, const bool do_circ = true);
+                      const double yf);
   void log_state();
   void update_state();
   void new_year(const unitval SST);
@@ -82,6 +76,10 @@ public:
   fluxpool get_ao_flux() const { return ao_flux; };
 
   void add_carbon(fluxpool C);
+  void set_circulation_fluxes(const double additions,
+                              const double subtractions,
+                              const bool set_additions);
+  const std::string &get_name() const { return Name; };
 
   void start_tracking();
 
@@ -89,7 +87,7 @@ public:
   unitval get_Tbox() const { return Tbox; };
   unitval calc_revelle();
   unitval deltaT; ///< difference between box temperature and global temperature
-  unitval preindustrial_flux;
+  quantity<U_PGC_YR> preindustrial_flux;
   bool surfacebox;
 
   // Ocean box chemistry
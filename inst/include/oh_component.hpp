@@ -22,12 +22,15 @@
 
 namespace Hector {
 
+class AtmosphericChemistryEngine;
+
 //------------------------------------------------------------------------------
 /*! \brief Methane model component.
  *
  *  This doesn't do much yet.
  */
 class OHComponent : public IModelComponent {
+  friend class AtmosphericChemistryEngine;
 
 public:
   OHComponent();
@@ -57,6 +60,10 @@ public:
 
 private:
   virtual unitval getData(const std::string &varName, const double date);
+
+  double lifetime(const double previous_ch4, const double dNOX,
+                  const double dCO, const double dNMVOC) const;
+
   //! emissions time series
   tseries<unitval> CO_emissions;
   tseries<unitval> NOX_emissions;
@@ -76,6 +83,9 @@ private:
 
   Core *core;
   double oldDate;
+
+  //! Engine that runs this component, if any.
+  AtmosphericChemistryEngine *engine;
 };
 
 } // namespace Hector
@@ -0,0 +1,138 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef QUANTITY_HPP
+#define QUANTITY_HPP
+/*
+ *  quantity.hpp - numbers with units fixed at compile time
+ *  hector
+ *
+ */
+
+#include <ostream>
+
+#include "unitval.hpp"
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief A number whose units are part of its type.
+ *
+ *  A unitval carries its units at run time, and checks them on every
+ *  operation, which suits values passed between components by message.
+ *  Inside a component's numeric kernel the units of each variable are fixed,
+ *  so a quantity carries them as a template parameter instead: mixing units
+ *  (e.g. adding Pg C to Pg C/yr) fails to compile, and the arithmetic is
+ *  that of bare doubles.
+ *
+ *  Conversion from a unitval is explicit and checks the units (see H_CHECK),
+ *  once; this belongs where a kernel takes its inputs (setData(), or reading
+ *  a stored pool).  Conversion to a unitval is implicit, for getData() and
+ *  output.
+ */
+template <unit_types U> class quantity {
+public:
+  constexpr quantity() : val(0.0) {}
+  constexpr explicit quantity(const double v) : val(v) {}
+  explicit quantity(const unitval &v) : val(v.value(U)) {}
+
+  operator unitval() const { return unitval(val, U); }
+
+  constexpr double value() const { return val; }
+  static constexpr unit_types units() { return U; }
+
+  quantity &operator+=(const quantity x) {
+    val += x.val;
+    return *this;
+  }
+  quantity &operator-=(const quantity x) {
+    val -= x.val;
+    return *this;
+  }
+  quantity &operator*=(const double x) {
+    val *= x;
+    return *this;
+  }
+  quantity &operator/=(const double x) {
+    val /= x;
+    return *this;
+  }
+
+private:
+  double val;
+};
+
+template <unit_types U>
+constexpr quantity<U> operator+(const quantity<U> lhs, const quantity<U> rhs) {
+  return quantity<U>(lhs.value() + rhs.value());
+}
+template <unit_types U>
+constexpr quantity<U> operator-(const quantity<U> lhs, const quantity<U> rhs) {
+  return quantity<U>(lhs.value() - rhs.value());
+}
+template <unit_types U>
+constexpr quantity<U> operator-(const quantity<U> rhs) {
+  return quantity<U>(-rhs.value());
+}
+template <unit_types U>
+constexpr quantity<U> operator*(const quantity<U> lhs, const double rhs) {
+  return quantity<U>(lhs.value() * rhs);
+}
+template <unit_types U>
+constexpr quantity<U> operator*(const double lhs, const quantity<U> rhs) {
+  return quantity<U>(lhs * rhs.value());
+}
+template <unit_types U>
+constexpr quantity<U> operator/(const quantity<U> lhs, const double rhs) {
+  return quantity<U>(lhs.value() / rhs);
+}
+//! The ratio of two quantities in the same units is a plain number.
+template <unit_types U>
+constexpr double operator/(const quantity<U> lhs, const quantity<U> rhs) {
+  return lhs.value() / rhs.value();
+}
+
+//! Mixing units doesn't compile (rather than converting both to unitvals).
+template <unit_types U1, unit_types U2>
+quantity<U1> operator+(const quantity<U1>, const quantity<U2>) = delete;
+template <unit_types U1, unit_types U2>
+quantity<U1> operator-(const quantity<U1>, const quantity<U2>) = delete;
+template <unit_types U1, unit_types U2>
+double operator/(const quantity<U1>, const quantity<U2>) = delete;
+
+template <unit_types U>
+constexpr bool operator==(const quantity<U> lhs, const quantity<U> rhs) {
+  return lhs.value() == rhs.value();
+}
+template <unit_types U>
+constexpr bool operator!=(const quantity<U> lhs, const quantity<U> rhs) {
+  return lhs.value() != rhs.value();
+}
+template <unit_types U>
+constexpr bool operator<(const quantity<U> lhs, const quantity<U> rhs) {
+  return lhs.value() < rhs.value();
+}
+template <unit_types U>
+constexpr bool operator>(const quantity<U> lhs, const quantity<U> rhs) {
+  return lhs.value() > rhs.value();
+}
+template <unit_types U>
+constexpr bool operator<=(const quantity<U> lhs, const quantity<U> rhs) {
+  return lhs.value() <= rhs.value();
+}
+template <unit_types U>
+constexpr bool operator>=(const quantity<U> lhs, const quantity<U> rhs) {
+  return lhs.value() >= rhs.value();
+}
+
+template <unit_types U>
+std::ostream &operator<<(std::ostream &out, const quantity<U> x) {
+  return out << unitval(x);
+}
+
+} // namespace Hector
+
+#endif // QUANTITY_HPP
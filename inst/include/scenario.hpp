@@ -0,0 +1,71 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef SCENARIO_HPP
+#define SCENARIO_HPP
+/*
+ *  scenario.hpp
+ *  hector
+ *
+ *  The parsed contents of an input file, for setting up many cores.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "message_data.hpp"
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief One value to set in a core, as Core::setData() takes it.
+ */
+struct ScenarioSetting {
+  ScenarioSetting(const std::string &componentName, const std::string &varName,
+                  const message_data &data)
+      : componentName(componentName), varName(varName), data(data) {}
+
+  std::string componentName; //!< INI section, e.g. simpleNbox
+  std::string varName;       //!< variable, e.g. beta or ffi_emissions
+  message_data data;         //!< value, and date if it has one
+};
+
+//------------------------------------------------------------------------------
+/*! \brief The parsed contents of an input file and the tables it names.
+ *
+ *  Setting up a core from an input file means parsing the INI file and every
+ *  table it names, and converting each value from text.  A Scenario does that
+ *  once: it reads the file into a scratch core, which checks every value
+ *  (units included) just as reading the file directly would, and keeps the
+ *  values, converted to numbers where they are numbers.
+ *  Core::applyScenario() then sets up any number of cores from them without
+ *  reading or parsing anything.
+ *
+ *  A Scenario can't be changed once it has been read, so copies share their
+ *  values, and any number of threads can apply the same one at once.
+ */
+class Scenario {
+public:
+  explicit Scenario(const std::string &filename);
+
+  //! The input file the scenario was read from.
+  const std::string &getFileName() const { return fileName; }
+
+  //! The values to set, in the order the input file gives them.
+  const std::vector<ScenarioSetting> &getSettings() const { return *settings; }
+
+private:
+  static void compile(message_data &data);
+
+  std::string fileName;
+  std::shared_ptr<const std::vector<ScenarioSetting>> settings;
+};
+
+} // namespace Hector
+
+#endif // SCENARIO_HPP
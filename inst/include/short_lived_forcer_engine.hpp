@@ -0,0 +1,120 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef SHORT_LIVED_FORCER_ENGINE_HPP
+#define SHORT_LIVED_FORCER_ENGINE_HPP
+/*
+ *  short_lived_forcer_engine.hpp
+ *  hector
+ *
+ *  Tabulated aerosol and ozone-precursor forcing terms.
+ *
+ */
+
+#include <vector>
+
+namespace Hector {
+
+class Core;
+class IModelComponent;
+class BlackCarbonComponent;
+class OrganicCarbonComponent;
+class SulfurComponent;
+class NH3Component;
+class OzoneComponent;
+class ForcingComponent;
+
+//------------------------------------------------------------------------------
+/*! \brief Computes the short-lived forcings for a whole run at once.
+ *
+ *  The aerosol forcings (BC, OC, SO2, NH3, aerosol-cloud interactions, and
+ *  volcanic) depend only on emissions and parameters.  Without the engine,
+ *  ForcingComponent computes them a year at a time by fetching each
+ *  emission through a message to the BC, OC, SO2, and NH3 components.  The
+ *  engine instead copies all the emissions into one contiguous array per
+ *  species, for every year of the run, and computes each forcing for all
+ *  years in a single pass.
+ *
+ *  Tropospheric ozone also depends on the CH4 concentration, so it's still
+ *  computed by OzoneComponent each year; but its emission terms (NOX, CO,
+ *  NMVOC) are tabulated here the same way.
+ *
+ *  The components are kept as the engine's front ends: they still take the
+ *  inputs and provide all the same capabilities.  The core invalidates the
+ *  engine whenever any input is set, or the model is reset or prepared to
+ *  run, and it reloads before the next year.  Results are identical to the
+ *  year-by-year calculation.
+ */
+class ShortLivedForcerEngine {
+public:
+  ShortLivedForcerEngine(Core *core,
+                         const std::vector<IModelComponent *> &components);
+
+  void run(const double runToDate);
+
+  //! Reload inputs and parameters before the next year is run.
+  void invalidate() { stale = true; }
+
+  //! Aerosol forcings, W/m2, in the order returned by getAerosolForcings().
+  enum AerosolForcing {
+    RF_BC,
+    RF_OC,
+    RF_SO2,
+    RF_NH3,
+    RF_ACI,
+    N_AEROSOL_FORCINGS
+  };
+
+  //! Ozone precursor terms, DU, in the order returned by
+  //! getOzonePrecursors().
+  enum OzonePrecursor { O3_NOX, O3_CO, O3_NMVOC, N_OZONE_PRECURSORS };
+
+  //! True if all four aerosol components are enabled.
+  bool hasAerosols() const { return bc && oc && so2 && nh3; }
+
+  //! True if the SO2 component (which holds volcanic forcing) is enabled.
+  bool hasVolcanic() const { return so2 != NULL; }
+
+  void getAerosolForcings(const double date, double rf[]) const;
+
+  double getVolcanicForcing(const double date) const;
+
+  void getOzonePrecursors(const double date, double terms[]) const;
+
+private:
+  void load(const double runToDate);
+
+  void extend(const double newLastDate);
+
+  std::size_t row(const double date) const;
+
+  void checkAerosolInputs(const double date) const;
+
+  Core *core;
+  BlackCarbonComponent *bc;
+  OrganicCarbonComponent *oc;
+  SulfurComponent *so2;
+  NH3Component *nh3;
+  OzoneComponent *o3;
+  ForcingComponent *forcing;
+
+  //! Inputs by year, starting at firstDate.  Values that can't be found are
+  //! NaN; that's only an error if they're used (see checkAerosolInputs()).
+  std::vector<double> E_BC, E_OC, E_SO2, E_NH3, E_NOX, E_CO, E_NMVOC;
+
+  //! Outputs by year, starting at firstDate
+  std::vector<double> aerosolRF[N_AEROSOL_FORCINGS];
+  std::vector<double> volcanicRF;
+  std::vector<double> ozoneTerms[N_OZONE_PRECURSORS];
+
+  double firstDate;
+  double lastTableDate;
+  bool stale;
+};
+
+} // namespace Hector
+
+#endif // SHORT_LIVED_FORCER_ENGINE_HPP
@@ -13,18 +13,17 @@
  *
  */
 
+#include <memory>
+
 #include "carbon-cycle-model.hpp"
 #include "fluxpool.hpp"
+#include "lognormal_cdf_table.hpp"
 #include "ocean_component.hpp"
+#include "quantity.hpp"
 #include "temperature_component.hpp"
 #include "tseries.hpp"
 #include "unitval.hpp"
 
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Weverything"
-#include <boost/math/distributions/lognormal.hpp>
-#pragma clang diagnostic pop
-
 #define SNBOX_ATMOS 0
 #define SNBOX_VEG 1
 #define SNBOX_DET 2
@@ -50,6 +49,7 @@ class SimpleNbox : public CarbonCycleModel {
   friend class CSVOutputVisitor;
   friend class CSVOutputStreamVisitor;
   friend class CSVFluxPoolVisitor;
+  friend class AtmosphericChemistryEngine;
 
 public:
   SimpleNbox();
@@ -245,7 +245,7 @@ private:
   double_stringmap f_litterd; //!< fraction of litter to detritus
 
   // Initial fluxes
-  fluxpool_stringmap npp_flux0; //!< preindustrial NPP
+  std::map<std::string, quantity<U_PGC_YR>> npp_flux0; //!< preindustrial NPP
 
   // Variables needed to adjust NPP for LUC
   unitval cum_luc_va;
@@ -273,8 +273,9 @@ private:
       pf_sigma;           //!< Standard deviation for permafrost-temp model fit
   double_stringmap pf_mu; //!< Mean for permafrost-temp model fit
   double_stringmap fpf_static; //!< Permafrost C non-labile fraction
-  typedef std::map<std::string, boost::math::lognormal> lognormal_stringmap;
-  lognormal_stringmap pf_s; //!< Permafrost lognormal distribution
+  typedef std::map<std::string, std::shared_ptr<const LognormalCDFTable>>
+      lognormal_stringmap;
+  lognormal_stringmap pf_s; //!< Permafrost lognormal distribution (CDF)
 
   /*****************************************************************
    * Functions computing sub-elements of the carbon cycle
@@ -300,9 +301,45 @@ private:
      double time = Core::undefinedIndex()) const; //!< calculates RH for a biome
   fluxpool sum_rh(double time = Core::undefinedIndex())
       const; //!< calculates RH, global total
-  tuple<double, double, double> compute_pf_thaw_refreeze(string biome,
-                                                         fluxpool rh_co2,
-                                                         fluxpool rh_ch4) const;
+  tuple<double, double, double>
+  compute_pf_thaw_refreeze(const string &biome, const double rh_co2,
+                           const double rh_ch4) const;
+
+  /*****************************************************************
+   * Per-biome flux equations, on plain values (Pg C and Pg C/yr)
+   * Shared by the fluxpool functions above, which report the fluxes,
+   * and by calcderivs(), which sums them for the solver
+   *****************************************************************/
+  static constexpr double RH_DET_RATE = 0.25;  //!< detritus respiration, 1/yr
+  static constexpr double RH_SOIL_RATE = 0.02; //!< soil respiration, 1/yr
+  static constexpr double LITTER_RATE = 0.035; //!< veg to litter, 1/yr
+  static constexpr double DETSOIL_RATE = 0.6;  //!< detritus to soil, 1/yr
+
+  //! NPP, scaled by CO2 fertilization and land-use change
+  static double npp_flux(const double npp0, const double co2fert,
+                         const double luc_adjust) {
+    return npp0 * co2fert * luc_adjust;
+  }
+  //! Heterotrophic respiration from detritus
+  static double rh_det_flux(const double det, const double tfd) {
+    return det * RH_DET_RATE * tfd;
+  }
+  //! Heterotrophic respiration from soil
+  static double rh_soil_flux(const double soil, const double tfs) {
+    return soil * RH_SOIL_RATE * tfs;
+  }
+  //! CO2 part of the heterotrophic respiration from the labile fraction of
+  //! thawed permafrost
+  static double rh_thawedp_co2_flux(const double thawedp,
+                                    const double labile_frac, const double tfs,
+                                    const double ch4_frac) {
+    return thawedp * labile_frac * RH_SOIL_RATE * tfs * (1.0 - ch4_frac);
+  }
+  //! CH4 part of the thawed permafrost respiration, given the CO2 part
+  static double rh_thawedp_ch4_flux(const double rh_co2,
+                                    const double ch4_frac) {
+    return rh_co2 / (1.0 - ch4_frac) * ch4_frac;
+  }
 
   /*****************************************************************
    * Private helper functions
@@ -26,6 +26,7 @@ namespace Hector {
  *  This doesn't do much yet.
  */
 class SulfurComponent : public IModelComponent {
+  friend class ShortLivedForcerEngine;
 
 public:
   SulfurComponent();
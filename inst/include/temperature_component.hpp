@@ -14,9 +14,11 @@
  *
  */
 
+#include "doeclim.hpp"
 #include "forcing_component.hpp"
 #include "imodel_component.hpp"
 #include "logger.hpp"
+#include "quantity.hpp"
 #include "tseries.hpp"
 #include "unitval.hpp"
 
@@ -41,6 +43,8 @@ namespace Hector {
  * representation of societal trade-offs. Clim. Change 134, 713–723.
  */
 class TemperatureComponent : public IModelComponent {
+  friend class LinearTemperatureResponse;
+  friend class TemperatureSensitivity;
 
 public:
   TemperatureComponent();
@@ -68,68 +72,21 @@ public:
   //! IVisitable methods
   virtual void accept(AVisitor *visitor);
 
+  virtual void getDataSeries(const std::string &varName,
+                             const std::vector<double> &dates,
+                             std::vector<unitval> &values);
+
 private:
   virtual unitval getData(const std::string &varName, const double date);
-  void invert_1d_2x2_matrix(double *x, double *y);
+  const std::vector<double> *datedSeries(const std::string &varName,
+                                         double &scale,
+                                         unit_types &units) const;
   void setoutputs(int tstep);
 
-  // Hard-coded DOECLIM parameters
-  const double dt = 1;    // years per timestep (this is implicit in Hector)
-  int ns;                 // number of timesteps
-  const double ak = 0.31; // slope in climate feedback - land-sea heat exchange
-                          // linear relationship (W/m2/K)
-  const double bk = 1.59; // offset in climate feedback - land-sea heat exchange
-                          // linear relationship,(W/m2/K)
-  const double csw = 0.13; // specific heat capacity of seawater (Wyr/(m3K))
-  const double earth_area = 5100656E8; // (m2)
-  const double secs_per_Year =
-      60.0 * 60.0 * 24.0 *
-      365.2422; //  secs. * min. * hrs. * tropical calendar days (seconds)
-  const double rlam = 1.43;   // factor between land clim. sens. and sea surface
-                              // clim. sens. T_L2x = rlam*T_S2x (unitless)
-  const double zbot = 4000.0; // bottom depth of the interior ocean (m)
-  const double bsi = 1.3; // warming factor for marine surface air over SST due
-                          // to retreating sea ice, (unitless)
-  const double cal =
-      0.52; // effective heat capacity of land-troposphere system (W*yr/m2/K)
-  const double cas = 7.80; // effective heat capacity of mixed layer-troposphere
-                           // system (W*yr/m2/K)
-  const double flnd = 0.29; // fractional land area (unitless)
-  const double fso = 0.95;  // ocean fractional area below 60m (unitless)
-
-  // DOECLIM parameters calculated from constants above
-  double kcon;       // conversion from cm2/s to m2/yr
-  double ocean_area; // m2
-  double cnum; // factor from sea-surface climate sensitivity to global mean
-  double cden; // denominator used to figure out the climate senstivity feedback
-               // parameters over land & sea
-  double cfl;  // land climate feedback parameter, W/m2/K
-  double cfs;  // sea climate feedback parameter, W/m2/K
-  double kls;  // land-sea heat exchange coefficient, W/m2/K
-  double keff; // ocean heat diffusivity, m2/yr
-  double taubot;    // ocean bottom diffusion time scale, yr
-  double powtoheat; // convert flux to total ocean heat 1E22 m2*s
-  double taucfs;    // sea climate feedback time scale, yr
-  double taucfl;    // land climate feedback time scale, yr
-  double taudif;    // interior ocean heat uptake time scale, yr
-  double tauksl;    // sea-land heat exchange time scale, yr
-  double taukls;    // land-sea heat exchange time scale, yr
-  double qco2;      // radiative forcing for atmospheric CO2 doubling
-
-  std::vector<double> KT0;
-  std::vector<double> KTA1;
-  std::vector<double> KTB1;
-  std::vector<double> KTA2;
-  std::vector<double> KTB2;
-  std::vector<double> KTA3;
-  std::vector<double> KTB3;
-
-  // Components of the difference equation system B*T(i+1) = Q(i) + A*T(i)
-  double B[4];
-  double C[4];
-  std::vector<double> Ker;
-  double A[4];
-  double IB[4];
+  //! The DOECLIM equations, their constants, and the coefficients derived
+  //! from the parameters
+  DOECLIM<double> doeclim;
+  double qco2; // radiative forcing for atmospheric CO2 doubling
 
   // Time series arrays that are updated with each DOECLIM time-step
   std::vector<double> temp;
@@ -143,8 +100,8 @@ private:
   std::vector<double> forcing;
 
   // Model parameters
-  unitval S;      //!< climate sensitivity for 2xCO2, deg C
-  unitval diff;   //!< ocean heat diffusivity, cm2/s
+  quantity<U_DEGC> S;     //!< climate sensitivity for 2xCO2, deg C
+  quantity<U_CM2_S> diff; //!< ocean heat diffusivity, cm2/s
 
   // Model outputs
   unitval tas;       //!< global average air temperature anomaly, deg C
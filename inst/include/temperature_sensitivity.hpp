@@ -0,0 +1,65 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef TEMPERATURE_SENSITIVITY_HPP
+#define TEMPERATURE_SENSITIVITY_HPP
+/*
+ *  temperature_sensitivity.hpp
+ *  hector
+ *
+ *  Temperature trajectories with their derivatives by climate parameter.
+ *
+ */
+
+#include <vector>
+
+#include "linear_temperature_response.hpp"
+
+namespace Hector {
+
+class TemperatureComponent;
+
+//------------------------------------------------------------------------------
+/*! \brief Tangent-linear DOECLIM: trajectories and their parameter Jacobian.
+ *
+ *  Steps the temperature component's equations (see DOECLIM), from its
+ *  parameters through the coefficients derived from them and the diffusion
+ *  kernel to every year's temperatures and heat fluxes, in dual numbers.
+ *  One pass gives the trajectories together with their exact derivatives with
+ *  respect to the climate sensitivity, ocean diffusivity, and 2xCO2 forcing,
+ *  rather than a finite difference needing a further run per parameter.
+ *
+ *  As with LinearTemperatureResponse, the forcing is given, so these are
+ *  derivatives at fixed forcing.  The trajectories are linear in the
+ *  forcing, so derivatives with respect to a parameter that scales part of
+ *  it (e.g. the aerosol or volcanic scalars) are the response to that part:
+ *  LinearTemperatureResponse::compute() of dF/dp.  Parameters that act
+ *  through the carbon cycle (beta, q10_rh, npp_flux0, ...) aren't covered.
+ */
+class TemperatureSensitivity {
+public:
+  //! The parameters derivatives are taken with respect to.
+  enum Parameter { ECS, DIFFUSIVITY, QCO2, N_PARAMETERS };
+
+  typedef LinearTemperatureResponse::Trajectories Trajectories;
+
+  explicit TemperatureSensitivity(const TemperatureComponent &temperature);
+
+  void compute(const std::vector<double> &forcing, Trajectories &values,
+               Trajectories derivs[N_PARAMETERS]) const;
+
+  //! Longest forcing series compute() takes: the model's number of years.
+  std::size_t maxYears() const { return ns; }
+
+private:
+  //! Copied from the temperature component.
+  std::size_t ns;
+  double S, diff, qco2;
+};
+
+} // namespace Hector
+
+#endif // TEMPERATURE_SENSITIVITY_HPP
@@ -222,8 +222,8 @@ inline void unitval::set(double v, unit_types u, double err = 0.0) {
  */
 inline double unitval::value(unit_types u) const {
   if (u != valUnits) {
-    H_ASSERT(u == valUnits, "variable is not of this type.  Expected: " +
-                                unitsName(valUnits) + "; got: " + unitsName(u));
+    H_CHECK(u == valUnits, "variable is not of this type.  Expected: " +
+                               unitsName(valUnits) + "; got: " + unitsName(u));
   }
   return (val);
 }
@@ -234,7 +234,7 @@ inline double unitval::value(unit_types u) const {
  *  Add two unitvals. Must be of the same type.
  */
 inline unitval operator+(const unitval &lhs, const unitval &rhs) {
-  H_ASSERT(lhs.valUnits == rhs.valUnits, "units mismatch");
+  H_CHECK(lhs.valUnits == rhs.valUnits, "units mismatch");
   return unitval(lhs.val + rhs.val, lhs.valUnits);
 }
 
@@ -244,7 +244,7 @@ inline unitval operator+(const unitval &lhs, const unitval &rhs) {
  *  Subtract two unitvals. Must be of the same type.
  */
 inline unitval operator-(const unitval &lhs, const unitval &rhs) {
-  H_ASSERT(lhs.valUnits == rhs.valUnits, "units mismatch");
+  H_CHECK(lhs.valUnits == rhs.valUnits, "units mismatch");
   return unitval(lhs.val - rhs.val, lhs.valUnits);
 }
 
@@ -299,7 +299,7 @@ inline unitval operator/(const double lhs, const unitval &rhs) {
  *  Divide two unitvals. Must be of the same type, returning double.
  */
 inline double operator/(const unitval &lhs, const unitval &rhs) {
-  H_ASSERT(lhs.valUnits == rhs.valUnits, "units mismatch");
+  H_CHECK(lhs.valUnits == rhs.valUnits, "units mismatch");
   return lhs.val / rhs.val;
 }
 
@@ -2641,6 +2641,31 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// read_scenario_impl
+SEXP read_scenario_impl(String inifile);
+RcppExport SEXP _hector_read_scenario_impl(SEXP inifileSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< String >::type inifile(inifileSEXP);
+    rcpp_result_gen = Rcpp::wrap(read_scenario_impl(inifile));
+    return rcpp_result_gen;
+END_RCPP
+}
+// newcore_scenario_impl
+Environment newcore_scenario_impl(SEXP scenario, int loglevel, bool suppresslogging, String name);
+RcppExport SEXP _hector_newcore_scenario_impl(SEXP scenarioSEXP, SEXP loglevelSEXP, SEXP suppressloggingSEXP, SEXP nameSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type scenario(scenarioSEXP);
+    Rcpp::traits::input_parameter< int >::type loglevel(loglevelSEXP);
+    Rcpp::traits::input_parameter< bool >::type suppresslogging(suppressloggingSEXP);
+    Rcpp::traits::input_parameter< String >::type name(nameSEXP);
+    rcpp_result_gen = Rcpp::wrap(newcore_scenario_impl(scenario, loglevel, suppresslogging, name));
+    return rcpp_result_gen;
+END_RCPP
+}
 // shutdown
 Environment shutdown(Environment core);
 RcppExport SEXP _hector_shutdown(SEXP coreSEXP) {
@@ -2762,6 +2787,36 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// fetchvars_impl
+List fetchvars_impl(Environment core, StringVector vars, NumericVector dates);
+RcppExport SEXP _hector_fetchvars_impl(SEXP coreSEXP, SEXP varsSEXP, SEXP datesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Environment >::type core(coreSEXP);
+    Rcpp::traits::input_parameter< StringVector >::type vars(varsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type dates(datesSEXP);
+    rcpp_result_gen = Rcpp::wrap(fetchvars_impl(core, vars, dates));
+    return rcpp_result_gen;
+END_RCPP
+}
+// run_ensemble_impl
+List run_ensemble_impl(String inifile, NumericMatrix params, StringVector param_names, StringVector param_units, StringVector vars, NumericVector dates, int threads);
+RcppExport SEXP _hector_run_ensemble_impl(SEXP inifileSEXP, SEXP paramsSEXP, SEXP param_namesSEXP, SEXP param_unitsSEXP, SEXP varsSEXP, SEXP datesSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< String >::type inifile(inifileSEXP);
+    Rcpp::traits::input_parameter< NumericMatrix >::type params(paramsSEXP);
+    Rcpp::traits::input_parameter< StringVector >::type param_names(param_namesSEXP);
+    Rcpp::traits::input_parameter< StringVector >::type param_units(param_unitsSEXP);
+    Rcpp::traits::input_parameter< StringVector >::type vars(varsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type dates(datesSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(run_ensemble_impl(inifile, params, param_names, param_units, vars, dates, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // chk_core_valid
 bool chk_core_valid(Environment core);
 RcppExport SEXP _hector_chk_core_valid(SEXP coreSEXP) {
@@ -3036,6 +3091,8 @@ static const R_CallMethodDef CallEntries[] = {
     {"_hector_FLUX_INTERIOR", (DL_FUNC) &_hector_FLUX_INTERIOR, 0},
     {"_hector_HEAT_FLUX", (DL_FUNC) &_hector_HEAT_FLUX, 0},
     {"_hector_newcore_impl", (DL_FUNC) &_hector_newcore_impl, 4},
+    {"_hector_read_scenario_impl", (DL_FUNC) &_hector_read_scenario_impl, 1},
+    {"_hector_newcore_scenario_impl", (DL_FUNC) &_hector_newcore_scenario_impl, 4},
     {"_hector_shutdown", (DL_FUNC) &_hector_shutdown, 1},
     {"_hector_reset", (DL_FUNC) &_hector_reset, 2},
     {"_hector_run", (DL_FUNC) &_hector_run, 2},
@@ -3046,6 +3103,8 @@ static const R_CallMethodDef CallEntries[] = {
     {"_hector_delete_biome_impl", (DL_FUNC) &_hector_delete_biome_impl, 2},
     {"_hector_rename_biome", (DL_FUNC) &_hector_rename_biome, 3},
     {"_hector_sendmessage", (DL_FUNC) &_hector_sendmessage, 6},
+    {"_hector_fetchvars_impl", (DL_FUNC) &_hector_fetchvars_impl, 3},
+    {"_hector_run_ensemble_impl", (DL_FUNC) &_hector_run_ensemble_impl, 7},
     {"_hector_chk_core_valid", (DL_FUNC) &_hector_chk_core_valid, 1},
     {NULL, NULL, 0}
 };
@@ -0,0 +1,219 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  atmospheric_chemistry_engine.cpp
+ *  hector
+ *
+ *  Advance OH lifetime, CH4, and N2O together.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "atmospheric_chemistry_engine.hpp"
+#include "ch4_component.hpp"
+#include "component_data.hpp"
+#include "core.hpp"
+#include "engine_tables.hpp"
+#include "h_exception.hpp"
+#include "n2o_component.hpp"
+#include "oh_component.hpp"
+#include "simpleNbox.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+/*! \brief Constructor; attaches the engine to the chemistry components.
+ *  \param core       The core that owns the components.
+ *  \param components The core's (enabled) components.  From now on the OH
+ *                    and CH4 components (if both are among them) and the N2O
+ *                    component (if it is) are run by the engine rather than
+ *                    by their own run().
+ */
+AtmosphericChemistryEngine::AtmosphericChemistryEngine(
+    Core *core, const vector<IModelComponent *> &components)
+    : core(core), oh(NULL), ch4(NULL), n2o(NULL), cc(NULL), firstDate(0.0),
+      lastTableDate(-1.0), lastDate(0.0), stale(true) {
+  for (auto c : components) {
+    if (!oh) {
+      oh = dynamic_cast<OHComponent *>(c);
+    }
+    if (!ch4) {
+      ch4 = dynamic_cast<CH4Component *>(c);
+    }
+    if (!n2o) {
+      n2o = dynamic_cast<N2OComponent *>(c);
+    }
+    if (!cc) {
+      cc = dynamic_cast<SimpleNbox *>(c);
+    }
+  }
+  if (hasMethane()) {
+    oh->engine = this;
+    ch4->engine = this;
+  } else {
+    oh = NULL;
+    ch4 = NULL;
+  }
+  if (n2o) {
+    n2o->engine = this;
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Advance the attached components by one year.
+ *  \details Called by the core at the start of each year, before any
+ *           component runs.
+ */
+void AtmosphericChemistryEngine::run(const double runToDate) {
+  if (stale || runToDate < firstDate) {
+    load(runToDate);
+  } else if (runToDate > lastTableDate) {
+    extend(runToDate);
+  }
+  H_ASSERT(!core->inSpinup() && runToDate - lastDate == 1,
+           "timestep must equal 1");
+
+  const size_t y = static_cast<size_t>(runToDate - firstDate);
+  if (hasMethane()) {
+    runMethane(runToDate, y);
+  }
+  if (n2o) {
+    runN2O(runToDate, y);
+  }
+  lastDate = runToDate;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief OH lifetime, then CH4.
+ *  \details The equations are the components' own (OHComponent::lifetime()
+ *           and CH4Component::step()); only the inputs come from the tables.
+ */
+void AtmosphericChemistryEngine::runMethane(const double runToDate,
+                                            const size_t y) {
+  // OH lifetime, from last year's CH4; see OHComponent::run()
+  const double current_nox = tableInput(E_NOX, y, oh->NOX_emissions, runToDate);
+  const double current_co = tableInput(E_CO, y, oh->CO_emissions, runToDate);
+  const double current_nmvoc =
+      tableInput(E_NMVOC, y, oh->NMVOC_emissions, runToDate);
+  const double previous_ch4 = ch4Conc;
+  const double current_toh =
+      oh->lifetime(previous_ch4, current_nox - NOX0, current_co - CO0,
+                   current_nmvoc - NMVOC0);
+  oh->TAU_OH.set(runToDate, unitval(current_toh, U_YRS));
+  oh->oldDate = runToDate;
+
+  // CH4; see CH4Component::run()
+  if (!std::isnan(CH4_constrain[y])) {
+    ch4Conc = CH4_constrain[y];
+  } else {
+    const double current_ch4em =
+        tableInput(E_CH4, y, ch4->CH4_emissions, runToDate);
+    double rh_ch4;
+    if (cc) {
+      rh_ch4 = 0.0;
+      for (auto &rh : cc->RH_ch4) {
+        rh_ch4 = rh_ch4 + rh.second.value(U_PGC_YR);
+      }
+    } else {
+      rh_ch4 = core->sendMessage(M_GETDATA, D_RH_CH4).value(U_PGC_YR);
+    }
+    const double ch4n = tableInput(E_CH4N, y, ch4->CH4N, runToDate);
+    ch4Conc =
+        ch4->step(previous_ch4, current_toh, current_ch4em, rh_ch4, ch4n);
+  }
+  ch4->CH4.set(runToDate, unitval(ch4Conc, U_PPBV_CH4));
+  ch4->oldDate = runToDate;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief N2O.
+ *  \details The equations are the component's own (N2OComponent::lifetime()
+ *           and N2OComponent::step()); only the inputs come from the tables.
+ */
+void AtmosphericChemistryEngine::runN2O(const double runToDate,
+                                        const size_t y) {
+  if (!std::isnan(N2O_constrain[y])) {
+    n2oConc = N2O_constrain[y];
+  } else {
+    const double previous_n2o = n2oConc;
+    const double tau = n2o->lifetime(previous_n2o);
+    n2o->TAU_N2O.set(runToDate, unitval(tau, U_YRS));
+    const double current_n2oem =
+        tableInput(E_N2O, y, n2o->N2O_emissions, runToDate) +
+        tableInput(E_N2ON, y, n2o->N2O_natural_emissions, runToDate);
+    n2oConc = n2o->step(previous_n2o, tau, current_n2oem);
+  }
+  n2o->N2O.set(runToDate, unitval(n2oConc, U_PPBV_N2O));
+  n2o->oldDate = runToDate;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Read the state from the components, and tabulate their inputs from
+ *         runToDate through the end of the run.
+ */
+void AtmosphericChemistryEngine::load(const double runToDate) {
+  firstDate = runToDate;
+  lastDate = runToDate - 1;
+
+  if (hasMethane()) {
+    H_ASSERT(oh->oldDate == ch4->oldDate,
+             "OH and CH4 are not at the same date");
+    lastDate = ch4->oldDate;
+    NOX0 = oh->NOX_emissions.get(oh->NOX_emissions.firstdate()).value(U_TG_N);
+    CO0 = oh->CO_emissions.get(oh->CO_emissions.firstdate()).value(U_TG_CO);
+    NMVOC0 = oh->NMVOC_emissions.get(oh->NMVOC_emissions.firstdate())
+                 .value(U_TG_NMVOC);
+    ch4Conc = ch4->CH4.get(ch4->oldDate);
+  }
+
+  if (n2o) {
+    H_ASSERT(!hasMethane() || n2o->oldDate == lastDate,
+             "N2O and CH4 are not at the same date");
+    lastDate = n2o->oldDate;
+    n2oConc = n2o->N2O.get(n2o->oldDate);
+  }
+
+  for (auto table : {&E_NOX, &E_CO, &E_NMVOC, &E_CH4, &E_CH4N, &CH4_constrain,
+                     &E_N2O, &E_N2ON, &N2O_constrain}) {
+    table->clear();
+  }
+  lastTableDate = firstDate - 1;
+  extend(max(runToDate, core->getEndDate()));
+  stale = false;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Add rows to the tables through newLastDate.
+ *  \details Rows already tabulated are kept, so running past the end date
+ *           costs one row per year.
+ */
+void AtmosphericChemistryEngine::extend(const double newLastDate) {
+  if (hasMethane()) {
+    tabulate(oh->NOX_emissions, U_TG_N, firstDate, newLastDate, E_NOX);
+    tabulate(oh->CO_emissions, U_TG_CO, firstDate, newLastDate, E_CO);
+    tabulate(oh->NMVOC_emissions, U_TG_NMVOC, firstDate, newLastDate,
+             E_NMVOC);
+    tabulate(ch4->CH4_emissions, U_TG_CH4, firstDate, newLastDate, E_CH4);
+    tabulate(ch4->CH4N, U_TG_CH4, firstDate, newLastDate, E_CH4N);
+    tabulateConstraint(ch4->CH4_constrain, U_PPBV_CH4, firstDate, newLastDate,
+                       CH4_constrain);
+  }
+  if (n2o) {
+    tabulate(n2o->N2O_emissions, U_TG_N, firstDate, newLastDate, E_N2O);
+    tabulate(n2o->N2O_natural_emissions, U_TG_N, firstDate, newLastDate,
+             E_N2ON);
+    tabulateConstraint(n2o->N2O_constrain, U_PPBV_N2O, firstDate,
+                       newLastDate, N2O_constrain);
+  }
+  lastTableDate = newLastDate;
+}
+
+} // namespace Hector
@@ -45,9 +45,7 @@ string BlackCarbonComponent::getComponentName() const {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void BlackCarbonComponent::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
   core = coreptr;
 
@@ -106,8 +104,8 @@ void BlackCarbonComponent::prepareToRun() {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void BlackCarbonComponent::run(const double runToDate) {
-  H_ASSERT(!core->inSpinup() && runToDate - oldDate == 1,
-           "timestep must equal 1");
+  H_CHECK(!core->inSpinup() && runToDate - oldDate == 1,
+          "timestep must equal 1");
   oldDate = runToDate;
 }
 
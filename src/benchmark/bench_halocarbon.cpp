@@ -0,0 +1,52 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  bench_halocarbon.cpp
+ *  hector
+ *
+ *  Cost of the halocarbons, run as separate components and by the engine.
+ *
+ */
+
+#include "benchmark.hpp"
+#include "component_data.hpp"
+#include "core.hpp"
+#include "halocarbon_component.hpp"
+#include "ini_to_core_reader.hpp"
+
+using namespace Hector;
+using namespace Hector::benchmark;
+
+namespace {
+//------------------------------------------------------------------------------
+/*! \brief Time a full run of the default scenario, from the start date.
+ *  \param engine Whether to run the halocarbons in the halocarbon engine.
+ */
+double timeRun(const bool engine) {
+  Core core(Logger::WARNING, false, false);
+  core.init();
+  INIToCoreReader reader(&core);
+  reader.parse("inst/input/hector_ssp245.ini");
+  core.setData(CORE_COMPONENT_NAME, D_HALOCARBON_ENGINE,
+               message_data(unitval(engine, U_UNDEFINED)));
+  core.prepareToRun();
+
+  const double ns = timePerCall(
+      [&] {
+        core.reset(core.getStartDate());
+        core.run();
+      },
+      2.0);
+  core.shutDown();
+  return ns;
+}
+} // namespace
+
+HECTOR_BENCHMARK(halocarbons) {
+  report("full run, separate halocarbon components", timeRun(false));
+  report("full run, halocarbon engine", timeRun(true));
+}
@@ -0,0 +1,52 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  bench_land.cpp
+ *  hector
+ *
+ *  Cost of the carbon cycle derivatives, which the solver evaluates several
+ *  times per timestep.
+ *
+ */
+
+#include <cstdio>
+
+#include "benchmark.hpp"
+#include "component_data.hpp"
+#include "core.hpp"
+#include "ini_to_core_reader.hpp"
+#include "simpleNbox.hpp"
+
+using namespace Hector;
+using namespace Hector::benchmark;
+
+HECTOR_BENCHMARK(carbon_calcderivs) {
+  Core core(Logger::WARNING, false, true);
+  core.init();
+  INIToCoreReader reader(&core);
+  reader.parse("inst/input/hector_ssp245.ini");
+  core.prepareToRun();
+  core.run(2000);
+
+  SimpleNbox *snbox = dynamic_cast<SimpleNbox *>(
+      core.getComponentByName(SIMPLENBOX_COMPONENT_NAME));
+  double c[SNBOX_EARTH + 1] = {0.0};
+  double dcdt[SNBOX_EARTH + 1] = {0.0};
+  snbox->getCValues(2000.0, c);
+
+  double sink = 0.0;
+  report("SimpleNbox::calcderivs", timePerCall([&] {
+           snbox->calcderivs(2000.5, c, dcdt);
+           sink += dcdt[SNBOX_ATMOS];
+         }));
+  core.shutDown();
+
+  // Keep the compiler from discarding the work
+  if (sink == -1.0) {
+    printf("%f\n", sink);
+  }
+}
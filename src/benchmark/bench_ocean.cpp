@@ -0,0 +1,60 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  bench_ocean.cpp
+ *  hector
+ *
+ *  Cost of one ocean carbon cycle step.
+ *
+ */
+
+#include "benchmark.hpp"
+#include "component_data.hpp"
+#include "core.hpp"
+#include "ini_to_core_reader.hpp"
+#include "ocean_component.hpp"
+#include "simpleNbox.hpp"
+
+using namespace Hector;
+using namespace Hector::benchmark;
+
+namespace {
+//------------------------------------------------------------------------------
+/*! \brief Time the step the carbon cycle solver makes the ocean take after
+ *         each accepted timestep: circulation, chemistry, and box updates.
+ *  \param level Log level of the core; diagnostics below it are skipped.
+ */
+double timeOceanStep(const Logger::LogLevel level) {
+  Core core(level, false, true);
+  core.init();
+  INIToCoreReader reader(&core);
+  reader.parse("inst/input/hector_ssp245.ini");
+  core.prepareToRun();
+  core.run(2000);
+
+  OceanComponent *ocean = dynamic_cast<OceanComponent *>(
+      core.getComponentByName(OCEAN_COMPONENT_NAME));
+  double c[SNBOX_EARTH + 1] = {0.0};
+  c[SNBOX_ATMOS] = 780.0; // ~370 ppm
+  double t = 2000.0;
+
+  const double ns = timePerCall([&] {
+    ocean->getCValues(t, c);
+    t += 1.0;
+    ocean->stashCValues(t, c);
+  });
+  core.shutDown();
+  return ns;
+}
+} // namespace
+
+HECTOR_BENCHMARK(ocean_step) {
+  report("ocean step, diagnostics disabled (WARNING)",
+         timeOceanStep(Logger::WARNING));
+  report("ocean step, diagnostics enabled (DEBUG)",
+         timeOceanStep(Logger::DEBUG));
+}
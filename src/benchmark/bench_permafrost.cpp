@@ -0,0 +1,65 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  bench_permafrost.cpp
+ *  hector
+ *
+ *  Cost of the permafrost thaw CDF, tabulated and exact.
+ *
+ */
+
+#include <cstdio>
+#include <vector>
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Weverything"
+#include <boost/math/distributions/lognormal.hpp>
+#pragma clang diagnostic pop
+
+#include "benchmark.hpp"
+#include "lognormal_cdf_table.hpp"
+
+using namespace Hector;
+using namespace Hector::benchmark;
+
+HECTOR_BENCHMARK(permafrost_cdf) {
+  // Default permafrost parameters; temperatures spanning historical and
+  // high-emission future land warming
+  const double mu = 1.67, sigma = 0.986;
+  std::vector<double> temps;
+  for (double t = 0.01; t < 12.0; t += 0.0123) {
+    temps.push_back(t);
+  }
+
+  const boost::math::lognormal dist(mu, sigma);
+  double sink = 0.0;
+  std::size_t i = 0;
+  report("boost::math::cdf(lognormal)", timePerCall([&] {
+           sink += boost::math::cdf(dist, temps[i]);
+           i = (i + 1) % temps.size();
+         }));
+
+  std::size_t nbuilt = 0;
+  const double build = timePerCall(
+      [&] {
+        // a new table each time
+        LognormalCDFTable::get(mu, sigma + 1e-9 * (++nbuilt));
+      },
+      0.2);
+  report("LognormalCDFTable build", build);
+
+  auto table = LognormalCDFTable::get(mu, sigma);
+  report("LognormalCDFTable::cdf", timePerCall([&] {
+           sink += table->cdf(temps[i]);
+           i = (i + 1) % temps.size();
+         }));
+
+  // Keep the compiler from discarding the work
+  if (sink == -1.0) {
+    printf("%f\n", sink);
+  }
+}
@@ -0,0 +1,70 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+/*
+ *  benchmark.hpp
+ *  hector
+ *
+ *  A minimal timing harness for Hector's micro-benchmarks.
+ *
+ */
+
+#include <chrono>
+#include <string>
+
+namespace Hector {
+namespace benchmark {
+
+//------------------------------------------------------------------------------
+/*! \brief Time a piece of code.
+ *  \param body Called repeatedly (in batches) until at least minSeconds have
+ *              passed.
+ *  \return Mean time per call, in nanoseconds.
+ */
+template <class Body> double timePerCall(Body body, double minSeconds = 0.5) {
+  using clock = std::chrono::steady_clock;
+  long calls = 0;
+  long batch = 1;
+  const clock::time_point start = clock::now();
+  double elapsed = 0.0;
+  while (elapsed < minSeconds) {
+    for (long i = 0; i < batch; ++i) {
+      body();
+    }
+    calls += batch;
+    batch *= 2;
+    elapsed = std::chrono::duration<double>(clock::now() - start).count();
+  }
+  return elapsed * 1e9 / calls;
+}
+
+void report(const std::string &name, double nsPerCall);
+
+//! A registered benchmark.
+typedef void (*BenchmarkFunction)();
+
+//! Registers a benchmark when constructed (see HECTOR_BENCHMARK).
+struct Registrar {
+  Registrar(const char *name, BenchmarkFunction function);
+};
+
+} // namespace benchmark
+} // namespace Hector
+
+//------------------------------------------------------------------------------
+/*! \brief Define a benchmark, which is run by hector-benchmarks.
+ *
+ *  The body should time whatever it measures with timePerCall() and print the
+ *  results with report().
+ */
+#define HECTOR_BENCHMARK(name)                                                 \
+  static void name();                                                          \
+  static Hector::benchmark::Registrar name##_registrar(#name, name);           \
+  static void name()
+
+#endif // BENCHMARK_HPP
@@ -0,0 +1,73 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  benchmark_main.cpp
+ *  hector
+ *
+ *  Runs the registered benchmarks.  With arguments, only those whose names
+ *  contain one of the arguments are run.  Run from the top level of the
+ *  repository, since some benchmarks read the default input files.
+ *
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "h_exception.hpp"
+
+using namespace std;
+
+namespace Hector {
+namespace benchmark {
+
+namespace {
+vector<pair<string, BenchmarkFunction>> &registry() {
+  static vector<pair<string, BenchmarkFunction>> benchmarks;
+  return benchmarks;
+}
+} // namespace
+
+Registrar::Registrar(const char *name, BenchmarkFunction function) {
+  registry().push_back(make_pair(string(name), function));
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Print one timing result.
+ */
+void report(const string &name, const double nsPerCall) {
+  printf("%-50s %12.1f ns\n", name.c_str(), nsPerCall);
+}
+
+} // namespace benchmark
+} // namespace Hector
+
+int main(int argc, char **argv) {
+  using namespace Hector::benchmark;
+
+  try {
+    for (const auto &b : registry()) {
+      bool selected = (argc < 2);
+      for (int i = 1; i < argc; ++i) {
+        selected = selected || b.first.find(argv[i]) != string::npos;
+      }
+      if (selected) {
+        cout << "--- " << b.first << endl;
+        b.second();
+      }
+    }
+  } catch (const h_exception &e) {
+    cerr << "* Program exception:\n" << e << endl;
+    return 1;
+  } catch (std::exception &e) {
+    cerr << "Standard exception: " << e.what() << endl;
+    return 2;
+  }
+  return 0;
+}
@@ -45,8 +45,7 @@ void CarbonCycleSolver::init(Core *coreptr) {
   // This component is very verbose at the debug and notice levels, so limit
   // output to the warning level, even if the rest of the model is configured
   // for something lower.
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(), Logger::WARNING);
+  logger.open(getComponentName(), coreptr->getGlobalLogger(), Logger::WARNING);
   H_LOG(logger, Logger::DEBUG)
       << getComponentName() << " initialized." << std::endl;
 
@@ -13,6 +13,7 @@
  */
 
 #include "ch4_component.hpp"
+#include "atmospheric_chemistry_engine.hpp"
 #include "avisitor.hpp"
 #include "core.hpp"
 #include "h_util.hpp"
@@ -25,7 +26,7 @@ using namespace std;
 //------------------------------------------------------------------------------
 /*! \brief Constructor
  */
-CH4Component::CH4Component() {
+CH4Component::CH4Component() : engine(NULL) {
   CH4_emissions.allowInterp(true);
   CH4_emissions.name = CH4_COMPONENT_NAME;
   CH4N.allowInterp(true);
@@ -50,9 +51,7 @@ string CH4Component::getComponentName() const {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CH4Component::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
   core = coreptr;
 
@@ -94,6 +93,10 @@ unitval CH4Component::sendMessage(const std::string &message,
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CH4Component::setData(const string &varName, const message_data &data) {
+  if (engine) {
+    engine->invalidate();
+  }
+
   try {
     if (varName == D_PREINDUSTRIAL_CH4) {
       H_ASSERT(data.date == Core::undefinedIndex(), "date not allowed");
@@ -145,20 +148,28 @@ void CH4Component::prepareToRun() {
     M0 = CH4_constrain.get(oldDate);
   }
   CH4.set(oldDate, M0); // set the first year's value
+  aheadDate = oldDate;
+  if (engine) {
+    engine->invalidate();
+  }
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CH4Component::run(const double runToDate) {
-  H_ASSERT(!core->inSpinup() && runToDate - oldDate == 1,
-           "timestep must equal 1");
+  if (engine) {
+    // The core has already run the engine for this year
+    H_ASSERT(oldDate == runToDate, "chemistry engine has not been run");
+    return;
+  }
+  H_CHECK(!core->inSpinup() && runToDate - oldDate == 1,
+          "timestep must equal 1");
 
-  if (CH4_constrain.size() && CH4_constrain.exists(runToDate)) {
+  if (runToDate <= aheadDate) {
+    // Already set by runAhead()
+  } else if (CH4_constrain.size() && CH4_constrain.exists(runToDate)) {
     CH4.set(runToDate, CH4_constrain.get(runToDate));
   } else {
-
-    // modified from Wigley et al, 2002
-    // https://doi.org/10.1175/1520-0442(2002)015%3C2690:RFDTRG%3E2.0.CO;2
     const double current_ch4em = CH4_emissions.get(runToDate).value(U_TG_CH4);
     const double current_toh =
         core->sendMessage(M_GETDATA, D_LIFETIME_OH, runToDate).value(U_YRS);
@@ -166,30 +177,22 @@ void CH4Component::run(const double runToDate) {
         << "Year " << runToDate << " current_toh = " << current_toh
         << std::endl;
 
-// Permafrost thaw produces CH4 emissions
-#define PG_C_TO_TG_CH4 (1000.0 * 16.04 / 12.01)
+    // Permafrost thaw produces CH4 emissions
     const double rh_ch4 =
-        core->sendMessage(M_GETDATA, D_RH_CH4).value(U_PGC_YR) * PG_C_TO_TG_CH4;
+        core->sendMessage(M_GETDATA, D_RH_CH4).value(U_PGC_YR);
 
     // Additional, background CH4 natural emissions
     const double ch4n = CH4N.get(runToDate).value(U_TG_CH4);
-    const double emisTocon =
-        (current_ch4em + rh_ch4 + ch4n) / UC_CH4.value(U_TG_PPBV);
     const double previous_ch4 = CH4.get(oldDate);
 
     H_LOG(logger, Logger::DEBUG)
         << "Year " << runToDate << " previous CH4 = " << previous_ch4
         << std::endl;
 
-    const double soil_sink = previous_ch4 / Tsoil.value(U_YRS);
-    const double strat_sink = previous_ch4 / Tstrat.value(U_YRS);
-    const double oh_sink = previous_ch4 / current_toh;
-
-    const double dCH4 =
-        emisTocon - soil_sink - strat_sink -
-        oh_sink; // change in CH4 concentration to be added to previous_ch4
-
-    CH4.set(runToDate, unitval(previous_ch4 + dCH4, U_PPBV_CH4));
+    CH4.set(runToDate,
+            unitval(step(previous_ch4, current_toh, current_ch4em, rh_ch4,
+                         ch4n),
+                    U_PPBV_CH4));
   }
 
   oldDate = runToDate;
@@ -198,6 +201,58 @@ void CH4Component::run(const double runToDate) {
       << std::endl;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief This year's CH4 concentration, from last year's and the sinks and
+ *         sources.
+ *  \param previous_ch4 Last year's CH4 concentration, ppbv CH4.
+ *  \param toh          This year's OH lifetime, years.
+ *  \param emissions    Anthropogenic emissions, Tg CH4.
+ *  \param rh_ch4       CH4 from heterotrophic respiration, Pg C/yr.
+ *  \param natural      Natural emissions, Tg CH4.
+ *  \returns CH4 concentration, ppbv CH4.
+ *  \details Used by run() and by the chemistry engine.
+ */
+double CH4Component::step(const double previous_ch4, const double toh,
+                          const double emissions, const double rh_ch4,
+                          const double natural) const {
+  // modified from Wigley et al, 2002
+  // https://doi.org/10.1175/1520-0442(2002)015%3C2690:RFDTRG%3E2.0.CO;2
+  const double emisTocon = (emissions + rh_ch4 * PG_C_TO_TG_CH4 + natural) /
+                           UC_CH4.value(U_TG_PPBV);
+
+  const double soil_sink = previous_ch4 / Tsoil.value(U_YRS);
+  const double strat_sink = previous_ch4 / Tstrat.value(U_YRS);
+  const double oh_sink = previous_ch4 / toh;
+
+  const double dCH4 =
+      emisTocon - soil_sink - strat_sink -
+      oh_sink; // change in CH4 concentration to be added to previous_ch4
+
+  return previous_ch4 + dCH4;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief If CH4 is constrained for every year from firstDate to lastDate,
+ *         set all of those concentrations now.
+ *  \details With the chemistry engine, the engine does this instead.
+ */
+bool CH4Component::runAhead(const double firstDate, const double lastDate) {
+  aheadDate = firstDate - 1;
+  if (engine || !CH4_constrain.size()) {
+    return false;
+  }
+  for (double date = firstDate; date <= lastDate; date += 1.0) {
+    if (!CH4_constrain.exists(date)) {
+      return false;
+    }
+  }
+  for (double date = firstDate; date <= lastDate; date += 1.0) {
+    CH4.set(date, CH4_constrain.get(date));
+  }
+  aheadDate = lastDate;
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // documentation is inherited
 unitval CH4Component::getData(const std::string &varName, const double date) {
@@ -251,7 +306,11 @@ void CH4Component::reset(double time) {
   // reset the internal time counter and truncate concentration time
   // series
   oldDate = time;
+  aheadDate = time;
   CH4.truncate(time);
+  if (engine) {
+    engine->invalidate();
+  }
   H_LOG(logger, Logger::NOTICE)
       << getComponentName() << " reset to time= " << time << "\n";
 }
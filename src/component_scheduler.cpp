@@ -0,0 +1,339 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  component_scheduler.cpp
+ *  hector
+ *
+ *  Run independent model components concurrently within a year.
+ *
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include "component_scheduler.hpp"
+#include "h_exception.hpp"
+#include "imodel_component.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+namespace {
+//! The scheduler and component running on this thread, if any; used to
+//! identify who sent a message.
+thread_local const ComponentScheduler *runningScheduler = NULL;
+thread_local size_t runningComponent = 0;
+
+//! Thrown by noteMessage to stop a component whose message the levels don't
+//! allow for.  Not an h_exception, so components can't catch it by mistake.
+struct StaleLevels {};
+} // namespace
+
+//------------------------------------------------------------------------------
+/*! \brief Constructor
+ *  \param components   The core's components, in dependency order.
+ *  \param dependencies dependencies[i][j] is true if component j depends on
+ *                      component i (so i < j).
+ *  \param nthreads     Number of threads to use, including the calling thread.
+ *  \param glog         The core's log.
+ */
+ComponentScheduler::ComponentScheduler(
+    const vector<IModelComponent *> &components,
+    const vector<vector<bool>> &dependencies, const int nthreads,
+    Logger &glog)
+    : components(components), dependencies(dependencies), stale(false),
+      glog(glog), generation(0), stopping(false), currentLevel(NULL),
+      currentDate(0.0), next(0), pending(0), busyWorkers(0) {
+  const size_t n = components.size();
+  messaged.assign(n, vector<char>(n, 0));
+  for (size_t i = 0; i < n; ++i) {
+    componentIndex[components[i]] = i;
+  }
+  errors.resize(n);
+
+  for (int t = 1; t < nthreads; ++t) {
+    pool.push_back(thread(&ComponentScheduler::workerLoop, this));
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Destructor; stops the thread pool.
+ */
+ComponentScheduler::~ComponentScheduler() {
+  {
+    lock_guard<mutex> lock(poolMutex);
+    stopping = true;
+  }
+  workReady.notify_all();
+  for (auto &t : pool) {
+    t.join();
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Run all components for one year.
+ *  \details The first call runs the components sequentially while recording
+ *           the messages they exchange, then builds the levels used by later
+ *           calls.
+ *  \returns False if a component sent a message that the levels don't allow
+ *           for.  The year's results are then incomplete: the caller must
+ *           reset the components to the previous year and call run() again,
+ *           which runs the year sequentially and rebuilds the levels.
+ */
+bool ComponentScheduler::run(const double date) {
+  if (levels.empty()) {
+    for (size_t i = 0; i < components.size(); ++i) {
+      runningScheduler = this;
+      runningComponent = i;
+      try {
+        components[i]->run(date);
+      } catch (...) {
+        runningScheduler = NULL;
+        throw;
+      }
+      runningScheduler = NULL;
+    }
+    buildLevels();
+  } else {
+    for (const auto &level : levels) {
+      runLevel(level, date);
+      if (stale) {
+        H_LOG(glog, Logger::NOTICE)
+            << staleNote << " after the first year of the run; rerunning "
+            << date << " sequentially to rebuild the component levels" << endl;
+        stale = false;
+        levels.clear();
+        levelOf.clear();
+        fill(errors.begin(), errors.end(), exception_ptr());
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Record or check a message sent to a component.
+ *  \details Called by the core for every message routed to a component,
+ *           before it is delivered.  Messages not sent from a component being
+ *           run by this scheduler (e.g. from visitors or R) are ignored.
+ *
+ *           After the first year, a new message from a component to one that
+ *           it might run concurrently with, or out of its original order
+ *           with, isn't delivered: the sending component is stopped, and
+ *           run() reports that the year must be rerun.
+ */
+void ComponentScheduler::noteMessage(const IModelComponent *target) {
+  if (runningScheduler != this) {
+    return;
+  }
+  auto it = componentIndex.find(target);
+  if (it == componentIndex.end() || it->second == runningComponent) {
+    return;
+  }
+  const size_t from = runningComponent;
+  const size_t to = it->second;
+  if (messaged[from][to]) {
+    return;
+  }
+
+  // Only this component's thread writes its row, so no locking is needed
+  messaged[from][to] = 1;
+  if (!levels.empty()) {
+    bool ok = apart(from, to);
+    for (size_t d = 0; ok && d < components.size(); ++d) {
+      if (dependencies[to][d] && d != from) {
+        ok = apart(from, d);
+      }
+    }
+    if (!ok) {
+      {
+        lock_guard<mutex> lock(poolMutex);
+        if (!stale) {
+          staleNote = components[from]->getComponentName() + " sent data to " +
+                      components[to]->getComponentName();
+        }
+        stale = true;
+      }
+      throw StaleLevels();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Check whether two components run in different levels, in their
+ *         original order.
+ */
+bool ComponentScheduler::apart(const size_t a, const size_t b) const {
+  const bool inOrder = (a < b) == (levelOf[a] < levelOf[b]);
+  return levelOf[a] != levelOf[b] && inOrder;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Group the components into levels.
+ *  \details Each component goes in the level after the latest level holding
+ *           a component it is linked to that comes before it in the run
+ *           order.
+ *
+ *           A component may act directly on the state of a component it
+ *           depends on, rather than through messages (e.g. the carbon cycle
+ *           solver integrates simpleNbox), so a component that exchanges
+ *           messages with another is also linked to that one's dependents.
+ *           A declared dependency counts as an exchange even if the first
+ *           year didn't use it, since components may only start asking for
+ *           some data later (e.g. forcing only asks simpleNbox for albedo
+ *           forcing from the forcing base year on).
+ */
+void ComponentScheduler::buildLevels() {
+  const size_t n = components.size();
+  linked = messaged;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      if (dependencies[i][j]) {
+        linked[i][j] = linked[j][i] = 1;
+      }
+    }
+  }
+  for (size_t c = 0; c < n; ++c) {
+    for (size_t p = 0; p < n; ++p) {
+      if (messaged[c][p] || messaged[p][c] || dependencies[p][c]) {
+        for (size_t d = 0; d < n; ++d) {
+          if (dependencies[p][d] && d != c) {
+            linked[c][d] = linked[d][c] = 1;
+          }
+        }
+      }
+    }
+  }
+
+  levelOf.assign(n, 0);
+  levels.clear();
+  for (size_t j = 0; j < n; ++j) {
+    for (size_t i = 0; i < j; ++i) {
+      if (linked[i][j] || linked[j][i]) {
+        levelOf[j] = max(levelOf[j], levelOf[i] + 1);
+      }
+    }
+    if (levelOf[j] >= levels.size()) {
+      levels.resize(levelOf[j] + 1);
+    }
+    levels[levelOf[j]].push_back(j);
+  }
+
+  H_LOG(glog, Logger::NOTICE)
+      << "Running " << n << " components in " << levels.size()
+      << " levels on " << pool.size() + 1 << " threads" << endl;
+  for (size_t l = 0; l < levels.size(); ++l) {
+    ostringstream names;
+    for (size_t i : levels[l]) {
+      names << " " << components[i]->getComponentName();
+    }
+    H_LOG(glog, Logger::DEBUG) << "Level " << l << ":" << names.str() << endl;
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Run the components of one level concurrently.
+ *  \exception If any component throws, the exception from the first such
+ *             component in run order is rethrown once the level is finished.
+ */
+void ComponentScheduler::runLevel(const vector<size_t> &level,
+                                  const double date) {
+  if (level.size() == 1 || pool.empty()) {
+    for (size_t i : level) {
+      runComponent(i, date);
+    }
+  } else {
+    {
+      lock_guard<mutex> lock(poolMutex);
+      currentLevel = &level;
+      currentDate = date;
+      next = 0;
+      pending = level.size();
+      ++generation;
+    }
+    workReady.notify_all();
+
+    // The calling thread helps out, then waits for any stragglers
+    work(level, date);
+    unique_lock<mutex> lock(poolMutex);
+    workDone.wait(lock, [this] { return pending == 0 && busyWorkers == 0; });
+  }
+
+  // A stale level's errors may just be fallout; the rerun will tell
+  if (stale) {
+    return;
+  }
+  for (size_t i : level) {
+    if (errors[i]) {
+      exception_ptr e = errors[i];
+      fill(errors.begin(), errors.end(), exception_ptr());
+      rethrow_exception(e);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Run one component, catching any exception for runLevel.
+ */
+void ComponentScheduler::runComponent(const size_t idx, const double date) {
+  runningScheduler = this;
+  runningComponent = idx;
+  try {
+    components[idx]->run(date);
+  } catch (const StaleLevels &) {
+    // Noted in stale; the year will be rerun
+  } catch (...) {
+    errors[idx] = current_exception();
+  }
+  runningScheduler = NULL;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Claim and run components from a level until none are left.
+ */
+void ComponentScheduler::work(const vector<size_t> &level, const double date) {
+  for (size_t i = next++; i < level.size(); i = next++) {
+    runComponent(level[i], date);
+    lock_guard<mutex> lock(poolMutex);
+    if (--pending == 0) {
+      workDone.notify_all();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Main loop of a pool thread.
+ */
+void ComponentScheduler::workerLoop() {
+  unsigned long seen = 0;
+  for (;;) {
+    const vector<size_t> *level;
+    double date;
+    {
+      unique_lock<mutex> lock(poolMutex);
+      workReady.wait(lock, [&] { return stopping || generation != seen; });
+      if (stopping) {
+        return;
+      }
+      seen = generation;
+      level = currentLevel;
+      date = currentDate;
+      ++busyWorkers;
+    }
+
+    work(*level, date);
+
+    lock_guard<mutex> lock(poolMutex);
+    if (--busyWorkers == 0 && pending == 0) {
+      workDone.notify_all();
+    }
+  }
+}
+
+} // namespace Hector
@@ -13,6 +13,7 @@
  */
 
 #include <fstream>
+#include <limits>
 // some boost headers generate warnings under clang; not our problem, ignore
 // 2023 and Boost 1.81.0_1: string.hpp still generates two warnings
 #pragma clang diagnostic push
@@ -20,16 +21,19 @@
 #include "boost/algorithm/string.hpp"
 #pragma clang diagnostic pop
 
+#include "atmospheric_chemistry_engine.hpp"
 #include "avisitor.hpp"
 #include "bc_component.hpp"
 #include "carbon-cycle-solver.hpp"
 #include "ch4_component.hpp"
+#include "component_scheduler.hpp"
 #include "core.hpp"
 #include "csv_tracking_visitor.hpp"
 #include "dependency_finder.hpp"
 #include "forcing_component.hpp"
 #include "h_util.hpp"
 #include "halocarbon_component.hpp"
+#include "halocarbon_engine.hpp"
 #include "imodel_component.hpp"
 #include "logger.hpp"
 #include "n2o_component.hpp"
@@ -38,6 +42,8 @@
 #include "oc_component.hpp"
 #include "ocean_component.hpp"
 #include "oh_component.hpp"
+#include "scenario.hpp"
+#include "short_lived_forcer_engine.hpp"
 #include "simpleNbox.hpp"
 #include "slr_component.hpp"
 #include "so2_component.hpp"
@@ -53,13 +59,23 @@ using namespace std;
  *  Perform only minimal initialization.  More involved initializations should
  *  go in init.
  *
+ *  The core and all of its components log to a single file,
+ *  logs/hector.log; if another core in the same process already has that
+ *  file open, the name gets a numeric suffix.
+ *
+ *  \param logrecords Number of recent log records to keep in memory (see
+ *                    Logger::getRecentRecords()), in addition to or instead
+ *                    of writing them to the screen or file.
  *  \sa init()
  */
-Core::Core(Logger::LogLevel loglvl, bool echotoscreen, bool echotofile)
+Core::Core(Logger::LogLevel loglvl, bool echotoscreen, bool echotofile,
+           std::size_t logrecords)
     : setup_complete(false), run_name(""), startDate(-1.0), endDate(-1.0),
       lastDate(-1.0), trackingDate(9999), isInited(false), do_spinup(true),
-      max_spinup(2000), in_spinup(false) {
-  glog.open(string(MODEL_NAME), echotoscreen, echotofile, loglvl);
+      max_spinup(2000), component_threads(1), use_halocarbon_engine(false),
+      use_chemistry_engine(false), use_short_lived_engine(false),
+      settingsLog(NULL), in_spinup(false) {
+  glog.open(string(MODEL_NAME), echotoscreen, echotofile, loglvl, logrecords);
 }
 
 //------------------------------------------------------------------------------
@@ -218,6 +234,9 @@ std::string Core::getTrackingData() const {
  */
 void Core::setData(const string &componentName, const string &varName,
                    const message_data &data) {
+  if (settingsLog) {
+    settingsLog->push_back(ScenarioSetting(componentName, varName, data));
+  }
   if (componentName == getComponentName()) {
     try {
       if (varName == D_RUN_NAME) {
@@ -238,6 +257,27 @@ void Core::setData(const string &componentName, const string &varName,
       } else if (varName == D_MAX_SPINUP) {
         H_ASSERT(data.date == undefinedIndex(), "date not allowed");
         max_spinup = data.getUnitval(U_UNDEFINED);
+      } else if (varName == D_COMPONENT_THREADS) {
+        H_ASSERT(data.date == undefinedIndex(), "date not allowed");
+        H_ASSERT(!setup_complete,
+                 "component_threads must be set before the model is set up");
+        component_threads = data.getUnitval(U_UNDEFINED);
+        H_ASSERT(component_threads >= 1, "component_threads must be >= 1");
+      } else if (varName == D_HALOCARBON_ENGINE) {
+        H_ASSERT(data.date == undefinedIndex(), "date not allowed");
+        H_ASSERT(!setup_complete,
+                 "halocarbon_engine must be set before the model is set up");
+        use_halocarbon_engine = (data.getUnitval(U_UNDEFINED) > 0);
+      } else if (varName == D_CHEMISTRY_ENGINE) {
+        H_ASSERT(data.date == undefinedIndex(), "date not allowed");
+        H_ASSERT(!setup_complete,
+                 "chemistry_engine must be set before the model is set up");
+        use_chemistry_engine = (data.getUnitval(U_UNDEFINED) > 0);
+      } else if (varName == D_SHORT_LIVED_ENGINE) {
+        H_ASSERT(data.date == undefinedIndex(), "date not allowed");
+        H_ASSERT(!setup_complete,
+                 "short_lived_engine must be set before the model is set up");
+        use_short_lived_engine = (data.getUnitval(U_UNDEFINED) > 0);
       } else {
         H_THROW("Unknown variable name while parsing " + getComponentName() +
                 ": " + varName);
@@ -245,6 +285,36 @@ void Core::setData(const string &componentName, const string &varName,
     } catch (h_exception &parseException) {
       H_RETHROW(parseException, "Could not parse var: " + varName);
     }
+  } else if (componentName == OUTPUT_SECTION_NAME) {
+    // An output to write: <datum>=all, <datum>=<year>, or
+    // <datum>=<first year>-<last year>, where <datum> can be qualified as
+    // <component>/<datum>
+    try {
+      H_ASSERT(data.date == undefinedIndex(), "date not allowed");
+      const string years = boost::trim_copy(data.value_str);
+      double first = -numeric_limits<double>::infinity();
+      double last = numeric_limits<double>::infinity();
+      if (years != "all") {
+        const size_t dash = years.find('-', 1);
+        const string firstyear = boost::trim_copy(years.substr(0, dash));
+        const string lastyear =
+            dash == string::npos ? firstyear
+                                 : boost::trim_copy(years.substr(dash + 1));
+        size_t firstend = 0, lastend = 0;
+        try {
+          first = stod(firstyear, &firstend);
+          last = stod(lastyear, &lastend);
+        } catch (std::exception &) {
+          firstend = lastend = 0;
+        }
+        H_ASSERT(firstend && firstend == firstyear.size() &&
+                     lastend == lastyear.size(),
+                 "expected all, a year, or a range of years: " + years);
+      }
+      subscribeOutput(varName, first, last);
+    } catch (h_exception &parseException) {
+      H_RETHROW(parseException, "Could not parse output: " + varName);
+    }
   } else { // data is not intended for us
     IModelComponent *component = getComponentByName(componentName);
 
@@ -263,8 +333,154 @@ void Core::setData(const string &componentName, const string &varName,
       }
     } else {
       component->setData(varName, data); // route data
+      if (shortLivedEngine) {
+        shortLivedEngine->invalidate();
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Set data from a scenario, as reading its input file would.
+ *  \sa applyScenario(const Scenario &, const vector<ScenarioSetting> &)
+ */
+void Core::applyScenario(const Scenario &scenario) {
+  applyScenario(scenario, vector<ScenarioSetting>());
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Set data from a scenario, as reading its input file would, then set
+ *         some values of its own.
+ *
+ *  Like reading an input file, this is done after init() and before
+ *  prepareToRun().  Nothing is read or parsed: the scenario's values were
+ *  read and checked when it was created.
+ *
+ *  \param scenario  The scenario to set.
+ *  \param overrides Values to set after the scenario's (e.g. parameters
+ *                   that differ between ensemble members).
+ *  \exception h_exception If the core hasn't been initialized, or an
+ *             override can't be set.
+ */
+void Core::applyScenario(const Scenario &scenario,
+                         const vector<ScenarioSetting> &overrides) {
+  H_ASSERT(isInited, "core must be initialized before applying a scenario");
+  for (const ScenarioSetting &setting : scenario.getSettings()) {
+    setData(setting.componentName, setting.varName, setting.data);
+  }
+  for (const ScenarioSetting &setting : overrides) {
+    setData(setting.componentName, setting.varName, setting.data);
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Ask output visitors to write a variable over a range of years.
+ *
+ *  Once any outputs have been subscribed to, visitors that support it (such as
+ *  CSVOutputStreamVisitor) write only the subscribed outputs, instead of all of
+ *  them.
+ *
+ *  \param datum The variable: a capability (optionally with a biome prefix),
+ *               or `component/variable` for one that isn't a capability.
+ *  \param first The first year to write.
+ *  \param last  The last year to write.
+ *  \exception h_exception If the range is empty, or (once the model is set
+ *             up) if the datum can't be found.
+ */
+void Core::subscribeOutput(const std::string &datum, const double first,
+                           const double last) {
+  H_ASSERT(first <= last, "first year of output is after the last");
+  OutputSubscription sub = {"", datum, first, last, NULL,
+                            OutputSubscription::DATING_UNKNOWN};
+  const size_t slash = datum.find('/');
+  if (slash != std::string::npos) {
+    sub.componentName = datum.substr(0, slash);
+    sub.datum = datum.substr(slash + 1);
+  }
+  if (setup_complete) {
+    resolveOutputSubscription(sub);
+    findOutputDating(sub, lastDate);
+  }
+  outputSubscriptions.push_back(sub);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Fetch a subscribed output.
+ *  \param i    Index of the subscription.
+ *  \param date The date wanted, which must be the current date if the output
+ *              can't be fetched by date.
+ *  \exception h_exception Any error from the component.
+ */
+unitval Core::getOutput(const size_t i, const double date) {
+  H_ASSERT(i < outputSubscriptions.size(), "no such output subscription");
+  OutputSubscription &sub = outputSubscriptions[i];
+  if (sub.dating == OutputSubscription::DATING_UNKNOWN) {
+    findOutputDating(sub, date);
+  }
+  return fetchOutput(sub, date);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Ask a subscribed output's component for it.
+ *  \details Unless it's known to be only kept as its current value, the
+ *           output is asked for by date.
+ */
+unitval Core::fetchOutput(const OutputSubscription &sub, const double date) {
+  const double when =
+      sub.dating == OutputSubscription::UNDATED ? undefinedIndex() : date;
+  return sub.component ? sub.component->sendMessage(M_GETDATA, sub.datum,
+                                                    message_data(when))
+                       : getData(sub.datum, when);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Find the component to ask for a subscribed output.
+ */
+void Core::resolveOutputSubscription(OutputSubscription &sub) {
+  if (!sub.componentName.empty()) {
+    sub.component = getComponentByName(sub.componentName);
+    return;
+  }
+  const std::string capability = getDatumCapability(sub.datum);
+  H_ASSERT(checkCapability(capability), "Unknown output: " + sub.datum);
+  const std::string &componentName =
+      componentCapabilities.find(capability)->second;
+  sub.component = componentName == CORE_COMPONENT_NAME
+                      ? NULL
+                      : getComponentByName(componentName);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Find whether a subscribed output can be fetched by date.
+ *  \param sub  The subscription.
+ *  \param date The current date.
+ *  \details Some outputs (e.g. ocean chemistry) are only kept as their
+ *           current value.  This is decided once: if asking for the output at
+ *           the current date fails but asking for its current value works,
+ *           it is fetched without a date from then on; if asking by date
+ *           works, it's fetched by date.  Errors from fetching it after that
+ *           are passed on.  If neither works yet (e.g. there's no value at
+ *           the start date), getOutput() tries again when it is first
+ *           written.
+ */
+void Core::findOutputDating(OutputSubscription &sub, const double date) {
+  sub.dating = OutputSubscription::DATED;
+  try {
+    fetchOutput(sub, date);
+  } catch (h_exception &) {
+    sub.dating = OutputSubscription::UNDATED;
+    try {
+      fetchOutput(sub, date);
+    } catch (h_exception &) {
+      sub.dating = OutputSubscription::DATING_UNKNOWN;
+      return;
     }
   }
+  H_LOG(glog, Logger::DEBUG)
+      << "Output " << sub.datum << " is fetched "
+      << (sub.dating == OutputSubscription::DATED ? "by date"
+                                                  : "as its current value")
+      << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -362,9 +578,70 @@ void Core::prepareToRun(void) {
     modelComponents =
         map<string, IModelComponent *, DependencyOrderingComparator>(
             modelComponents.begin(), modelComponents.end(), comp);
+
+    // ------------------------------------
+    // 3a. If requested, set up to run independent components concurrently,
+    // using the same dependencies
+    if (component_threads > 1) {
+      vector<IModelComponent *> components;
+      map<string, size_t> position;
+      for (auto mc : modelComponents) {
+        position[mc.first] = components.size();
+        components.push_back(mc.second);
+      }
+      vector<vector<bool>> dependencies(
+          components.size(), vector<bool>(components.size(), false));
+      for (auto dep : componentDependencies) {
+        if (checkCapability(dep.second)) {
+          const string provider =
+              getComponentByCapability(dep.second)->getComponentName();
+          if (position.count(dep.first) && position.count(provider)) {
+            dependencies[position[provider]][position[dep.first]] = true;
+          }
+        }
+      }
+      scheduler.reset(new ComponentScheduler(components, dependencies,
+                                             component_threads, glog));
+    }
+
+    // ------------------------------------
+    // 3b. If requested, run the (enabled) halocarbons together
+    if (use_halocarbon_engine) {
+      vector<HalocarbonComponent *> halocarbons;
+      for (auto mc : modelComponents) {
+        HalocarbonComponent *hc =
+            dynamic_cast<HalocarbonComponent *>(mc.second);
+        if (hc) {
+          halocarbons.push_back(hc);
+        }
+      }
+      halocarbonEngine.reset(new HalocarbonEngine(this, halocarbons));
+    }
+
+    // ------------------------------------
+    // 3c. If requested, run the OH, CH4, and N2O chemistry together, and/or
+    // compute the short-lived forcings for the whole run at once
+    if (use_chemistry_engine || use_short_lived_engine) {
+      vector<IModelComponent *> components;
+      for (auto mc : modelComponents) {
+        components.push_back(mc.second);
+      }
+      if (use_chemistry_engine) {
+        chemistryEngine.reset(
+            new AtmosphericChemistryEngine(this, components));
+      }
+      if (use_short_lived_engine) {
+        shortLivedEngine.reset(new ShortLivedForcerEngine(this, components));
+      }
+    }
   }
   setup_complete = true;
 
+  // Now that disabled components are gone, find who provides each output
+  for (auto &sub : outputSubscriptions) {
+    resolveOutputSubscription(sub);
+  }
+
   /* Everything from here on down is ok to run more than once */
   // ------------------------------------
   // 4. Tell model components we are finished sending data and about to start
@@ -373,6 +650,9 @@ void Core::prepareToRun(void) {
   for (auto mc : modelComponents) {
     mc.second->prepareToRun();
   }
+  if (shortLivedEngine) {
+    shortLivedEngine->invalidate();
+  }
 
   // ------------------------------------
   // Visit all the visitors; this lets them record the core pointer, tracking
@@ -389,6 +669,12 @@ void Core::prepareToRun(void) {
   } else {
     H_LOG(glog, Logger::WARNING) << "No model spinup was requested" << endl;
   } // if
+
+  // ------------------------------------
+  // 6. Now that the starting state exists, find how to fetch each output
+  for (auto &sub : outputSubscriptions) {
+    findOutputDating(sub, lastDate);
+  }
 }
 
 bool Core::run_spinup() {
@@ -443,6 +729,12 @@ bool Core::run_spinup() {
  *           with progressively larger run-to dates to pick up each
  *           time where it left off before.
  *
+ *           The current date (getCurrentDate()) is advanced as each time
+ *           step finishes, before the visitors are called, so visitors
+ *           see the date they are visiting, and can fetch its values by
+ *           date.  If a time step fails, the current date is the last
+ *           one that finished.
+ *
  *  \exception h_exception An error which may occur at any stage of the process.
  */
 void Core::run(double runtodate) {
@@ -479,6 +771,15 @@ void Core::run(double runtodate) {
     }
   }
 
+  // Components that depend only on their inputs over this run can compute
+  // all of it now, and skip their work in the loop below
+  for (auto it : modelComponents) {
+    if (it.second->runAhead(lastDate + 1.0, runtodate)) {
+      H_LOG(glog, Logger::DEBUG)
+          << it.first << " computed through " << runtodate << endl;
+    }
+  }
+
   // Main model run loop
   for (double currDate = lastDate + 1.0; currDate <= runtodate;
        currDate += 1.0) {
@@ -491,10 +792,51 @@ void Core::run(double runtodate) {
       // nb components are responsible for checking and acting on this
     }
 
-    for (auto it : modelComponents) {
-      it.second->run(currDate);
+    // Halocarbons and the short-lived forcer inputs don't depend on any other
+    // component, and no component that runs before OH, CH4, or N2O depends on
+    // them, so the engines can run before anything else
+    if (halocarbonEngine) {
+      halocarbonEngine->run(currDate);
+    }
+    if (chemistryEngine) {
+      chemistryEngine->run(currDate);
+    }
+    if (shortLivedEngine) {
+      shortLivedEngine->run(currDate);
+    }
+
+    if (scheduler) {
+      if (!scheduler->run(currDate)) {
+        // A component sent data the scheduler's levels didn't allow for, so
+        // this year's results are incomplete; redo it with the components
+        // run in order
+        for (auto mc : modelComponents) {
+          mc.second->reset(currDate - 1.0);
+        }
+        if (shortLivedEngine) {
+          shortLivedEngine->invalidate();
+        }
+        if (halocarbonEngine) {
+          halocarbonEngine->run(currDate);
+        }
+        if (chemistryEngine) {
+          chemistryEngine->run(currDate);
+        }
+        if (shortLivedEngine) {
+          shortLivedEngine->run(currDate);
+        }
+        scheduler->run(currDate);
+      }
+    } else {
+      for (auto it : modelComponents) {
+        it.second->run(currDate);
+      }
     }
 
+    // This year is done, so visitors can ask for its values by date (and
+    // getCurrentDate() is the date they're visiting)
+    lastDate = currDate;
+
     // Let visitors attempt to collect data if necessary
     for (auto vis : modelVisitors) {
       if (vis->shouldVisit(in_spinup, currDate)) {
@@ -529,6 +871,10 @@ void Core::reset(double resetdate) {
     mc.second->reset(resetdate);
   }
 
+  if (shortLivedEngine) {
+    shortLivedEngine->invalidate();
+  }
+
   // Inform all visitors of the reset as well
   // Currently (2021) only csvFluxPoolVisitor implements this
   for (auto vis : modelVisitors) {
@@ -707,24 +1053,93 @@ unitval Core::getData(const std::string &varName, const double date) {
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Look up component and send message in one operation.
- *  \param message  The message to pass (typically "getData").
- *  \param datum    The datum caller is interested in.
- *  \param info     Extra information, message-specific.
- *  \exception h_exception If the componentName was not recognized.
+/*! \brief Retrieve values for several variables at several dates in one call.
+ *
+ *  \details This is equivalent to sending a M_GETDATA message for every
+ *           combination of datum and date, but each datum is resolved to the
+ *           component that provides it only once, and the component is asked
+ *           for all of its dates at once (see
+ *           IModelComponent::getDataSeries()).  Results are stored in
+ *           column-major order (all of the dates for the first datum, then
+ *           all of the dates for the second, and so on), which is the layout
+ *           of a matrix in R.
+ *  \param datums The variables (capabilities, optionally with a biome
+ *                prefix) to retrieve.
+ *  \param dates  The dates to retrieve.  Use Core::undefinedIndex() for
+ *                variables that have no date.
+ *  \param values (output) dates.size() * datums.size() values.
+ *  \param units  (output) The units of each value, in the same order; as with
+ *                separate messages, a datum's units may differ between dates.
+ *  \exception h_exception If a datum is unknown.
  */
-unitval Core::sendMessage(const std::string &message, const std::string &datum,
-                          const message_data &info) {
+void Core::getDataBlock(const std::vector<std::string> &datums,
+                        const std::vector<double> &dates,
+                        std::vector<double> &values,
+                        std::vector<std::string> &units) {
+  H_ASSERT(isInited, "getDataBlock not available until core is initialized");
+
+  const size_t ndate = dates.size();
+  values.resize(ndate * datums.size());
+  units.resize(ndate * datums.size());
+
+  std::vector<unitval> series;
+  for (size_t j = 0; j < datums.size(); ++j) {
+    const std::string &datum = datums[j];
+    const std::string datum_capability = getDatumCapability(datum);
+    H_ASSERT(checkCapability(datum_capability), "Unknown model datum: " + datum);
+
+    // Special case: core handles
+    const std::string &componentName =
+        componentCapabilities.find(datum_capability)->second;
+    if (componentName != CORE_COMPONENT_NAME) {
+      getComponentByName(componentName)->getDataSeries(datum, dates, series);
+    } else {
+      series.resize(ndate);
+      for (size_t i = 0; i < ndate; ++i) {
+        series[i] = getData(datum, dates[i]);
+      }
+    }
+
+    // Units rarely change between dates, so their names are mostly copies
+    for (size_t i = 0; i < ndate; ++i) {
+      const size_t k = j * ndate + i;
+      values[k] = series[i].value(series[i].units());
+      units[k] = i > 0 && series[i].units() == series[i - 1].units()
+                     ? units[k - 1]
+                     : series[i].unitsName();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Get the capability named by a datum.
+ *  \details Biome-specific data are requested as `biome.capability`; the
+ *           capability itself is what the components register.
+ *  \param datum The datum to split.
+ *  \exception h_exception If the datum contains more than one separator.
+ */
+std::string Core::getDatumCapability(const std::string &datum) {
   std::vector<std::string> datum_split;
   boost::split(datum_split, datum, boost::is_any_of(SNBOX_PARSECHAR));
   H_ASSERT(datum_split.size() < 3,
            "max of one separator allowed in variable names");
-  std::string datum_capability;
   if (datum_split.size() == 2) {
-    datum_capability = datum_split[1];
+    return datum_split[1];
   } else {
-    datum_capability = datum_split[0];
+    return datum_split[0];
   }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Look up component and send message in one operation.
+ *  \param message  The message to pass (typically "getData").
+ *  \param datum    The datum caller is interested in.
+ *  \param info     Extra information, message-specific.
+ *  \exception h_exception If the componentName was not recognized.
+ */
+unitval Core::sendMessage(const std::string &message, const std::string &datum,
+                          const message_data &info) {
+  const std::string datum_capability = getDatumCapability(datum);
 
   if (message == M_GETDATA || message == M_DUMP_TO_DEEP_OCEAN) {
     // M_GETDATA is used extensively by components to query each other re state
@@ -745,8 +1160,11 @@ unitval Core::sendMessage(const std::string &message, const std::string &datum,
       if ((*it).second == CORE_COMPONENT_NAME) {
         return this->getData(datum, info.date);
       } else {
-        return getComponentByName((*it).second)
-            ->sendMessage(message, datum, info);
+        IModelComponent *component = getComponentByName((*it).second);
+        if (scheduler) {
+          scheduler->noteMessage(component);
+        }
+        return component->sendMessage(message, datum, info);
       }
     }
   } else if (message == M_SETDATA) {
@@ -765,9 +1183,16 @@ unitval Core::sendMessage(const std::string &message, const std::string &datum,
       if (it->second == CORE_COMPONENT_NAME) {
         this->setData(CORE_COMPONENT_NAME, datum, info);
       } else {
-        getComponentByName(it->second)->sendMessage(message, datum, info);
+        IModelComponent *component = getComponentByName(it->second);
+        if (scheduler) {
+          scheduler->noteMessage(component);
+        }
+        component->sendMessage(message, datum, info);
       }
     }
+    if (shortLivedEngine) {
+      shortLivedEngine->invalidate();
+    }
 
     return info.value_unitval;
   } else {
@@ -815,9 +1240,8 @@ std::vector<Core *> Core::core_registry;
 /*! Create a core and add it to the registry
  */
 int Core::mkcore(bool logtofile, Logger::LogLevel loglvl, bool logtoscrn) {
-  // Create a dummy output filestream, essentially /dev/null
-  std::ofstream dummy;
-  CSVFluxPoolVisitor *visitr = new CSVFluxPoolVisitor(dummy);
+  // Create a visitor that keeps the tracking data in memory
+  CSVFluxPoolVisitor *visitr = new CSVFluxPoolVisitor();
 
   // Create the new core, add the visitor, and push onto the core registry
   Core *core = new Core(loglvl, logtoscrn, logtofile);
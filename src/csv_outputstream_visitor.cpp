@@ -14,6 +14,7 @@
 
 #include <fstream>
 #include <regex>
+#include <sstream>
 
 // some boost headers generate warnings under clang; not our problem, ignore
 // 2023 and Boost 1.81.0_1: lexical_cast.hpp still generates many warnings
@@ -51,7 +52,7 @@ using namespace std;
  */
 CSVOutputStreamVisitor::CSVOutputStreamVisitor(ostream &outputStream,
                                                const bool printHeader)
-    : csvFile(outputStream) {
+    : csvFile(outputStream), core(NULL) {
   if (printHeader) {
 
     // Save the current time (real world not Hector current time) to write out
@@ -63,23 +64,40 @@ CSVOutputStreamVisitor::CSVOutputStreamVisitor(ostream &outputStream,
 
     // Print model version header
     csvFile << "# Output from " << MODEL_NAME << " version " << MODEL_VERSION
-            << " on " << print_time << endl;
+            << " on " << print_time << '\n';
 
     // Print table header
     csvFile << "year" << DELIMITER << "run_name" << DELIMITER << "spinup"
             << DELIMITER << "component" << DELIMITER << "variable" << DELIMITER
-            << "value" << DELIMITER << "units" << endl;
+            << "value" << DELIMITER << "units" << '\n';
   }
   run_name = "";
   current_date = 0;
   datestring = "";
   spinupstring = "";
+  updateLinestamp();
+  buffer.reserve(BLOCK_SIZE + BLOCK_SIZE / 4);
 }
 
 //------------------------------------------------------------------------------
 /*! \brief Destructor
+ *  \details Writes out any buffered output; the output stream must still
+ *           exist.
  */
-CSVOutputStreamVisitor::~CSVOutputStreamVisitor() {}
+CSVOutputStreamVisitor::~CSVOutputStreamVisitor() { flush(); }
+
+//------------------------------------------------------------------------------
+/*! \brief Write any buffered output lines to the output stream.
+ *  \details Lines are buffered and written in blocks of about BLOCK_SIZE
+ *           bytes, rather than flushing the stream after each one.
+ */
+void CSVOutputStreamVisitor::flush() {
+  if (!buffer.empty()) {
+    csvFile.write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+  csvFile.flush();
+}
 
 //------------------------------------------------------------------------------
 // documentation is inherited
@@ -89,73 +107,146 @@ bool CSVOutputStreamVisitor::shouldVisit(const bool is, const double date) {
   in_spinup = is;
   datestring = boost::lexical_cast<string>(date);
   spinupstring = boost::lexical_cast<string>(in_spinup);
+  updateLinestamp();
+
+  if (core && !core->getOutputSubscriptions().empty()) {
+    // Write just the subscribed outputs, without visiting the components.
+    // They're for model years, so there are none during spinup.
+    if (!core->inSpinup()) {
+      writeSubscriptions();
+    }
+    return false;
+  }
 
   // visit all model periods
   return true;
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Return text that starts every output line
+/*! \brief Write the subscribed outputs for the current date
+ *  \details Each output is fetched straight from the component that provides
+ *           it, which the core found when the model was set up.  Some outputs
+ *           (e.g. ocean chemistry) can't be fetched by date, only as their
+ *           current value; since visitors are called right after the date has
+ *           been run, that's the same thing.
+ */
+void CSVOutputStreamVisitor::writeSubscriptions() {
+  const vector<Core::OutputSubscription> &subs =
+      core->getOutputSubscriptions();
+  for (size_t i = 0; i < subs.size(); ++i) {
+    const Core::OutputSubscription &sub = subs[i];
+    if (current_date < sub.first || current_date > sub.last) {
+      continue;
+    }
+    const unitval x = core->getOutput(i, current_date);
+    writeLine(sub.component ? sub.component->getComponentName()
+                            : core->getComponentName(),
+              sub.datum, x);
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Should all of a component's outputs be written?
+ *  \details Not if its output is disabled, or if only some outputs have been
+ *           subscribed to.
  */
-std::string CSVOutputStreamVisitor::linestamp() {
-  return (datestring + DELIMITER + run_name + DELIMITER + spinupstring +
-          DELIMITER);
+bool CSVOutputStreamVisitor::outputEnabled(const IModelComponent *c) const {
+  return core->getOutputSubscriptions().empty() &&
+         core->outputEnabled(c->getComponentName());
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Render the text that starts every output line
+ */
+void CSVOutputStreamVisitor::updateLinestamp() {
+  linestamp = datestring + DELIMITER + run_name + DELIMITER + spinupstring +
+              DELIMITER;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Append one output line to the buffer
+ *  \param component Component name
+ *  \param name      Variable name
+ *  \param x         Value, written in its own units
+ *  \details The value is formatted exactly as csvFile would format it, at
+ *           its current precision.
+ */
+void CSVOutputStreamVisitor::writeLine(const std::string &component,
+                                       const std::string &name,
+                                       const unitval &x) {
+  buffer += linestamp;
+  buffer += component;
+  buffer += DELIMITER;
+  buffer += name;
+  buffer += DELIMITER;
+
+  const double value = x.value(x.units());
+  const ios_base::fmtflags special = ios_base::floatfield | ios_base::showpos |
+                                     ios_base::showpoint | ios_base::uppercase;
+  if (!(csvFile.flags() & special) && csvFile.getloc() == locale::classic()) {
+    append_double(buffer, value, static_cast<int>(csvFile.precision()));
+  } else {
+    ostringstream formatted;
+    formatted.copyfmt(csvFile);
+    formatted << value;
+    buffer += formatted.str();
+  }
+
+  buffer += DELIMITER;
+  buffer += x.unitsName();
+  buffer += '\n';
+  if (buffer.size() >= BLOCK_SIZE) {
+    flush();
+  }
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(Core *c) {
   run_name = c->getRun_name();
+  updateLinestamp();
   core = c;
 }
 
 // TODO: consolidate these macros into the two MESSAGE ones,
 // and shift string literals to D_xxxx definitions
 
-// Macro to send a variable with associated unitval units to some output stream
-// Takes s (stream), c (component), xname (variable name), x (output variable)
-#define STREAM_UNITVAL(s, c, xname, x)                                         \
-  {                                                                            \
-    s << linestamp() << c->getComponentName() << DELIMITER << xname            \
-      << DELIMITER << x.value(x.units()) << DELIMITER << x.unitsName()         \
-      << std::endl;                                                            \
-  }
+// Macro to send a variable with associated unitval units to the output
+// Takes c (component), xname (variable name), x (output variable)
+#define STREAM_UNITVAL(c, xname, x)                                            \
+  { writeLine(c->getComponentName(), xname, x); }
 
-// Macro to send a variable with associated unitval units to some output stream
+// Macro to send a variable with associated unitval units to the output
 // This uses new sendMessage interface in imodel_component
-// Takes s (stream), c (component), xname (variable name)
-#define STREAM_MESSAGE(s, c, xname)                                            \
+// Takes c (component), xname (variable name)
+#define STREAM_MESSAGE(c, xname)                                               \
   {                                                                            \
     unitval x = c->sendMessage(M_GETDATA, xname);                              \
-    s << linestamp() << c->getComponentName() << DELIMITER << xname            \
-      << DELIMITER << x.value(x.units()) << DELIMITER << x.unitsName()         \
-      << std::endl;                                                            \
+    writeLine(c->getComponentName(), xname, x);                                \
   }
 // Macro for date-dependent variables
-// Takes s (stream), c (component), xname (variable name), date
-#define STREAM_MESSAGE_DATE(s, c, xname, date)                                 \
+// Takes c (component), xname (variable name), date
+#define STREAM_MESSAGE_DATE(c, xname, date)                                    \
   {                                                                            \
     unitval x = c->sendMessage(M_GETDATA, xname, message_data(date));          \
-    s << linestamp() << c->getComponentName() << DELIMITER << xname            \
-      << DELIMITER << x.value(x.units()) << DELIMITER << x.unitsName()         \
-      << std::endl;                                                            \
+    writeLine(c->getComponentName(), xname, x);                                \
   }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(ForcingComponent *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
   streamsize oldPrecision = csvFile.precision(4);
 
   if (c->currentYear < c->baseyear)
     return;
 
-  ForcingComponent::forcings_t forcings = c->forcings_ts.get(c->currentYear);
+  ForcingComponent::forcings_t forcings = c->getForcings(c->currentYear);
 
   // Walk through the forcings map, outputting everything
   for (auto f : forcings) {
-    STREAM_UNITVAL(csvFile, c, f.first, f.second);
+    STREAM_UNITVAL(c, f.first, f.second);
   }
 
   csvFile.precision(oldPrecision);
@@ -164,55 +255,55 @@ void CSVOutputStreamVisitor::visit(ForcingComponent *c) {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(SimpleNbox *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
 
   // Global outputs
   // Note if there are multiple biomes, these values will be totals, summed
   // across all biomes
-  STREAM_MESSAGE(csvFile, c, D_NBP);
-  STREAM_UNITVAL(csvFile, c, D_NPP, c->final_npp[SNBOX_DEFAULT_BIOME]);
-  STREAM_UNITVAL(csvFile, c, D_RH, c->final_rh[SNBOX_DEFAULT_BIOME]);
-  STREAM_UNITVAL(csvFile, c, D_RH_DETRITUS, c->final_rh_detritus[SNBOX_DEFAULT_BIOME]);
-  STREAM_UNITVAL(csvFile, c, D_RH_SOIL, c->final_rh_soil[SNBOX_DEFAULT_BIOME]);
-  STREAM_UNITVAL(csvFile, c, D_RH_CH4, c->final_rh[SNBOX_DEFAULT_BIOME]);
-  STREAM_MESSAGE_DATE(csvFile, c, D_CO2_CONC, current_date);
-  STREAM_MESSAGE(csvFile, c, D_ATMOSPHERIC_CO2);
-  STREAM_MESSAGE(csvFile, c, D_ATMOSPHERIC_C_RESIDUAL);
-  STREAM_MESSAGE(csvFile, c, D_VEGC);
-  STREAM_MESSAGE(csvFile, c, D_DETRITUSC);
-  STREAM_MESSAGE(csvFile, c, D_SOILC);
-  STREAM_MESSAGE(csvFile, c, D_PERMAFROSTC);
-  STREAM_MESSAGE(csvFile, c, D_THAWEDPC);
-  STREAM_MESSAGE(csvFile, c, D_F_FROZEN);
-  STREAM_MESSAGE(csvFile, c, D_EARTHC);
+  STREAM_MESSAGE(c, D_NBP);
+  STREAM_UNITVAL(c, D_NPP, c->final_npp[SNBOX_DEFAULT_BIOME]);
+  STREAM_UNITVAL(c, D_RH, c->final_rh[SNBOX_DEFAULT_BIOME]);
+  STREAM_UNITVAL(c, D_RH_DETRITUS, c->final_rh_detritus[SNBOX_DEFAULT_BIOME]);
+  STREAM_UNITVAL(c, D_RH_SOIL, c->final_rh_soil[SNBOX_DEFAULT_BIOME]);
+  STREAM_UNITVAL(c, D_RH_CH4, c->final_rh[SNBOX_DEFAULT_BIOME]);
+  STREAM_MESSAGE_DATE(c, D_CO2_CONC, current_date);
+  STREAM_MESSAGE(c, D_ATMOSPHERIC_CO2);
+  STREAM_MESSAGE(c, D_ATMOSPHERIC_C_RESIDUAL);
+  STREAM_MESSAGE(c, D_VEGC);
+  STREAM_MESSAGE(c, D_DETRITUSC);
+  STREAM_MESSAGE(c, D_SOILC);
+  STREAM_MESSAGE(c, D_PERMAFROSTC);
+  STREAM_MESSAGE(c, D_THAWEDPC);
+  STREAM_MESSAGE(c, D_F_FROZEN);
+  STREAM_MESSAGE(c, D_EARTHC);
 
   // Biome-specific outputs: <biome>.<variable>
   if (c->veg_c.size() > 1) {
     SimpleNbox::fluxpool_stringmap::const_iterator it;
     for (auto b : c->veg_c) {
       std::string biome = b.first;
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_NPP,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_NPP,
                      c->final_npp[biome]);
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_RH,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_RH,
                      c->final_rh[biome]);
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_RH_CH4,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_RH_CH4,
                      c->RH_ch4[biome]);
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_VEGC,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_VEGC,
                      c->veg_c[biome]);
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_DETRITUSC,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_DETRITUSC,
                      c->detritus_c[biome]);
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_SOILC,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_SOILC,
                      c->soil_c[biome]);
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_PERMAFROSTC,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_PERMAFROSTC,
                      c->permafrost_c[biome]);
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_THAWEDPC,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_THAWEDPC,
                      c->thawed_permafrost_c[biome]);
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_F_FROZEN,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_F_FROZEN,
                      unitval(c->f_frozen[biome], U_UNITLESS));
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_TEMPFERTD,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_TEMPFERTD,
                      unitval(c->tempfertd[biome], U_UNITLESS));
-      STREAM_UNITVAL(csvFile, c, biome + SNBOX_PARSECHAR + D_TEMPFERTS,
+      STREAM_UNITVAL(c, biome + SNBOX_PARSECHAR + D_TEMPFERTS,
                      unitval(c->tempferts[biome], U_UNITLESS));
     }
   }
@@ -222,63 +313,63 @@ void CSVOutputStreamVisitor::visit(SimpleNbox *c) {
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(HalocarbonComponent *c) {
   // TODO: how to get emissions in the gas specific units?
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
-  STREAM_MESSAGE(csvFile, c, D_HC_CONCENTRATION);
+  STREAM_MESSAGE(c, D_HC_CONCENTRATION);
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(TemperatureComponent *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
-  STREAM_MESSAGE(csvFile, c, D_GLOBAL_TAS);
-  STREAM_MESSAGE(csvFile, c, D_GMST);
-  STREAM_MESSAGE(csvFile, c, D_FLUX_MIXED);
-  STREAM_MESSAGE(csvFile, c, D_FLUX_INTERIOR)
-  STREAM_MESSAGE(csvFile, c, D_HEAT_FLUX);
-  STREAM_MESSAGE(csvFile, c, D_LAND_TAS);
-  STREAM_MESSAGE(csvFile, c, D_SST);
+  STREAM_MESSAGE(c, D_GLOBAL_TAS);
+  STREAM_MESSAGE(c, D_GMST);
+  STREAM_MESSAGE(c, D_FLUX_MIXED);
+  STREAM_MESSAGE(c, D_FLUX_INTERIOR)
+  STREAM_MESSAGE(c, D_HEAT_FLUX);
+  STREAM_MESSAGE(c, D_LAND_TAS);
+  STREAM_MESSAGE(c, D_SST);
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(OceanComponent *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
-  STREAM_MESSAGE(csvFile, c, D_ATM_OCEAN_FLUX_HL);
-  STREAM_MESSAGE(csvFile, c, D_ATM_OCEAN_FLUX_LL);
-  STREAM_MESSAGE(csvFile, c, D_CARBON_DO);
-  STREAM_MESSAGE(csvFile, c, D_CARBON_HL);
-  STREAM_MESSAGE(csvFile, c, D_CARBON_IO);
-  STREAM_MESSAGE(csvFile, c, D_CARBON_LL);
-  STREAM_MESSAGE(csvFile, c, D_DIC_HL);
-  STREAM_MESSAGE(csvFile, c, D_DIC_LL);
-  STREAM_MESSAGE(csvFile, c, D_HL_DO);
-  STREAM_MESSAGE(csvFile, c, D_OCEAN_C_UPTAKE);
-  STREAM_MESSAGE(csvFile, c, D_OMEGAAR_HL);
-  STREAM_MESSAGE(csvFile, c, D_OMEGAAR_LL);
-  STREAM_MESSAGE(csvFile, c, D_OMEGACA_HL);
-  STREAM_MESSAGE(csvFile, c, D_OMEGACA_LL);
-  STREAM_MESSAGE(csvFile, c, D_PCO2_HL);
-  STREAM_MESSAGE(csvFile, c, D_PCO2_LL);
-  STREAM_MESSAGE(csvFile, c, D_PH_HL);
-  STREAM_MESSAGE(csvFile, c, D_PH_LL);
-  STREAM_MESSAGE(csvFile, c, D_TEMP_HL);
-  STREAM_MESSAGE(csvFile, c, D_TEMP_LL);
-  STREAM_MESSAGE(csvFile, c, D_OCEAN_C);
-  STREAM_MESSAGE(csvFile, c, D_CO3_HL);
-  STREAM_MESSAGE(csvFile, c, D_CO3_LL);
+  STREAM_MESSAGE(c, D_ATM_OCEAN_FLUX_HL);
+  STREAM_MESSAGE(c, D_ATM_OCEAN_FLUX_LL);
+  STREAM_MESSAGE(c, D_CARBON_DO);
+  STREAM_MESSAGE(c, D_CARBON_HL);
+  STREAM_MESSAGE(c, D_CARBON_IO);
+  STREAM_MESSAGE(c, D_CARBON_LL);
+  STREAM_MESSAGE(c, D_DIC_HL);
+  STREAM_MESSAGE(c, D_DIC_LL);
+  STREAM_MESSAGE(c, D_HL_DO);
+  STREAM_MESSAGE(c, D_OCEAN_C_UPTAKE);
+  STREAM_MESSAGE(c, D_OMEGAAR_HL);
+  STREAM_MESSAGE(c, D_OMEGAAR_LL);
+  STREAM_MESSAGE(c, D_OMEGACA_HL);
+  STREAM_MESSAGE(c, D_OMEGACA_LL);
+  STREAM_MESSAGE(c, D_PCO2_HL);
+  STREAM_MESSAGE(c, D_PCO2_LL);
+  STREAM_MESSAGE(c, D_PH_HL);
+  STREAM_MESSAGE(c, D_PH_LL);
+  STREAM_MESSAGE(c, D_TEMP_HL);
+  STREAM_MESSAGE(c, D_TEMP_LL);
+  STREAM_MESSAGE(c, D_OCEAN_C);
+  STREAM_MESSAGE(c, D_CO3_HL);
+  STREAM_MESSAGE(c, D_CO3_LL);
   if (!in_spinup) {
-    STREAM_MESSAGE(csvFile, c, D_REVELLE_HL);
-    STREAM_MESSAGE(csvFile, c, D_REVELLE_LL);
+    STREAM_MESSAGE(c, D_REVELLE_HL);
+    STREAM_MESSAGE(c, D_REVELLE_LL);
   }
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(slrComponent *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
   if (current_date == max(c->refperiod_high, c->normalize_year)) {
     std::string olddatestring = datestring;
@@ -286,64 +377,66 @@ void CSVOutputStreamVisitor::visit(slrComponent *c) {
       // TODO: this is a hack; need to fool the linestamp routine above
       datestring =
           boost::lexical_cast<string>(i); // convert to string and store
-      STREAM_MESSAGE_DATE(csvFile, c, D_SLR, i);
-      STREAM_MESSAGE_DATE(csvFile, c, D_SLR_NO_ICE, i);
+      updateLinestamp();
+      STREAM_MESSAGE_DATE(c, D_SLR, i);
+      STREAM_MESSAGE_DATE(c, D_SLR_NO_ICE, i);
     }
     datestring = olddatestring;
+    updateLinestamp();
   }
   if (current_date >=
       max(c->refperiod_high, c->normalize_year)) { // output all previous years
-    STREAM_MESSAGE_DATE(csvFile, c, D_SL_RC, current_date);
-    STREAM_MESSAGE_DATE(csvFile, c, D_SLR, current_date);
-    STREAM_MESSAGE_DATE(csvFile, c, D_SL_RC_NO_ICE, current_date);
-    STREAM_MESSAGE_DATE(csvFile, c, D_SLR_NO_ICE, current_date);
+    STREAM_MESSAGE_DATE(c, D_SL_RC, current_date);
+    STREAM_MESSAGE_DATE(c, D_SLR, current_date);
+    STREAM_MESSAGE_DATE(c, D_SL_RC_NO_ICE, current_date);
+    STREAM_MESSAGE_DATE(c, D_SLR_NO_ICE, current_date);
   }
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(BlackCarbonComponent *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(OrganicCarbonComponent *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(OzoneComponent *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
-  STREAM_MESSAGE_DATE(csvFile, c, D_ATMOSPHERIC_O3, current_date);
+  STREAM_MESSAGE_DATE(c, D_ATMOSPHERIC_O3, current_date);
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(OHComponent *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
-  STREAM_MESSAGE_DATE(csvFile, c, D_LIFETIME_OH, current_date);
+  STREAM_MESSAGE_DATE(c, D_LIFETIME_OH, current_date);
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(CH4Component *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
-  STREAM_MESSAGE_DATE(csvFile, c, D_CH4_CONC, current_date);
+  STREAM_MESSAGE_DATE(c, D_CH4_CONC, current_date);
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVOutputStreamVisitor::visit(N2OComponent *c) {
-  if (!core->outputEnabled(c->getComponentName()))
+  if (!outputEnabled(c))
     return;
-  STREAM_MESSAGE_DATE(csvFile, c, D_N2O_CONC, current_date);
+  STREAM_MESSAGE_DATE(c, D_N2O_CONC, current_date);
 }
 
 } // namespace Hector
@@ -12,6 +12,8 @@
  *
  */
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
 // some boost headers generate warnings under clang; not our problem, ignore
@@ -41,7 +43,8 @@ using namespace std;
  *  \param fileName The name of a csv file to read from.
  *  \exception h_exception If there were errors when opening the file.
  */
-CSVTableReader::CSVTableReader(const string &fileName) : fileName(fileName) {
+CSVTableReader::CSVTableReader(const string &fileName)
+    : fileName(fileName), loaded(false) {
   // allow exceptions from bad io operations
   tableInputStream.exceptions(ifstream::failbit | ifstream::badbit);
 
@@ -92,97 +95,45 @@ string CSVTableReader::csv_getline() {
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Process the CSV file looking for the given varName and route the data
- *         into the core.
+/*! \brief Read the whole table, splitting it into trimmed cells.
  *
- *  The input stream will be reset to allow to processing multiple times from
- *  this reader.  Next the header row is read and searched to find the column
- *  which varName is contained in.  Then each row of the table is read.  Should
- * the the first column be UNITS it will use the row to set the units string to
- * pass along with read data to provide units checking.  Otherwise it will
- * assume the first column is the time series index and consistent columns for
- * each row. Each value will be routed through the core as rows are read.  Extra
- *  white space will be removed before sending the value into the core.
+ *  Blank lines (including a stray windows line ending which may have made its
+ *  way in from a mixed line ending file) are skipped.  The file is closed once
+ *  it has been read.
  *
- *  \param core A pointer to the model core to route data through.
- *  \param componentName The model component to set varName in.
- *  \param varName The variable name to look for in the CSV file and set.
- *  \exception h_exception For any I/O errors, improper formatting, and
- * inability to find varName.  Also any errors while trying to setData will also
- * be propagated.
+ *  \exception h_exception For any I/O errors, or an index that isn't a number.
  */
-
-void CSVTableReader::process(Core *core, const string &componentName,
-                             const string &varName) {
+void CSVTableReader::load() {
   using namespace boost;
   try {
-    // reset the stream in case we are re-reading from this stream
-    tableInputStream.clear();
-    tableInputStream.seekg(0, ifstream::beg);
     lineNum = 0;
-
-    string line;
-    vector<string> row;
-    string unitsLabel;
-    size_t columnIndex = 0; // code for "not found", takes advantage of skipping
-                            // col==0 in the loop below.
-
-    // read the header line and attempt to find varName. The first column is
-    // not considered because that should be the index column.
-    line = csv_getline();
+    string line = csv_getline();
     H_ASSERT(!line.empty(), "line empty");
-    split(row, line, is_any_of(","));
-    //        const int headerRowSize = row.size();
-    for (size_t col = 1; col < row.size() && columnIndex == 0; ++col) {
-      // ignore white space before comparing variable names
-      trim(row[col]);
-      if (row[col] == varName) {
-        columnIndex = col;
-      }
-    }
-    if (columnIndex == 0) {
-      H_THROW("Could not find a column for " + varName + " in " + fileName +
-              " header=" + line);
+    split(header, line, is_any_of(","));
+    for (string &cell : header) {
+      trim(cell);
     }
 
-    // we are all set to process the table
     // note that getline sets the fail bit when it hits eof which is not what
     // want, a work around is to check peek
     while (!tableInputStream.eof() && tableInputStream.peek() != -1) {
-      // read the next row to process
       line = csv_getline();
-
-      // Ignore blank lines. A stray windows line ending which may have made
-      // its way in from a mixed line ending file can be skipped as well.
       if (line.empty() || line[0] == '\r') {
         continue;
       }
 
-      split(row, line, is_any_of(","));
-
-      // remove extra white space from the table value
-      trim(row[0]);
-      trim(row[columnIndex]);
-
-      if (row[0] == "UNITS") {
-        // this row of the table is specifying units for all columns
-        // we only need to keep track of the value for the column of interest
-        unitsLabel = row[columnIndex];
-      } else {
-        // this row is a regular row of data
-        // the first column is assumed to be the index
-        double tseriesIndex = lexical_cast<double>(row[0]);
-
-        // route the data to the appropriate model component
-        if (!row[columnIndex].empty()) { // ignore blanks
-          message_data data(row[columnIndex]);
-          data.date = tseriesIndex;
-          data.units_str = unitsLabel;
-          core->setData(componentName, varName, data);
-        }
+      Row row;
+      row.lineNum = lineNum;
+      split(row.cells, line, is_any_of(","));
+      for (string &cell : row.cells) {
+        trim(cell);
       }
+      row.isUnits = row.cells[0] == "UNITS";
+      // the first column is assumed to be the index
+      row.date = row.isUnits ? 0.0 : lexical_cast<double>(row.cells[0]);
+      rows.push_back(row);
     }
-
+    tableInputStream.close();
   } catch (ifstream::failure &e) {
     string errorStr = "I/O exception while processing " + fileName +
                       " error: " + strerror(errno);
@@ -192,6 +143,60 @@ void CSVTableReader::process(Core *core, const string &componentName,
             lexical_cast<string>(lineNum) +
             ", exception: " + castException.what());
   }
+  loaded = true;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Process the CSV file looking for the given varName and route the data
+ *         into the core.
+ *
+ *  The table is read the first time this is called (see load()).  The header
+ *  row is searched to find the column which varName is contained in.  Then
+ *  each row of the table is processed.  Should the first column be UNITS it
+ *  will use the row to set the units string to pass along with read data to
+ *  provide units checking.  Otherwise the first column is the time series
+ *  index and each value will be routed through the core.
+ *
+ *  \param core A pointer to the model core to route data through.
+ *  \param componentName The model component to set varName in.
+ *  \param varName The variable name to look for in the CSV file and set.
+ *  \exception h_exception For any I/O errors, improper formatting, and
+ * inability to find varName.  Also any errors while trying to setData will also
+ * be propagated.
+ */
+void CSVTableReader::process(Core *core, const string &componentName,
+                             const string &varName) {
+  if (!loaded) {
+    load();
+  }
+
+  // find varName in the header. The first column is not considered because
+  // that should be the index column.
+  const auto column = find(header.begin() + 1, header.end(), varName);
+  if (header.empty() || column == header.end()) {
+    H_THROW("Could not find a column for " + varName + " in " + fileName);
+  }
+  const size_t columnIndex = column - header.begin();
+
+  string unitsLabel;
+  for (const Row &row : rows) {
+    if (columnIndex >= row.cells.size()) {
+      H_THROW("Too few columns on line " + to_string(row.lineNum) + " of " +
+              fileName);
+    }
+    const string &value = row.cells[columnIndex];
+    if (row.isUnits) {
+      // this row of the table is specifying units for all columns
+      // we only need to keep track of the value for the column of interest
+      unitsLabel = value;
+    } else if (!value.empty()) { // ignore blanks
+      // route the data to the appropriate model component
+      message_data data(value);
+      data.date = row.date;
+      data.units_str = unitsLabel;
+      core->setData(componentName, varName, data);
+    }
+  }
   // h_exceptions from setData should just be passed along
 }
 
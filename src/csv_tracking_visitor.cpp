@@ -12,6 +12,7 @@
  *
  */
 
+#include <algorithm>
 #include <fstream>
 
 // some boost headers generate warnings under clang; not our problem, ignore
@@ -23,6 +24,7 @@
 
 #include "core.hpp"
 #include "csv_tracking_visitor.hpp"
+#include "h_exception.hpp"
 #include "h_util.hpp"
 #include "ocean_component.hpp"
 #include "simpleNbox.hpp"
@@ -32,6 +34,19 @@ namespace Hector {
 
 using namespace std;
 
+//------------------------------------------------------------------------------
+/*! \brief Constructor for a visitor that keeps its output in memory
+ *  \details The output is available from outputTrackingData(), with a header.
+ */
+CSVFluxPoolVisitor::CSVFluxPoolVisitor()
+    : csvFile(NULL), written(0), writtenEnd(0), started(false), origin(0) {
+  stringstream hdr;
+  hdr << "year" << DELIMITER << "component" << DELIMITER << "pool_name"
+      << DELIMITER << "pool_value" << DELIMITER << "pool_units" << DELIMITER
+      << "source_name" << DELIMITER << "source_fraction" << '\n';
+  header = hdr.str();
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Constructor
  *  \param outputStream The file to write the csv output to
@@ -39,15 +54,29 @@ using namespace std;
  */
 CSVFluxPoolVisitor::CSVFluxPoolVisitor(ostream &outputStream,
                                        const bool printHeader)
-    : csvFile(outputStream) {
-  stringstream hdr;
-  if (printHeader) {
-    // Store table header
-    hdr << "year" << DELIMITER << "component" << DELIMITER << "pool_name"
-        << DELIMITER << "pool_value" << DELIMITER << "pool_units" << DELIMITER
-        << "source_name" << DELIMITER << "source_fraction" << endl;
+    : CSVFluxPoolVisitor() {
+  csvFile = &outputStream;
+  if (!printHeader) {
+    header = "";
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Constructor for a visitor that writes to a file
+ *  \param fileName The file to write the csv output to; it is overwritten
+ *  \param printHeader Boolean controlling whether we print a header or not
+ *  \exception h_exception If the file can't be opened.
+ */
+CSVFluxPoolVisitor::CSVFluxPoolVisitor(const string &fileName,
+                                       const bool printHeader)
+    : CSVFluxPoolVisitor() {
+  ownedFile.reset(new ofstream(fileName.c_str(), ios::out | ios::trunc));
+  H_ASSERT(ownedFile->is_open(), "could not open " + fileName);
+  this->fileName = fileName;
+  csvFile = ownedFile.get();
+  if (!printHeader) {
+    header = "";
   }
-  header = hdr.str();
 }
 
 //------------------------------------------------------------------------------
@@ -55,15 +84,46 @@ CSVFluxPoolVisitor::CSVFluxPoolVisitor(ostream &outputStream,
  */
 CSVFluxPoolVisitor::~CSVFluxPoolVisitor() {
   // Write out the buffer to the csv file before closing down
-
-  if (csvBuffer.size()) {
-    csvFile << header; // the header (or an empty string)
-    for (double yr = csvBuffer.firstdate(); yr <= csvBuffer.lastdate(); yr++) {
-      csvFile << csvBuffer.get(yr);
+  if (csvFile) {
+    writeBuffer();
+    if (started) {
+      csvFile->flush();
+    }
+  }
+  if (ownedFile) {
+    ownedFile->close();
+    if (written < writtenEnd) {
+      // Output was rewound and is now shorter; cut off what's left over from
+      // before
+      try {
+        truncate_file(fileName, static_cast<uintmax_t>(
+                                    static_cast<streamoff>(origin) + written));
+      } catch (h_exception &e) {
+        // can't throw from a destructor
+      }
     }
   }
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Write the buffer to the csv file
+ *  \details The header is written first, but only once there's output.
+ */
+void CSVFluxPoolVisitor::writeBuffer() {
+  if (csvBuffer.empty()) {
+    return;
+  }
+  if (!started) {
+    *csvFile << header; // the header (or an empty string)
+    origin = csvFile->tellp();
+    started = true;
+  }
+  csvFile->write(csvBuffer.data(), csvBuffer.size());
+  written += csvBuffer.size();
+  writtenEnd = max(writtenEnd, written);
+  csvBuffer.clear();
+}
+
 //------------------------------------------------------------------------------
 // documentation is inherited
 bool CSVFluxPoolVisitor::shouldVisit(const bool in_spinup, const double date) {
@@ -86,18 +146,33 @@ void CSVFluxPoolVisitor::visit(Core *c) {
  */
 void CSVFluxPoolVisitor::print_pool(const fluxpool x, const string cname) {
   if (x.tracking) {
-    stringstream output;
     // there might already be "diff" output
-    if (csvBuffer.exists(current_date)) {
-      output << csvBuffer.get(current_date);
+    if (yearStarts.empty() || yearStarts.back().first != current_date) {
+      yearStarts.push_back(make_pair(
+          current_date, written + static_cast<streamoff>(csvBuffer.size())));
     }
+    const double value = x.value(U_PGC);
+    const string units = x.unitsName();
     vector<string> sources = x.get_sources();
     for (auto &s : sources) {
-      output << datestring << DELIMITER << cname << DELIMITER << x.name
-             << DELIMITER << x.value(U_PGC) << DELIMITER << x.unitsName()
-             << DELIMITER << s << DELIMITER << x.get_fraction(s) << endl;
+      csvBuffer += datestring;
+      csvBuffer += DELIMITER;
+      csvBuffer += cname;
+      csvBuffer += DELIMITER;
+      csvBuffer += x.name;
+      csvBuffer += DELIMITER;
+      append_double(csvBuffer, value);
+      csvBuffer += DELIMITER;
+      csvBuffer += units;
+      csvBuffer += DELIMITER;
+      csvBuffer += s;
+      csvBuffer += DELIMITER;
+      append_double(csvBuffer, x.get_fraction(s));
+      csvBuffer += '\n';
+    }
+    if (csvFile && csvBuffer.size() >= BLOCK_SIZE) {
+      writeBuffer();
     }
-    csvBuffer.set(current_date, output.str());
   }
 }
 
@@ -138,20 +213,41 @@ void CSVFluxPoolVisitor::visit(OceanComponent *c) {
 //------------------------------------------------------------------------------
 /*! \brief Assemble the time series strings into the given tracking output
  * stream. \param tracking_out The output stream to write results into.
+ * \details Output that is streamed to a file isn't kept, so only a visitor
+ *          without an output stream provides any.
  */
 void CSVFluxPoolVisitor::outputTrackingData(ostream &tracking_out) const {
-  if (csvBuffer.size()) {
-    tracking_out << header; // the header (or an empty string)
-    for (double yr = csvBuffer.firstdate(); yr <= csvBuffer.lastdate(); yr++) {
-      tracking_out << csvBuffer.get(yr);
-    }
+  if (!csvFile && csvBuffer.size()) {
+    tracking_out << header;
+    tracking_out << csvBuffer;
   }
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void CSVFluxPoolVisitor::reset(const double reset_date) {
-  csvBuffer.truncate(reset_date);
+  // Find the first year after reset_date, and discard its output and after
+  auto first = upper_bound(
+      yearStarts.begin(), yearStarts.end(), reset_date,
+      [](const double d, const pair<double, streamoff> &y) {
+        return d < y.first;
+      });
+  if (first == yearStarts.end()) {
+    return;
+  }
+  const streamoff pos = first->second;
+  yearStarts.erase(first, yearStarts.end());
+
+  if (pos >= written) {
+    csvBuffer.resize(pos - written);
+  } else {
+    // Already written; go back and overwrite it
+    H_ASSERT(ownedFile, "tracking output already written to a stream can't "
+                        "be rewound; write it to a file instead");
+    csvFile->seekp(origin + pos);
+    written = pos;
+    csvBuffer.clear();
+  }
 }
 
 } // namespace Hector
@@ -0,0 +1,62 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  doeclim_kernel.cpp
+ *  hector
+ *
+ *  The DOECLIM ocean diffusion kernel, shared between cores.
+ *
+ */
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include "doeclim_kernel.hpp"
+#include "h_exception.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+/*! \brief Get the kernel for a run.
+ *  \param ns     Number of time steps in the run.
+ *  \param taubot Ocean bottom diffusion time scale, yr.
+ *  \param dt     Time step, yr.
+ *  \details Kernels are computed on first use and then shared, for as long as
+ *           anything holds on to them; the cache only keeps kernels in use.
+ *           Safe to call from several threads.
+ */
+DOECLIMKernel::kernel_ptr DOECLIMKernel::get(const int ns, const double taubot,
+                                             const double dt) {
+  H_ASSERT(ns > 0, "DOECLIM kernel needs at least one time step");
+
+  static mutex cacheMutex;
+  static map<tuple<int, double, double>, weak_ptr<const vector<double>>> cache;
+
+  lock_guard<mutex> lock(cacheMutex);
+  weak_ptr<const vector<double>> &entry = cache[make_tuple(ns, taubot, dt)];
+  kernel_ptr kernel = entry.lock();
+  if (!kernel) {
+    kernel.reset(new vector<double>(compute<double>(ns, taubot, dt)));
+    entry = kernel;
+
+    // Drop kernels nobody holds any more, so an ensemble that varies the
+    // parameters doesn't leave an entry behind for every member
+    for (auto it = cache.begin(); it != cache.end();) {
+      if (it->second.expired()) {
+        it = cache.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  return kernel;
+}
+
+} // namespace Hector
@@ -56,9 +56,7 @@ const tseries<double> &DummyModelComponent::getC() const { return c; }
 //------------------------------------------------------------------------------
 // documentation is inherited
 void DummyModelComponent::init(Core *core) {
-  logger.open(getComponentName(), false,
-              core->getGlobalLogger().getEchoToFile(),
-              core->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), core->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
 }
 
@@ -0,0 +1,79 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  engine_tables.cpp
+ *  hector
+ *
+ *  Yearly tables of component inputs, shared by the engines.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "engine_tables.hpp"
+#include "h_exception.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+/*! \brief Extend a table of a time series, one value per year, through
+ *         lastDate.
+ *  \param ts        The time series.
+ *  \param units     Units of the table.
+ *  \param firstDate Date of the table's first row.
+ *  \param lastDate  Date of the table's last row, once extended.
+ *  \param values    The table; rows already there are kept.
+ *  \details Values that can't be found (e.g. past the end of the data) are
+ *           NaN; that's only an error if they're used (see tableInput()).
+ */
+void tabulate(const tseries<unitval> &ts, const unit_types units,
+              const double firstDate, const double lastDate,
+              vector<double> &values) {
+  const size_t nyears = static_cast<size_t>(lastDate - firstDate) + 1;
+  for (size_t y = values.size(); y < nyears; ++y) {
+    try {
+      values.push_back(ts.get(firstDate + y).value(units));
+    } catch (h_exception &) {
+      values.push_back(numeric_limits<double>::quiet_NaN());
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Extend a table of a concentration constraint, like tabulate().
+ *  \details Years that aren't constrained are NaN.
+ */
+void tabulateConstraint(const tseries<unitval> &ts, const unit_types units,
+                        const double firstDate, const double lastDate,
+                        vector<double> &values) {
+  const size_t nyears = static_cast<size_t>(lastDate - firstDate) + 1;
+  for (size_t y = values.size(); y < nyears; ++y) {
+    const double date = firstDate + y;
+    values.push_back(ts.size() && ts.exists(date)
+                         ? ts.get(date).value(units)
+                         : numeric_limits<double>::quiet_NaN());
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Row y of a table made by tabulate(); if it's missing, let the time
+ *         series say why.
+ */
+double tableInput(const vector<double> &values, const size_t y,
+                  const tseries<unitval> &ts, const double date) {
+  const double value = values[y];
+  if (std::isnan(value)) {
+    ts.get(date);
+    H_THROW("Input missing for this date");
+  }
+  return value;
+}
+
+} // namespace Hector
@@ -0,0 +1,145 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  ensemble_runner.cpp
+ *  hector
+ *
+ *  Run a parameter ensemble on worker threads.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+#include "component_data.hpp"
+#include "ensemble_runner.hpp"
+#include "message_data.hpp"
+#include "scenario.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+/*! \brief Constructor
+ *  \param paramNames Capabilities of the parameters that vary across members.
+ *  \param paramUnits Units of each parameter.
+ *  \param vars       Output variables to retrieve from each member.
+ *  \param dates      Dates at which to retrieve the output variables.
+ */
+EnsembleRunner::EnsembleRunner(const vector<string> &paramNames,
+                               const vector<unit_types> &paramUnits,
+                               const vector<string> &vars,
+                               const vector<double> &dates)
+    : paramNames(paramNames), paramUnits(paramUnits), vars(vars),
+      dates(dates) {
+  H_ASSERT(paramNames.size() == paramUnits.size(),
+           "need one unit for each ensemble parameter");
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Run every member of the ensemble.
+ *
+ *  Members are handed out to worker threads one at a time, so a slow member
+ *  does not hold up the rest of a worker's share.  Each member is run on a
+ *  core of its own, set up from the scenario, so its results don't depend on
+ *  which thread ran it or what that thread ran before.  A member that fails
+ *  does not stop the ensemble: its results are set to NaN and its error
+ *  message is recorded (see getErrors()).
+ *
+ *  \param scenario    The settings every member starts from.
+ *  \param nthreads    Number of worker threads to use.
+ *  \param paramValues nmember x nparam parameter values, column-major.
+ *  \param nmember     Number of ensemble members.
+ *  \param results     (output) Space for nmember * memberSize() values.
+ *  \exception h_exception If there are no threads.
+ */
+void EnsembleRunner::run(const Scenario &scenario, const size_t nthreads,
+                         const double *paramValues, const size_t nmember,
+                         double *results) {
+  H_ASSERT(nthreads > 0, "ensemble needs at least one thread");
+
+  errors.assign(nmember, "");
+  units.clear();
+
+  vector<vector<string>> workerUnits(nthreads);
+  atomic<size_t> next(0);
+
+  auto worker = [&](const size_t w) {
+    for (size_t m = next++; m < nmember; m = next++) {
+      runMember(scenario, paramValues, nmember, m, results, workerUnits[w]);
+    }
+  };
+
+  if (nthreads == 1) {
+    worker(0);
+  } else {
+    vector<thread> pool;
+    for (size_t w = 0; w < nthreads; ++w) {
+      pool.push_back(thread(worker, w));
+    }
+    for (auto &t : pool) {
+      t.join();
+    }
+  }
+
+  // Units don't depend on the parameters, so any member that ran will do
+  for (auto wu : workerUnits) {
+    if (!wu.empty()) {
+      units = wu;
+      break;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Set up, run, and collect results from one member.
+ *  \details Called on a worker thread; must not touch anything shared other
+ *           than this member's slices of the results and errors arrays.  The
+ *           parameters are set before the core is prepared to run, so the
+ *           spinup uses them, as it would for a core read from an input file
+ *           with these values.
+ */
+void EnsembleRunner::runMember(const Scenario &scenario,
+                               const double *paramValues, const size_t nmember,
+                               const size_t member, double *results,
+                               vector<string> &memberUnits) {
+  double *out = results + member * memberSize();
+  try {
+    // Cores don't log, since the log may echo to the R console
+    Core core(Logger::SEVERE, false, false);
+    core.init();
+    core.applyScenario(scenario);
+    for (size_t p = 0; p < paramNames.size(); ++p) {
+      const unitval value(paramValues[p * nmember + member], paramUnits[p]);
+      core.sendMessage(M_SETDATA, paramNames[p],
+                       message_data(Core::undefinedIndex(), value));
+    }
+    core.prepareToRun();
+    core.run();
+
+    vector<double> values;
+    core.getDataBlock(vars, dates, values, memberUnits);
+    copy(values.begin(), values.end(), out);
+    core.shutDown();
+  } catch (h_exception &e) {
+    ostringstream msg;
+    msg << e;
+    errors[member] = msg.str();
+  } catch (std::exception &e) {
+    errors[member] = e.what();
+  }
+
+  if (!errors[member].empty()) {
+    fill(out, out + memberSize(), numeric_limits<double>::quiet_NaN());
+  }
+}
+
+} // namespace Hector
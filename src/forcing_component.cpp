@@ -21,16 +21,13 @@
 
  */
 
-// some boost headers generate warnings under clang; not our problem, ignore
-// 2023 and Boost 1.81.0_1: array.hpp still generates one warning
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Weverything"
-#include <boost/array.hpp>
-#pragma clang diagnostic pop
+#include <algorithm>
 #include <math.h>
 
 #include "avisitor.hpp"
 #include "forcing_component.hpp"
+#include "halocarbon_engine.hpp"
+#include "short_lived_forcer_engine.hpp"
 
 namespace Hector {
 
@@ -73,6 +70,11 @@ const char *ForcingComponent::halo_forcing_names[N_HALO_FORCINGS] = {
 
 std::map<std::string, std::string> ForcingComponent::forcing_name_map;
 
+const char *ForcingComponent::agent_names[N_AGENTS] = {
+    D_RF_CO2, D_RF_N2O, D_RF_CH4, D_RF_H2O_STRAT, D_RF_O3_TROP,
+    D_RF_BC,  D_RF_OC,  D_RF_SO2, D_RF_NH3,       D_RF_ACI,
+    D_RF_T_ALBEDO,      D_RF_VOL, D_RF_MISC};
+
 using namespace std;
 
 //------------------------------------------------------------------------------
@@ -99,15 +101,15 @@ string ForcingComponent::getComponentName() const {
 // documentation is inherited
 void ForcingComponent::init(Core *coreptr) {
 
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
 
   core = coreptr;
 
   baseyear = 0.0;
   currentYear = 0.0;
+  fill(agent_index, agent_index + N_AGENTS, -1);
+  total_index = 0;
 
   Ftot_constrain.allowInterp(true);
   Ftot_constrain.name = D_RF_TOTAL;
@@ -147,6 +149,7 @@ void ForcingComponent::init(Core *coreptr) {
   core->registerDependency(D_EMISSIONS_BC, getComponentName());
   core->registerDependency(D_EMISSIONS_OC, getComponentName());
   core->registerDependency(D_EMISSIONS_NH3, getComponentName());
+  core->registerDependency(D_EMISSIONS_SO2, getComponentName());
   core->registerDependency(D_N2O_CONC, getComponentName());
   core->registerDependency(D_RF_CF4, getComponentName());
   core->registerDependency(D_RF_C2F6, getComponentName());
@@ -292,38 +295,165 @@ void ForcingComponent::prepareToRun() {
   H_ASSERT(delta_n2o >= -1 && delta_n2o <= 1, "bad delta N2O value");
   H_ASSERT(delta_co2 >= -1 && delta_co2 <= 1, "bad delta CO2 value");
 
+  // Work out which forcings will be computed, and give each a fixed slot.
+  // The slots are in alphabetical order, so the total is summed in the same
+  // order as it would be from a map of the forcings.
+  bool active[N_AGENTS];
+  active[RF_CO2] = core->checkCapability(D_CH4_CONC) &&
+                   core->checkCapability(D_N2O_CONC) &&
+                   core->checkCapability(D_CO2_CONC);
+  active[RF_N2O] = active[RF_CH4] = active[RF_H2O_STRAT] = active[RF_CO2];
+  active[RF_O3_TROP] = core->checkCapability(D_ATMOSPHERIC_O3);
+  const ShortLivedForcerEngine *slf = core->getShortLivedForcerEngine();
+  if (slf) {
+    active[RF_BC] = slf->hasAerosols();
+    active[RF_VOL] = slf->hasVolcanic();
+  } else {
+    active[RF_BC] = core->checkCapability(D_EMISSIONS_BC) &&
+                    core->checkCapability(D_EMISSIONS_OC) &&
+                    core->checkCapability(D_EMISSIONS_SO2) &&
+                    core->checkCapability(D_EMISSIONS_NH3);
+    active[RF_VOL] = core->checkCapability(D_VOLCANIC_SO2);
+  }
+  active[RF_OC] = active[RF_SO2] = active[RF_NH3] = active[RF_ACI] =
+      active[RF_BC];
+  active[RF_ALBEDO] = core->checkCapability(D_RF_T_ALBEDO);
+  active[RF_MISC] = true;
+
+  // Halocarbons can be disabled individually via the input file, so we
+  // run through all possible ones (unless the engine runs them)
+  vector<string> halos;
+  if (const HalocarbonEngine *engine = core->getHalocarbonEngine()) {
+    for (size_t i = 0; i < engine->size(); ++i) {
+      halos.push_back(engine->getForcingName(i));
+    }
+  } else {
+    for (int i = 0; i < N_HALO_FORCINGS; ++i) {
+      if (core->checkCapability(halo_forcing_names[i])) {
+        halos.push_back(halo_forcing_names[i]);
+      }
+    }
+  }
+
+  forcing_names = halos;
+  for (int a = 0; a < N_AGENTS; ++a) {
+    if (active[a]) {
+      forcing_names.push_back(agent_names[a]);
+    }
+  }
+  forcing_names.push_back(D_RF_TOTAL);
+  sort(forcing_names.begin(), forcing_names.end());
+  forcing_index.clear();
+  for (size_t i = 0; i < forcing_names.size(); ++i) {
+    forcing_index[forcing_names[i]] = i;
+  }
+  for (int a = 0; a < N_AGENTS; ++a) {
+    agent_index[a] = active[a] ? int(forcing_index[agent_names[a]]) : -1;
+  }
+  halo_index.clear();
+  for (auto hc : halos) {
+    halo_index.push_back(forcing_index[hc]);
+  }
+  total_index = forcing_index[D_RF_TOTAL];
+
+  cachePreindustrial();
   baseyear_forcings.clear();
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Look up the preindustrial CO2, CH4, and N2O concentrations.
+ *  \details These are parameters, so they're only looked up when the model
+ *           is prepared to run or reset, rather than every year.
+ */
+void ForcingComponent::cachePreindustrial() {
+  if (agent_index[RF_CO2] >= 0) {
+    preindustrial_co2 =
+        core->sendMessage(M_GETDATA, D_PREINDUSTRIAL_CO2).value(U_PPMV_CO2);
+    preindustrial_ch4 =
+        core->sendMessage(M_GETDATA, D_PREINDUSTRIAL_CH4).value(U_PPBV_CH4);
+    preindustrial_n2o =
+        core->sendMessage(M_GETDATA, D_PREINDUSTRIAL_N2O).value(U_PPBV_N2O);
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Forcing from aerosol-radiation interactions (RFari) for one species.
+ *  \param rho Radiative efficiency of the species.
+ *  \param E   Emissions, in the units rho is per (Tg, or Gg S for SO2).
+ *  \returns Forcing, W/m2.
+ *  \details RFari is a simple linear relationship to emissions of BC, OC,
+ *           SO2, and NH3.  The rho parameters correspond to the radiative
+ *           efficiencies reported in the text of 7.SM.1.3.1 IPCC AR6, see
+ *           there for more details.  Used by run() and by the short-lived
+ *           forcer engine.
+ */
+double ForcingComponent::ariForcing(const unitval &rho, const double E) const {
+  return alpha.value(U_UNITLESS) * rho * E;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Forcing from aerosol-cloud interactions (RFaci).
+ *  \param E_SO2 SO2 emissions, Gg S.
+ *  \param E_BC  BC emissions, Tg.
+ *  \param E_OC  OC emissions, Tg.
+ *  \returns Forcing, W/m2.
+ *  \details Based on Equation 7.SM.1.2 from IPCC AR6.  Used by run() and by
+ *           the short-lived forcer engine.
+ */
+double ForcingComponent::aciForcing(const double E_SO2, const double E_BC,
+                                    const double E_OC) const {
+  return alpha.value(U_UNITLESS) *
+         (-1 * aci_beta * log(1 + (E_SO2 / s_SO2) + ((E_BC + E_OC) / s_BCOC)));
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Volcanic forcing, W/m2, from the SO2 component's (W/m2).
+ *  \details Used by run() and by the short-lived forcer engine.
+ */
+double ForcingComponent::volcanicForcing(const double SV) const {
+  return volscl.value(U_UNITLESS) * SV;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief The forcings in a year, by name.
+ *  \param date The year; must have been run, and be no earlier than the base
+ *              year.
+ */
+ForcingComponent::forcings_t
+ForcingComponent::getForcings(const double date) const {
+  const vector<double> &values = forcings_ts.get(date);
+  forcings_t forcings;
+  for (size_t i = 0; i < forcing_names.size(); ++i) {
+    forcings[forcing_names[i]] = unitval(values[i], U_W_M2);
+  }
+  return forcings;
+}
+
 //------------------------------------------------------------------------------
 // documentation is inherited
 void ForcingComponent::run(const double runToDate) {
 
   // Calculate instantaneous radiative forcing for any & all agents
-  // As each is computed, push it into 'forcings' map for Ftot calculation.
-  // Note that forcings have to be mutually exclusive, there are no subtotals
-  // for different species.
+  // As each is computed, store it in its slot of 'forcings' for the Ftot
+  // calculation. Which agents are present, and their slots, were worked out
+  // in prepareToRun(). Note that forcings have to be mutually exclusive,
+  // there are no subtotals for different species.
   H_LOG(logger, Logger::DEBUG) << "-----------------------------" << std::endl;
   currentYear = runToDate;
 
   if (runToDate < baseyear) {
     H_LOG(logger, Logger::DEBUG) << "not yet at baseyear" << std::endl;
   } else {
-    forcings_t forcings;
+    vector<double> forcings(forcing_names.size());
 
     //  ---------- Major GHGs ----------
-    if (core->checkCapability(D_CH4_CONC) &&
-        core->checkCapability(D_N2O_CONC) &&
-        core->checkCapability(D_CO2_CONC)) {
-
-      // Parse our the pre industrial and concentrations to use in RF
-      // calculations
-      double C0 =
-          core->sendMessage(M_GETDATA, D_PREINDUSTRIAL_CO2).value(U_PPMV_CO2);
-      double M0 =
-          core->sendMessage(M_GETDATA, D_PREINDUSTRIAL_CH4).value(U_PPBV_CH4);
-      double N0 =
-          core->sendMessage(M_GETDATA, D_PREINDUSTRIAL_N2O).value(U_PPBV_N2O);
+    if (agent_index[RF_CO2] >= 0) {
+
+      // Pre industrial values are cached; get the concentrations to use in
+      // RF calculations
+      const double C0 = preindustrial_co2;
+      const double M0 = preindustrial_ch4;
+      const double N0 = preindustrial_n2o;
       double CO2_conc =
           core->sendMessage(M_GETDATA, D_CO2_CONC, message_data(runToDate))
               .value(U_PPMV_CO2);
@@ -354,7 +484,7 @@ void ForcingComponent::run(const double runToDate) {
       }
       double sarf_co2 = (alpha_prime + n2o_alpha) * log(CO2_conc / C0);
       double fco2 = (sarf_co2 * delta_co2) + sarf_co2;
-      forcings[D_RF_CO2].set(fco2, U_W_M2);
+      forcings[agent_index[RF_CO2]] = fco2;
 
       // ---------- N2O ----------
       // N2O SARF is calculated using simplified expressions from IPCC
@@ -366,7 +496,7 @@ void ForcingComponent::run(const double runToDate) {
           (a2 * sqrt(CO2_conc) + b2 * sqrt(Na) + c2 * sqrt(Ma) + d2) *
           (sqrt(Na) - sqrt(N0));
       double fn2o = (delta_n2o * sarf_n2o) + sarf_n2o;
-      forcings[D_RF_N2O].set(fn2o, U_W_M2);
+      forcings[agent_index[RF_N2O]] = fn2o;
 
       // ---------- CH4 ----------
       // CH4 SARF is calculated using simplified expressions from IPCC
@@ -375,7 +505,7 @@ void ForcingComponent::run(const double runToDate) {
       double sarf_ch4 =
           (a3 * sqrt(Ma) + b3 * sqrt(Na) + d3) * (sqrt(Ma) - sqrt(M0));
       double fch4 = (delta_ch4 * sarf_ch4) + sarf_ch4;
-      forcings[D_RF_CH4].set(fch4, U_W_M2);
+      forcings[agent_index[RF_CH4]] = fch4;
 
       // ---------- Stratospheric H2O based on CH4 oxidation ----------
       // The stratospheric water vapour RF based on changes in CH4
@@ -385,44 +515,50 @@ void ForcingComponent::run(const double runToDate) {
       const double stratH2O_base =
           0.0485; // W m-2 Strat H2O RF (1850 to 2014) from 7.3.2.6 IPCC AR6
       const double fh2o_strat = stratH2O_base * ((Ma - M0) / (Ma_base - M0)); //
-      forcings[D_RF_H2O_STRAT].set(fh2o_strat, U_W_M2);
+      forcings[agent_index[RF_H2O_STRAT]] = fh2o_strat;
     }
 
     // ---------- Troposheric Ozone ----------
-    if (core->checkCapability(D_ATMOSPHERIC_O3)) {
+    if (agent_index[RF_O3_TROP] >= 0) {
       // from Tanaka et al, 2007
       const double ozone = core->sendMessage(M_GETDATA, D_ATMOSPHERIC_O3,
                                              message_data(runToDate))
                                .value(U_DU_O3);
       const double fo3_trop = 0.042 * ozone;
-      forcings[D_RF_O3_TROP].set(fo3_trop, U_W_M2);
+      forcings[agent_index[RF_O3_TROP]] = fo3_trop;
     }
 
     // ---------- Halocarbons ----------
-    boost::array<string, 26> halos = {
-        {D_RF_CF4,      D_RF_C2F6,      D_RF_HFC23,     D_RF_HFC32,
-         D_RF_HFC4310,  D_RF_HFC125,    D_RF_HFC134a,   D_RF_HFC143a,
-         D_RF_HFC227ea, D_RF_HFC245fa,  D_RF_SF6,       D_RF_CFC11,
-         D_RF_CFC12,    D_RF_CFC113,    D_RF_CFC114,    D_RF_CFC115,
-         D_RF_CCl4,     D_RF_CH3CCl3,   D_RF_HCFC22,    D_RF_HCFC141b,
-         D_RF_HCFC142b, D_RF_halon1211, D_RF_halon1301, D_RF_halon2402,
-         D_RF_CH3Cl,    D_RF_CH3Br}};
-
-    // Halocarbons can be disabled individually via the input file, so we run
-    // through all possible ones
-    for (auto hc : halos) {
-      if (core->checkCapability(hc)) {
-        // Forcing values are actually computed by the halocarbon itself
-        forcings[hc] =
-            core->sendMessage(M_GETDATA, hc, message_data(runToDate));
+    // Forcing values are actually computed by the halocarbons themselves.
+    // If they are run by the halocarbon engine (which has already run this
+    // year), read all of them from it directly.
+    if (const HalocarbonEngine *engine = core->getHalocarbonEngine()) {
+      for (size_t i = 0; i < engine->size(); ++i) {
+        forcings[halo_index[i]] = engine->getForcing(i);
+      }
+    } else {
+      for (size_t i = 0; i < halo_index.size(); ++i) {
+        forcings[halo_index[i]] =
+            core->sendMessage(M_GETDATA, forcing_names[halo_index[i]],
+                              message_data(runToDate))
+                .value(U_W_M2);
       }
     }
 
     // Aerosols
-    if (core->checkCapability(D_EMISSIONS_BC) &&
-        core->checkCapability(D_EMISSIONS_OC) &&
-        core->checkCapability(D_EMISSIONS_SO2) &&
-        core->checkCapability(D_EMISSIONS_NH3)) {
+    const ShortLivedForcerEngine *slf = core->getShortLivedForcerEngine();
+    if (agent_index[RF_BC] < 0) {
+      // Aerosols aren't enabled
+    } else if (slf) {
+      // The engine has already computed these for the whole run
+      double rf[ShortLivedForcerEngine::N_AEROSOL_FORCINGS];
+      slf->getAerosolForcings(runToDate, rf);
+      forcings[agent_index[RF_BC]] = rf[ShortLivedForcerEngine::RF_BC];
+      forcings[agent_index[RF_OC]] = rf[ShortLivedForcerEngine::RF_OC];
+      forcings[agent_index[RF_SO2]] = rf[ShortLivedForcerEngine::RF_SO2];
+      forcings[agent_index[RF_NH3]] = rf[ShortLivedForcerEngine::RF_NH3];
+      forcings[agent_index[RF_ACI]] = rf[ShortLivedForcerEngine::RF_ACI];
+    } else {
 
       // Aerosol-Radiation Interactions (RFari)
       // RFari was calculated using a simple linear relationship to emissions of
@@ -434,64 +570,61 @@ void ForcingComponent::run(const double runToDate) {
       double E_BC =
           core->sendMessage(M_GETDATA, D_EMISSIONS_BC, message_data(runToDate))
               .value(U_TG);
-      double fbc = alpha.value(U_UNITLESS) * rho_bc * E_BC;
-      forcings[D_RF_BC].set(fbc, U_W_M2);
+      forcings[agent_index[RF_BC]] = ariForcing(rho_bc, E_BC);
 
       // ---------- Organic carbon ----------
       double E_OC =
           core->sendMessage(M_GETDATA, D_EMISSIONS_OC, message_data(runToDate))
               .value(U_TG);
-        double foc = alpha.value(U_UNITLESS) * rho_oc * E_OC;
-      forcings[D_RF_OC].set(foc, U_W_M2);
+      forcings[agent_index[RF_OC]] = ariForcing(rho_oc, E_OC);
 
       // ---------- Sulphate Aerosols ----------
-      unitval SO2_emission = core->sendMessage(M_GETDATA, D_EMISSIONS_SO2,
-                                               message_data(runToDate));
-      double fso2 = alpha.value(U_UNITLESS) * rho_so2 * SO2_emission.value(U_GG_S);
-      forcings[D_RF_SO2].set(fso2, U_W_M2);
+      double E_SO2 =
+          core->sendMessage(M_GETDATA, D_EMISSIONS_SO2, message_data(runToDate))
+              .value(U_GG_S);
+      forcings[agent_index[RF_SO2]] = ariForcing(rho_so2, E_SO2);
 
       // ---------- NH3 ----------
       double E_NH3 =
           core->sendMessage(M_GETDATA, D_EMISSIONS_NH3, message_data(runToDate))
               .value(U_TG);
-      double fnh3 = alpha.value(U_UNITLESS) * rho_nh3 * E_NH3;
-      forcings[D_RF_NH3].set(fnh3, U_W_M2);
+      forcings[agent_index[RF_NH3]] = ariForcing(rho_nh3, E_NH3);
 
       // ---------- RFaci ----------
-      // ERF from aerosol-cloud interactions (RFaci)
-      // Based on Equation 7.SM.1.2 from IPCC AR6 where
-      // The 0.2 value comes from equally distributing the alpha scalar to all 5
-      // aerosol RF types.
-        double aci_rf =
-            alpha.value(U_UNITLESS) * (-1 * aci_beta *
-            log(1 + (SO2_emission / s_SO2) + ((E_BC + E_OC) / s_BCOC)));
-      forcings[D_RF_ACI].set(aci_rf, U_W_M2);
+      forcings[agent_index[RF_ACI]] = aciForcing(E_SO2, E_BC, E_OC);
     }
 
     // ---------- Terrestrial albedo ----------
-    if (core->checkCapability(D_RF_T_ALBEDO)) {
-      forcings[D_RF_T_ALBEDO] =
-          core->sendMessage(M_GETDATA, D_RF_T_ALBEDO, message_data(runToDate));
+    if (agent_index[RF_ALBEDO] >= 0) {
+      forcings[agent_index[RF_ALBEDO]] =
+          core->sendMessage(M_GETDATA, D_RF_T_ALBEDO, message_data(runToDate))
+              .value(U_W_M2);
     }
 
     // ---------- Volcanic forcings ----------
-    if (core->checkCapability(D_VOLCANIC_SO2)) {
+    if (agent_index[RF_VOL] < 0) {
+      // No volcanic forcing
+    } else if (slf) {
+      forcings[agent_index[RF_VOL]] = slf->getVolcanicForcing(runToDate);
+    } else {
       // The volcanic forcings are read in from an ini file.
-      forcings[D_RF_VOL] =
-          volscl.value(U_UNITLESS) *
-          core->sendMessage(M_GETDATA, D_VOLCANIC_SO2, message_data(runToDate));
+      forcings[agent_index[RF_VOL]] = volcanicForcing(
+          core->sendMessage(M_GETDATA, D_VOLCANIC_SO2, message_data(runToDate))
+              .value(U_W_M2));
     }
 
     // ---------- Miscellaneous forcings ----------
     // Miscellaneous forcings read in from an ini file.
-    forcings[D_RF_MISC] = Fmisc_ts.get(runToDate);
+    forcings[agent_index[RF_MISC]] = Fmisc_ts.get(runToDate).value(U_W_M2);
 
     // ---------- Total ----------
     // Calculate based as the sum of the different radiative forcings or as the
     // user supplied constraint.
-    unitval Ftot(0.0, U_W_M2); // W/m2
-    for (auto f : forcings) {
-      Ftot = Ftot + f.second;
+    double Ftot = 0.0; // W/m2
+    for (size_t i = 0; i < forcings.size(); ++i) {
+      if (i != total_index) {
+        Ftot = Ftot + forcings[i];
+      }
     }
 
     // Otherwise if the user has supplied total forcing data, use that instead.
@@ -499,9 +632,9 @@ void ForcingComponent::run(const double runToDate) {
       H_LOG(logger, Logger::WARNING)
           << "** Overwriting total forcing with user-supplied value"
           << std::endl;
-      forcings[D_RF_TOTAL] = Ftot_constrain.get(runToDate);
+      forcings[total_index] = Ftot_constrain.get(runToDate).value(U_W_M2);
     } else {
-      forcings[D_RF_TOTAL] = Ftot;
+      forcings[total_index] = Ftot;
     }
 
     //---------- Change to relative forcing ----------
@@ -514,17 +647,19 @@ void ForcingComponent::run(const double runToDate) {
           << "** At base year! Storing current forcing values" << std::endl;
       baseyear_forcings = forcings;
     }
+    H_ASSERT(baseyear_forcings.size() == forcings.size(),
+             "base year forcings have not been computed");
 
     // Subtract base year forcing values from forcings, i.e. make them relative
     // to base year
-    for (auto f : forcings) {
-      forcings[f.first] = f.second - baseyear_forcings[f.first];
+    for (size_t i = 0; i < forcings.size(); ++i) {
       H_LOG(logger, Logger::DEBUG)
-          << "forcing " << f.first << " in " << runToDate << " is " << f.second
-          << std::endl;
+          << "forcing " << forcing_names[i] << " in " << runToDate << " is "
+          << forcings[i] << std::endl;
+      forcings[i] = forcings[i] - baseyear_forcings[i];
     }
     H_LOG(logger, Logger::DEBUG)
-        << "forcing total is " << forcings[D_RF_TOTAL] << std::endl;
+        << "forcing total is " << forcings[total_index] << std::endl;
 
     // Store the forcings that we have calculated
     forcings_ts.set(runToDate, forcings);
@@ -572,27 +707,56 @@ unitval ForcingComponent::getData(const std::string &varName,
     }
 
     // Look up the forcing name and value
-    forcings_t forcings(forcings_ts.get(getdate));
-
-    std::string forcing_name;
-    auto forcit = forcing_name_map.find(varName);
-    if (forcit != forcing_name_map.end()) {
-      forcing_name = forcing_name_map[varName];
-    } else {
-      forcing_name = varName;
-    }
-    std::map<std::string, unitval>::const_iterator forcing =
-        forcings.find(forcing_name);
-    if (forcing != forcings.end()) {
-      returnval = forcing->second; // from the forcing map
-    } else {
+    size_t index;
+    if (!findForcing(varName, index)) {
       H_THROW("Caller is requesting unknown variable: " + varName);
     }
+    returnval.set(forcings_ts.get(getdate)[index], U_W_M2);
   }
 
   return returnval;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Find the position of a forcing in forcing_names.
+ *  \param varName The forcing, which for halocarbons may be the adjusted
+ *                 forcing's name.
+ *  \param index   (output) Its position.
+ *  \returns Whether varName is a forcing computed each year.
+ */
+bool ForcingComponent::findForcing(const std::string &varName,
+                                   size_t &index) const {
+  auto forcit = forcing_name_map.find(varName);
+  const std::string &forcing_name =
+      forcit != forcing_name_map.end() ? forcit->second : varName;
+  auto forcing = forcing_index.find(forcing_name);
+  if (forcing == forcing_index.end()) {
+    return false;
+  }
+  index = forcing->second;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// documentation is inherited
+void ForcingComponent::getDataSeries(const std::string &varName,
+                                     const std::vector<double> &dates,
+                                     std::vector<unitval> &values) {
+  size_t index;
+  if (!findForcing(varName, index)) {
+    // A parameter, or an unknown variable
+    IModelComponent::getDataSeries(varName, dates, values);
+    return;
+  }
+
+  values.resize(dates.size());
+  for (size_t i = 0; i < dates.size(); ++i) {
+    H_ASSERT(dates[i] != Core::undefinedIndex(), "Date required for " + varName);
+    values[i] = unitval(
+        dates[i] < baseyear ? 0.0 : forcings_ts.get(dates[i])[index], U_W_M2);
+  }
+}
+
 //------------------------------------------------------------------------------
 // documentation is inherited
 void ForcingComponent::reset(double time) {
@@ -600,6 +764,7 @@ void ForcingComponent::reset(double time) {
   // year.
   currentYear = time;
   forcings_ts.truncate(time);
+  cachePreindustrial();
   H_LOG(logger, Logger::NOTICE)
       << getComponentName() << " reset to time= " << time << "\n";
 }
@@ -12,6 +12,10 @@
  *
  */
 
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
 #include "h_util.hpp"
 #include "h_exception.hpp"
 
@@ -81,4 +85,53 @@ void ensure_dir_exists(const std::string &dir) {
 #endif
 }
 
+/*!
+ * \brief Cut a file down to the given size.
+ * \param path The file, which mustn't be open for writing.
+ * \param size Its new size in bytes, no larger than its current size.
+ */
+void truncate_file(const std::string &path, const std::uintmax_t size) {
+#ifdef USE_RCPP
+  // Read back what's kept, and write it over the file
+  string kept(size, '\0');
+  ifstream in(path.c_str(), ios::binary);
+  in.read(&kept[0], kept.size());
+  H_ASSERT(in.gcount() == static_cast<streamsize>(kept.size()),
+           "could not read back " + path);
+  in.close();
+  ofstream out(path.c_str(), ios::binary | ios::trunc);
+  out.write(kept.data(), kept.size());
+  H_ASSERT(out.good(), "could not rewrite " + path);
+#else
+  fs_error_code status;
+  fs::resize_file(fs::path(path), size, status);
+  if (status) {
+    H_THROW("Could not truncate " + path + ": " + status.message());
+  }
+#endif
+}
+
+/*!
+ * \brief Append a number to a string, formatted as an output stream with
+ *        default flags and the given precision would format it.
+ * \param s         The string to append to.
+ * \param x         The number.
+ * \param precision Significant digits, as for std::ostream::precision().
+ */
+void append_double(std::string &s, const double x, const int precision) {
+#ifdef __cpp_lib_to_chars
+  if (precision >= 0 && precision <= 40) {
+    char digits[64];
+    const to_chars_result r = to_chars(digits, digits + sizeof(digits), x,
+                                       chars_format::general, precision);
+    s.append(digits, r.ptr);
+    return;
+  }
+#endif
+  ostringstream formatted;
+  formatted.precision(precision);
+  formatted << x;
+  s += formatted.str();
+}
+
 } // namespace Hector
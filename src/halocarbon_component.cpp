@@ -24,6 +24,7 @@
 #include "core.hpp"
 #include "h_util.hpp"
 #include "halocarbon_component.hpp"
+#include "halocarbon_engine.hpp"
 
 namespace Hector {
 
@@ -32,7 +33,8 @@ using namespace std;
 //------------------------------------------------------------------------------
 /*! \brief Constructor
  */
-HalocarbonComponent::HalocarbonComponent(std::string g) : tau(-1) {
+HalocarbonComponent::HalocarbonComponent(std::string g)
+    : tau(-1), engine(NULL) {
   myGasName = g;
 }
 
@@ -50,9 +52,7 @@ string HalocarbonComponent::getComponentName() const {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void HalocarbonComponent::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   //    concentration.name = myGasName;
   core = coreptr;
 
@@ -119,6 +119,9 @@ void HalocarbonComponent::setData(const string &varName,
                                   const message_data &data) {
   H_LOG(logger, Logger::DEBUG) << "Setting " << varName << "[" << data.date
                                << "]=" << data.value_str << std::endl;
+  if (engine) {
+    engine->invalidate();
+  }
 
   try {
     const string emiss_var_name = myGasName + EMISSIONS_EXTENSION;
@@ -170,6 +173,10 @@ void HalocarbonComponent::prepareToRun() {
       "bad delta value"); // delta is a paramter that must be between -1 and 1
 
   Ha_ts.set(oldDate, H0);
+  aheadDate = oldDate;
+  if (engine) {
+    engine->invalidate();
+  }
 
   //! \remark concentration values will not be allowed to interpolate beyond
   //! years already read in
@@ -179,9 +186,18 @@ void HalocarbonComponent::prepareToRun() {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void HalocarbonComponent::run(const double runToDate) {
-  H_ASSERT(!core->inSpinup() && runToDate - oldDate == 1,
-           "timestep must equal 1");
-#define AtmosphereDryAirConstant 1.8
+  if (engine) {
+    // The core has already run the engine for this year
+    H_ASSERT(oldDate == runToDate, "halocarbon engine has not been run");
+    return;
+  }
+  H_CHECK(!core->inSpinup() && runToDate - oldDate == 1,
+          "timestep must equal 1");
+  if (runToDate <= aheadDate) {
+    // Already computed by runAhead()
+    oldDate = runToDate;
+    return;
+  }
 
   unitval Ha(Ha_ts.get(oldDate));
 
@@ -190,44 +206,63 @@ void HalocarbonComponent::run(const double runToDate) {
     // Concentration-forced. Just grab the current value from the time series.
     Ha = Ha_constrain.get(runToDate);
   } else {
-    const double timestep = 1.0;
-    const double alpha = 1 / tau;
-
-    // Compute the delta atmospheric concentration from current emissions
-    double emissMol = emissions.get(runToDate).value(U_GG) / molarMass *
-                      timestep; // this is in U_GMOL
-    unitval concDeltaEmiss;
-    concDeltaEmiss.set(emissMol / (0.1 * AtmosphereDryAirConstant), U_PPTV);
-
-    // Update the atmospheric concentration, accounting for this delta and
-    // exponential decay
-    double expfac = exp(-alpha);
-    Ha = Ha * expfac + concDeltaEmiss * tau * (1.0 - expfac);
+    Ha.set(step(Ha.value(U_PPTV), emissions.get(runToDate).value(U_GG),
+                molarMass, tau, decayFactor(tau)),
+           U_PPTV);
   }
 
   H_LOG(logger, Logger::DEBUG)
       << "date: " << runToDate << " concentration: " << Ha << endl;
-  Ha_ts.set(runToDate, Ha);
-
-  // Calculate radiative forcing
-  double adjusted_rf;
-  double rf_unadjusted;
-  unitval rf;
-
-  // First calculate the stratospheric-temperature adjusted radiative
-  // efficiencies using parameter values from IPCC AR6 & Equation 16 from Hartin
-  // 2015.
-  rf_unadjusted = rho.value(U_W_M2_PPTV) * Ha.value(U_PPTV);
-  // Now calculate the effective radiative forcing value by adjusting the
-  // radiative forcing by the tropospheric adjustments (the delta parameter).
-  adjusted_rf = rf_unadjusted + delta.value(U_UNITLESS) * rf_unadjusted;
-  rf.set(adjusted_rf, U_W_M2);
-  hc_forcing.set(runToDate, rf);
+  storeConcentration(runToDate, Ha);
 
   // Update time counter.
   oldDate = runToDate;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief If the concentration is constrained for every year from firstDate
+ *         to lastDate, compute all of those years now.
+ *  \details With the halocarbon engine, the engine does this instead.
+ */
+bool HalocarbonComponent::runAhead(const double firstDate,
+                                   const double lastDate) {
+  aheadDate = firstDate - 1;
+  if (engine || !Ha_constrain.size()) {
+    return false;
+  }
+  for (double date = firstDate; date <= lastDate; date += 1.0) {
+    if (!Ha_constrain.exists(date)) {
+      return false;
+    }
+  }
+  for (double date = firstDate; date <= lastDate; date += 1.0) {
+    storeConcentration(date, Ha_constrain.get(date));
+  }
+  aheadDate = lastDate;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Store the concentration for a date, and compute its forcing.
+ */
+void HalocarbonComponent::storeConcentration(const double date,
+                                             const unitval &Ha) {
+  Ha_ts.set(date, Ha);
+
+  // Calculate radiative forcing
+  hc_forcing.set(date, unitval(forcing(Ha.value(U_PPTV), rho.value(U_W_M2_PPTV),
+                                       delta.value(U_UNITLESS)),
+                               U_W_M2));
+}
+
+//------------------------------------------------------------------------------
+/*! \brief The fraction of a concentration left after a year, exp(-1/tau).
+ */
+double HalocarbonComponent::decayFactor(const double tau) {
+  const double alpha = 1 / tau;
+  return exp(-alpha);
+}
+
 //------------------------------------------------------------------------------
 // documentation is inherited
 unitval HalocarbonComponent::getData(const std::string &varName,
@@ -290,8 +325,12 @@ unitval HalocarbonComponent::getData(const std::string &varName,
 void HalocarbonComponent::reset(double time) {
   // reset time counter and truncate outputs
   oldDate = time;
+  aheadDate = time;
   hc_forcing.truncate(time);
   Ha_ts.truncate(time);
+  if (engine) {
+    engine->invalidate();
+  }
   H_LOG(logger, Logger::NOTICE)
       << getComponentName() << " reset to time= " << time << "\n";
 }
@@ -0,0 +1,153 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  halocarbon_engine.cpp
+ *  hector
+ *
+ *  Advance all halocarbon species together.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "component_data.hpp"
+#include "core.hpp"
+#include "h_exception.hpp"
+#include "halocarbon_component.hpp"
+#include "halocarbon_engine.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+/*! \brief Constructor; attaches the engine to the halocarbon components.
+ *  \param core The core that owns the components.
+ *  \param hcs  The halocarbon components to run.  From now on they are run by
+ *              the engine rather than by their own run().
+ */
+HalocarbonEngine::HalocarbonEngine(Core *core,
+                                   const vector<HalocarbonComponent *> &hcs)
+    : core(core), species(hcs), firstDate(0.0), lastTableDate(-1.0),
+      lastDate(0.0), stale(true) {
+  const size_t n = species.size();
+  tau.resize(n);
+  expfac.resize(n);
+  molarMass.resize(n);
+  rho.resize(n);
+  delta.resize(n);
+  conc.resize(n);
+  forcing.resize(n);
+  for (auto hc : species) {
+    hc->engine = this;
+    forcingNames.push_back(D_RF_PREFIX + hc->myGasName);
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Advance all species by one year.
+ *  \details Each species uses HalocarbonComponent::step() and
+ *           HalocarbonComponent::forcing(), as its own run() does, so the
+ *           results are identical.
+ */
+void HalocarbonEngine::run(const double runToDate) {
+  if (stale || runToDate < firstDate) {
+    load(runToDate);
+  } else if (runToDate > lastTableDate) {
+    extend(runToDate);
+  }
+  H_ASSERT(!core->inSpinup() && runToDate - lastDate == 1,
+           "timestep must equal 1");
+
+  const size_t n = species.size();
+  const size_t row = static_cast<size_t>(runToDate - firstDate) * n;
+  const double *E = &emissions[row];
+  const double *C = &constraints[row];
+
+  for (size_t i = 0; i < n; ++i) {
+    const double decayed = HalocarbonComponent::step(
+        conc[i], E[i], molarMass[i], tau[i], expfac[i]);
+    const double Ha = std::isnan(C[i]) ? decayed : C[i];
+    conc[i] = Ha;
+    forcing[i] = HalocarbonComponent::forcing(Ha, rho[i], delta[i]);
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    HalocarbonComponent *hc = species[i];
+    if (std::isnan(conc[i])) {
+      // The emissions weren't available; let the time series say why
+      hc->emissions.get(runToDate);
+      H_THROW("No emissions for " + hc->getComponentName());
+    }
+    hc->Ha_ts.set(runToDate, unitval(conc[i], U_PPTV));
+    hc->hc_forcing.set(runToDate, unitval(forcing[i], U_W_M2));
+    hc->oldDate = runToDate;
+  }
+  lastDate = runToDate;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Read parameters and state from the components, and tabulate their
+ *         inputs from runToDate through the end of the run.
+ */
+void HalocarbonEngine::load(const double runToDate) {
+  const size_t n = species.size();
+
+  for (size_t i = 0; i < n; ++i) {
+    const HalocarbonComponent *hc = species[i];
+    H_ASSERT(hc->oldDate == species[0]->oldDate,
+             "halocarbons are not all at the same date");
+    tau[i] = hc->tau;
+    expfac[i] = HalocarbonComponent::decayFactor(tau[i]);
+    molarMass[i] = hc->molarMass;
+    rho[i] = hc->rho.value(U_W_M2_PPTV);
+    delta[i] = hc->delta.value(U_UNITLESS);
+    conc[i] = hc->Ha_ts.get(hc->oldDate).value(U_PPTV);
+  }
+  lastDate = n ? species[0]->oldDate : runToDate - 1;
+
+  firstDate = runToDate;
+  emissions.clear();
+  constraints.clear();
+  lastTableDate = firstDate - 1;
+  extend(max(runToDate, core->getEndDate()));
+  stale = false;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Add rows to the tables through newLastDate.
+ *  \details Rows already tabulated are kept, so running past the end date
+ *           costs one row per year.
+ */
+void HalocarbonEngine::extend(const double newLastDate) {
+  const size_t n = species.size();
+  const size_t first = static_cast<size_t>(lastTableDate + 1 - firstDate);
+  const size_t nyears = static_cast<size_t>(newLastDate - firstDate) + 1;
+  const double nan = numeric_limits<double>::quiet_NaN();
+  emissions.resize(nyears * n, nan);
+  constraints.resize(nyears * n, nan);
+  for (size_t y = first; y < nyears; ++y) {
+    const double date = firstDate + y;
+    for (size_t i = 0; i < n; ++i) {
+      const HalocarbonComponent *hc = species[i];
+      if (hc->Ha_constrain.size() && hc->Ha_constrain.exists(date)) {
+        constraints[y * n + i] = hc->Ha_constrain.get(date).value(U_PPTV);
+      } else {
+        try {
+          emissions[y * n + i] = hc->emissions.get(date).value(U_GG);
+        } catch (h_exception &) {
+          // Only an error if we get as far as this date; see run()
+        }
+      }
+    }
+  }
+  lastTableDate = newLastDate;
+}
+
+} // namespace Hector
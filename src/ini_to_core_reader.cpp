@@ -23,18 +23,18 @@
 #include <boost/lexical_cast.hpp>
 #pragma clang diagnostic pop
 
-// If using the R package, use Rcpp to call R's file processing
-// functions. Otherwise (e.g. if building standalone Hector),
-// use std::filesystem (which is available since the C++ 17 standard)
-// if available and finally fall back to boost::filesystem (which
+// Table paths are resolved with std::filesystem (available since the C++ 17
+// standard) if available, so that reading an INI file from R never calls back
+// into the R interpreter. Otherwise, the R package uses R's file processing
+// functions, and standalone Hector falls back to boost::filesystem (which
 // needs to be installed).
-#ifdef USE_RCPP
-// some Rcpp code generates deprecated warnings under clang; ignore
-#include <Rcpp.h>
-
-#elif __cpp_lib_filesystem || __has_include(<filesystem>)
+#if __cpp_lib_filesystem || __has_include(<filesystem>)
 #include <filesystem>
 namespace fs = std::filesystem;
+#elif defined(USE_RCPP)
+// some Rcpp code generates deprecated warnings under clang; ignore
+#include <Rcpp.h>
+#define TABLE_PATHS_FROM_R
 #else
 #include <boost/filesystem.hpp>
 namespace fs = boost::filesystem;
@@ -50,6 +50,40 @@ namespace Hector {
 
 using namespace std;
 
+//------------------------------------------------------------------------------
+/*! \brief Find a table file named in an INI file.
+ *
+ *  If the given path (absolute or relative) points to a file that exists, use
+ *  that.  Otherwise, assume that the path is relative to the INI file's
+ *  directory.
+ *
+ *  \param csvFileName The path given in the INI file.
+ *  \param iniFilePath The path to the INI file.
+ *  \return The path to the table.
+ */
+string INIToCoreReader::findTable(const string &csvFileName,
+                                  const string &iniFilePath) {
+#ifdef TABLE_PATHS_FROM_R
+  Rcpp::Environment base("package:base");
+  Rcpp::Function normalizePath = base["normalizePath"];
+  Rcpp::Function dirname = base["dirname"];
+  Rcpp::Function filepath = base["file.path"];
+  Rcpp::Function fileexists = base["file.exists"];
+  if (!Rcpp::as<bool>(fileexists(csvFileName))) {
+    Rcpp::String parentPath = dirname(normalizePath(iniFilePath));
+    return Rcpp::as<string>(filepath(parentPath, csvFileName));
+  }
+  return csvFileName;
+#else
+  fs::path csvFilePath(csvFileName);
+  if (!fs::exists(csvFilePath)) {
+    fs::path fullPath(fs::path(iniFilePath).parent_path() / csvFilePath);
+    return fullPath.string();
+  }
+  return csvFileName;
+#endif
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Constructor
  *
@@ -74,6 +108,7 @@ INIToCoreReader::~INIToCoreReader() {}
 void INIToCoreReader::parse(const string &filename) {
   iniFilePath = filename;
   int errorCode = ini_parse(filename.c_str(), valueHandler, this);
+  tables.clear();
 
   // handle c errors by turning them into exceptions which can be handled later
   if (errorCode == -1) {
@@ -99,15 +134,6 @@ void INIToCoreReader::parse(const string &filename) {
  */
 int INIToCoreReader::valueHandler(void *user, const char *section,
                                   const char *name, const char *value) {
-#ifdef USE_RCPP
-  // Load R functions for path management
-  Rcpp::Environment base("package:base");
-  Rcpp::Function normalizePath = base["normalizePath"];
-  Rcpp::Function dirname = base["dirname"];
-  Rcpp::Function filepath = base["file.path"];
-  Rcpp::Function fileexists = base["file.exists"];
-#endif
-
   static const string csvFilePrefix = "csv:";
   INIToCoreReader *reader = (INIToCoreReader *)user;
 
@@ -138,33 +164,12 @@ int INIToCoreReader::valueHandler(void *user, const char *section,
       // to process
       string csvFileName(valueStr.begin() + csvFilePrefix.size(),
                          valueStr.end());
-#ifdef USE_RCPP
-      // ANS: This is the algorithm used if Hector is compiled
-      // as an R package.
-      //
-      // If the csvFileName normalizes to a real path, use that.
-      // Otherwise, assume that it is pointing to a file in the
-      // same directory as the INI file.
-      //  csvFileName = Rcpp::as<string>(filepath(csvFileName));
-      if (!Rcpp::as<bool>(fileexists(csvFileName))) {
-        Rcpp::String parentPath = dirname(normalizePath(reader->iniFilePath));
-        csvFileName = Rcpp::as<string>(filepath(parentPath, csvFileName));
+      unique_ptr<CSVTableReader> &tableReader = reader->tables[csvFileName];
+      if (!tableReader) {
+        tableReader.reset(new CSVTableReader(
+            findTable(csvFileName, reader->iniFilePath)));
       }
-#else
-      // ANS:: Algorithm for standalone Hector. Same logic -- if
-      // the given path (absolute or relative) points to a file
-      // that exists, use that. Otherwise, assume that the path
-      // is relative to the INI file's directory.
-      fs::path csvFilePath(csvFileName);
-      if (!fs::exists(csvFilePath)) {
-        fs::path iniFilePath(reader->iniFilePath);
-        fs::path fullPath(iniFilePath.parent_path() / csvFilePath);
-        csvFileName = fullPath.string();
-      }
-#endif
-
-      CSVTableReader tableReader(csvFileName);
-      tableReader.process(reader->core, section, nameStr);
+      tableReader->process(reader->core, section, nameStr);
     } else {
       // the typical variableName = value case
       // note that this implies name is not a time series variable and the
@@ -0,0 +1,197 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  linear_temperature_response.cpp
+ *  hector
+ *
+ *  Temperature trajectories for given forcing, by impulse response.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+// The MinGW C++ compiler doesn't seem to pull in the cmath constants? (see
+// #384) As a workaround, we define M_PI here if needed
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "h_exception.hpp"
+#include "linear_temperature_response.hpp"
+#include "temperature_component.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+vector<double> LinearTemperatureResponse::Trajectories::*const
+    LinearTemperatureResponse::OUTPUTS[N_OUTPUTS] = {
+        &Trajectories::temp,           &Trajectories::temp_surface,
+        &Trajectories::temp_landair,   &Trajectories::temp_sst,
+        &Trajectories::heatflux_mixed, &Trajectories::heatflux_interior,
+        &Trajectories::heat_mixed,     &Trajectories::heat_interior};
+
+//------------------------------------------------------------------------------
+/*! \brief Take the impulse responses of a temperature component.
+ *  \param temperature A component that has been prepared to run; its
+ *                     parameters (climate sensitivity, diffusivity, etc.)
+ *                     are the ones used.
+ *  \exception h_exception If the component hasn't been prepared, or has a
+ *             temperature constraint (which makes its response nonlinear).
+ */
+LinearTemperatureResponse::LinearTemperatureResponse(
+    const TemperatureComponent &temperature)
+    : ns(temperature.doeclim.ns), doeclim(temperature.doeclim) {
+  H_ASSERT(doeclim.Ker && doeclim.Ker->size() == ns,
+           "temperature component has not been prepared to run");
+  H_ASSERT(!temperature.tas_constrain.size(),
+           "temperature is constrained, so its response is not linear");
+
+  nfft = 1;
+  while (nfft < 2 * ns) {
+    nfft *= 2;
+  }
+  twiddles.resize(nfft / 2);
+  for (size_t k = 0; k < nfft / 2; ++k) {
+    twiddles[k] = polar(1.0, -2.0 * M_PI * k / nfft);
+  }
+
+  // Step the model with a unit input to each box in the first year; the
+  // responses start from there
+  for (int box = 0; box < 2; ++box) {
+    vector<double> u1(ns, 0.0), u2(ns, 0.0);
+    if (ns > 1) {
+      (box == 0 ? u1 : u2)[1] = 1.0;
+    }
+    Trajectories impulse;
+    simulate(u1, u2, impulse);
+    for (int y = 0; y < N_OUTPUTS; ++y) {
+      const vector<double> &r = impulse.*OUTPUTS[y];
+      vector<complex> &rhat = response[y][box];
+      rhat.assign(nfft, 0.0);
+      for (size_t k = 1; k < ns; ++k) {
+        rhat[k - 1] = r[k];
+      }
+      fft(rhat, false);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Compute trajectories for a forcing pathway.
+ *  \param forcing Total forcing (W/m2) by year, from the start date.  As in
+ *                 the model, each year's temperatures depend on the forcing
+ *                 in that year and the one before.  The model never runs
+ *                 its start date, and so takes the forcing then as zero; to
+ *                 reproduce a model run, forcing[0] should be zero too.
+ *  \param out     The trajectories, as long as forcing.
+ *  \exception h_exception If forcing has more years than the model run.
+ */
+void LinearTemperatureResponse::compute(const vector<double> &forcing,
+                                        Trajectories &out) const {
+  const size_t n = forcing.size();
+  H_ASSERT(n <= ns, "forcing has more years than the model run");
+  for (auto member : OUTPUTS) {
+    (out.*member).assign(n, 0.0);
+  }
+  if (n < 2) {
+    return;
+  }
+
+  // Inputs to the land and ocean boxes, as in TemperatureComponent::run(),
+  // packed into one complex series to transform them together
+  vector<complex> z(nfft, 0.0);
+  for (size_t t = 1; t < n; ++t) {
+    double DQ1, DQ2;
+    doeclim.inputs(forcing[t], forcing[t - 1], DQ1, DQ2);
+    z[t] = complex(DQ1, DQ2);
+  }
+  fft(z, false);
+
+  // Separate the transforms of the two inputs
+  vector<complex> U1(nfft), U2(nfft);
+  for (size_t k = 0; k < nfft; ++k) {
+    const complex zc = conj(z[(nfft - k) % nfft]);
+    U1[k] = 0.5 * (z[k] + zc);
+    U2[k] = complex(0.0, -0.5) * (z[k] - zc);
+  }
+
+  // Outputs are real, so transform them back two at a time
+  vector<complex> v(nfft);
+  for (int y = 0; y < N_OUTPUTS; y += 2) {
+    for (size_t k = 0; k < nfft; ++k) {
+      const complex a = response[y][0][k] * U1[k] + response[y][1][k] * U2[k];
+      const complex b =
+          response[y + 1][0][k] * U1[k] + response[y + 1][1][k] * U2[k];
+      v[k] = a + complex(0.0, 1.0) * b;
+    }
+    fft(v, true);
+    vector<double> &a = out.*OUTPUTS[y];
+    vector<double> &b = out.*OUTPUTS[y + 1];
+    for (size_t t = 1; t < n; ++t) {
+      a[t] = v[t].real() / nfft;
+      b[t] = v[t].imag() / nfft;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Step the model equations (see DOECLIM) for given inputs to the
+ *         land (u1) and ocean (u2) boxes.
+ *  \details This costs O(n^2), so it's only used to find the responses.
+ */
+void LinearTemperatureResponse::simulate(const vector<double> &u1,
+                                         const vector<double> &u2,
+                                         Trajectories &out) const {
+  const size_t n = u1.size();
+  for (auto member : OUTPUTS) {
+    (out.*member).assign(n, 0.0);
+  }
+  for (size_t tstep = 1; tstep < n; ++tstep) {
+    doeclim.solve(tstep, u1[tstep], u2[tstep], out.temp_landair, out.temp_sst);
+    out.temp[tstep] =
+        doeclim.airTemperature(out.temp_landair[tstep], out.temp_sst[tstep]);
+    out.temp_surface[tstep] = doeclim.surfaceTemperature(
+        out.temp_landair[tstep], out.temp_sst[tstep]);
+    doeclim.heatFlux(tstep, out.temp_sst, out.heatflux_mixed,
+                     out.heatflux_interior, out.heat_mixed, out.heat_interior);
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief In-place radix-2 FFT of a series of length nfft.
+ *  \param inverse If true, the inverse transform, without the 1/nfft factor.
+ */
+void LinearTemperatureResponse::fft(vector<complex> &a,
+                                    const bool inverse) const {
+  const size_t n = a.size();
+  for (size_t i = 1, j = 0; i < n; ++i) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      swap(a[i], a[j]);
+    }
+  }
+  for (size_t len = 2; len <= n; len <<= 1) {
+    const size_t step = n / len;
+    for (size_t i = 0; i < n; i += len) {
+      for (size_t k = 0; k < len / 2; ++k) {
+        const complex w = inverse ? conj(twiddles[k * step]) : twiddles[k * step];
+        const complex x = a[i + k];
+        const complex y = a[i + k + len / 2] * w;
+        a[i + k] = x + y;
+        a[i + k + len / 2] = x - y;
+      }
+    }
+  }
+}
+
+} // namespace Hector
@@ -0,0 +1,291 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  log_writer.cpp
+ *  hector
+ *
+ *  Background thread that does the file I/O for all loggers.
+ *
+ */
+
+#include <algorithm>
+#include <new>
+
+#include <pthread.h>
+
+#include "log_writer.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+namespace {
+//! Set once the writer has been destroyed at program exit, after which
+//! loggers that are still open have to close their own files.
+bool writerDestroyed = false;
+} // namespace
+
+//------------------------------------------------------------------------------
+/*! \brief The writer shared by all loggers.
+ *  \details The writer thread is started the first time this is called.
+ */
+LogWriter &LogWriter::instance() {
+  static LogWriter writer;
+  return writer;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Constructor; starts the writer thread.
+ */
+LogWriter::LogWriter()
+    : slots(capacity), enqueuePos(0), dequeuePos(0), written(0),
+      sleeping(false), stopping(false) {
+  for (size_t i = 0; i < capacity; ++i) {
+    slots[i].sequence.store(i, memory_order_relaxed);
+    slots[i].file = NULL;
+    slots[i].closeFile = false;
+  }
+  thread = std::thread(&LogWriter::run, this);
+  pthread_atfork(&LogWriter::beforeFork, &LogWriter::afterForkParent,
+                 &LogWriter::afterForkChild);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Destructor; writes anything still queued and stops the thread.
+ */
+LogWriter::~LogWriter() {
+  stopping.store(true);
+  wake();
+  thread.join();
+  writerDestroyed = true;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Queue text to be written to a file.
+ *  \param file The destination file.  It must stay open until it is passed to
+ *              close().
+ *  \param text The text to write.
+ *  \param n Number of characters in text.
+ */
+void LogWriter::write(FILE *file, const char *text, const size_t n) {
+  enqueue(file, text, n, false);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Close a file once everything queued for it has been written.
+ *  \details Doesn't return until the file has been closed, so the log is
+ *           complete on disk when the logger that owns it is closed.
+ */
+void LogWriter::close(FILE *file) {
+  if (writerDestroyed) {
+    fclose(file);
+    return;
+  }
+  enqueue(file, NULL, 0, true);
+  flush();
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Wait until every record queued before this call has been written.
+ */
+void LogWriter::flush() {
+  const size_t target = enqueuePos.load();
+  while (written.load(memory_order_acquire) < target) {
+    wake();
+    this_thread::yield();
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Get ready for fork(): drain the queue and park the writer thread.
+ *  \details The writer ends up waiting on `wakeup` with `wakeMutex` held by
+ *           the forking thread, so it is not in the middle of any file I/O
+ *           when the process is copied.  A child process (e.g. an R worker
+ *           started by parallel::mclapply) gets none of the parent's
+ *           threads, so it starts its own writer in afterForkChild().
+ */
+void LogWriter::beforeFork() {
+  if (writerDestroyed) {
+    return;
+  }
+  LogWriter &writer = instance();
+  writer.flush();
+  for (;;) {
+    writer.wakeMutex.lock();
+    // The writer sets `sleeping` and clears it again only with the lock held
+    // or before taking it, so with the lock held this means it is parked
+    if (writer.sleeping.load() &&
+        writer.written.load() == writer.enqueuePos.load()) {
+      return;
+    }
+    writer.wakeMutex.unlock();
+    writer.wake();
+    this_thread::yield();
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Let the parent's writer thread carry on after fork().
+ */
+void LogWriter::afterForkParent() {
+  if (writerDestroyed) {
+    return;
+  }
+  instance().wakeMutex.unlock();
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Give a child process an empty queue and its own writer thread.
+ *  \details The copied mutex, condition variable and thread handle all refer
+ *           to the parent's writer, so they are replaced rather than used.
+ */
+void LogWriter::afterForkChild() {
+  if (writerDestroyed) {
+    return;
+  }
+  LogWriter &writer = instance();
+  new (&writer.wakeMutex) mutex;
+  new (&writer.wakeup) condition_variable;
+  // The parent's writer thread doesn't exist here; let go of its handle
+  // without joining it
+  writer.thread.detach();
+
+  for (size_t i = 0; i < capacity; ++i) {
+    writer.slots[i].sequence.store(i, memory_order_relaxed);
+    writer.slots[i].file = NULL;
+    writer.slots[i].closeFile = false;
+    writer.slots[i].text.clear();
+  }
+  writer.enqueuePos.store(0);
+  writer.dequeuePos = 0;
+  writer.written.store(0);
+  writer.dirty.clear();
+  writer.sleeping.store(false);
+  writer.stopping.store(false);
+  writer.thread = std::thread(&LogWriter::run, &writer);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Claim a slot, fill it, and hand it to the writer thread.
+ *  \details This is the multi-producer half of a bounded queue in which each
+ *           slot's sequence number tells whether it is free for the
+ *           producer claiming position `pos` (sequence == pos) or holds a
+ *           record for the writer (sequence == pos + 1).
+ */
+void LogWriter::enqueue(FILE *file, const char *text, const size_t n,
+                        const bool closeFile) {
+  size_t pos = enqueuePos.load(memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &slots[pos & (capacity - 1)];
+    const size_t seq = slot->sequence.load(memory_order_acquire);
+    if (seq == pos) {
+      if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                           memory_order_relaxed)) {
+        break;
+      }
+    } else if (seq < pos) {
+      // Queue is full: nudge the writer and wait for it to free a slot
+      wake();
+      this_thread::yield();
+      pos = enqueuePos.load(memory_order_relaxed);
+    } else {
+      // Another producer claimed this position first
+      pos = enqueuePos.load(memory_order_relaxed);
+    }
+  }
+
+  slot->file = file;
+  slot->closeFile = closeFile;
+  slot->text.assign(text, n);
+  slot->sequence.store(pos + 1, memory_order_release);
+
+  // Pairs with the fence in run(): either the writer sees this record before
+  // it goes to sleep, or we see that it is asleep and wake it.
+  atomic_thread_fence(memory_order_seq_cst);
+  if (sleeping.load(memory_order_relaxed)) {
+    wake();
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Write out the next queued record, if there is one.
+ *  \return True if a record was written.
+ *  \details Only called from the writer thread.
+ */
+bool LogWriter::dequeue() {
+  Slot &slot = slots[dequeuePos & (capacity - 1)];
+  if (slot.sequence.load(memory_order_acquire) != dequeuePos + 1) {
+    return false;
+  }
+
+  if (slot.closeFile) {
+    dirty.erase(remove(dirty.begin(), dirty.end(), slot.file), dirty.end());
+    fclose(slot.file);
+  } else {
+    fwrite(slot.text.data(), 1, slot.text.size(), slot.file);
+    if (find(dirty.begin(), dirty.end(), slot.file) == dirty.end()) {
+      dirty.push_back(slot.file);
+    }
+  }
+  // clear() keeps the string's storage for the next record in this slot
+  slot.text.clear();
+
+  slot.sequence.store(dequeuePos + capacity, memory_order_release);
+  ++dequeuePos;
+  written.store(dequeuePos, memory_order_release);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Wake the writer thread if it is waiting for records.
+ */
+void LogWriter::wake() {
+  lock_guard<mutex> lock(wakeMutex);
+  wakeup.notify_one();
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Main loop of the writer thread.
+ *  \details Writes records as long as there are any; when the queue runs dry
+ *           it flushes the files it has written to and sleeps until woken.
+ */
+void LogWriter::run() {
+  for (;;) {
+    while (dequeue()) {
+    }
+
+    for (FILE *file : dirty) {
+      fflush(file);
+    }
+    dirty.clear();
+
+    if (stopping.load()) {
+      // Producers can't be running during static destruction, so once the
+      // queue is empty it stays empty.
+      return;
+    }
+
+    sleeping.store(true, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    {
+      // Check again under the lock, so that a wake() can't slip in between
+      // the check and the wait
+      unique_lock<mutex> lock(wakeMutex);
+      const Slot &next = slots[dequeuePos & (capacity - 1)];
+      if (next.sequence.load(memory_order_acquire) != dequeuePos + 1 &&
+          !stopping.load()) {
+        wakeup.wait(lock);
+      }
+      // Cleared before the lock is released, so beforeFork() can tell that
+      // the thread is parked
+      sleeping.store(false, memory_order_relaxed);
+    }
+  }
+}
+
+} // namespace Hector
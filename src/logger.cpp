@@ -14,10 +14,11 @@
 
 #include "logger.hpp"
 #include "h_util.hpp"
+#include "log_writer.hpp"
 #include <algorithm>
-#include <boost/iostreams/device/file.hpp>
-#include <boost/iostreams/device/null.hpp>
 #include <boost/iostreams/tee.hpp>
+#include <mutex>
+#include <set>
 #include <time.h>
 
 #ifdef USE_RCPP
@@ -33,13 +34,152 @@ namespace Hector {
 
 using namespace std;
 
+namespace {
+//! Paths of the log files currently open, so that two cores never write to
+//! the same file.  Deliberately never destroyed, since loggers may be closed
+//! during static destruction.
+mutex openPathsMutex;
+set<string> &openPaths() {
+  static set<string> *paths = new set<string>;
+  return *paths;
+}
+} // namespace
+
+//------------------------------------------------------------------------------
+/*! \brief Where a logger's records go.
+ *
+ *  A sink is created by a top-level logger and shared by its children.  It
+ *  writes to a file via the shared LogWriter thread, and/or keeps the last
+ *  few records in a ring buffer in memory.
+ *
+ *  A core's components may log from several threads at once (see
+ *  ComponentScheduler), so the in-memory records are guarded by a mutex.
+ *  Writes to the file need no lock, since the LogWriter queue is already
+ *  safe to use from several threads.
+ */
+struct Logger::Sink {
+  Sink() : file(NULL), nextRecord(0), nrecords(0) {}
+  ~Sink();
+
+  void openFile(const string &logName);
+  void write(const char *s, streamsize n);
+
+  //! Path of the log file, if any.
+  string path;
+  //! The log file, if any.  It is written to by the LogWriter thread.
+  FILE *file;
+
+  //! Ring buffer of recent records; empty if not keeping records in memory.
+  vector<string> records;
+  //! Slot in records that the next record will go into.
+  size_t nextRecord;
+  //! Number of records kept so far (at most records.size()).
+  size_t nrecords;
+  //! The current record, until its newline arrives.
+  string partial;
+  //! Guards records, nextRecord, nrecords, and partial.
+  mutable mutex recordsMutex;
+};
+
+//------------------------------------------------------------------------------
+/*! \brief Close the log file once everything queued for it has been written.
+ */
+Logger::Sink::~Sink() {
+  if (file) {
+    LogWriter::instance().close(file);
+    lock_guard<mutex> lock(openPathsMutex);
+    openPaths().erase(path);
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Open the log file.
+ *  \details The file is normally LOG_DIRECTORY/logName.log, but if another
+ *           logger already has that file open (e.g. another core in the same
+ *           process), a numeric suffix is added to the name so that the two
+ *           don't overwrite each other.
+ */
+void Logger::Sink::openFile(const string &logName) {
+  ensure_dir_exists(LOG_DIRECTORY);
+
+  {
+    lock_guard<mutex> lock(openPathsMutex);
+    set<string> &paths = openPaths();
+    path = LOG_DIRECTORY + logName + LOG_EXTENSION; // fully-qualified name
+    for (int i = 2; paths.count(path); ++i) {
+      path = LOG_DIRECTORY + logName + "_" + to_string(i) + LOG_EXTENSION;
+    }
+    paths.insert(path);
+  }
+
+  // The file is opened here, so that failures are reported to the caller,
+  // but all writes to it happen on the LogWriter thread.
+  file = fopen(path.c_str(), "w");
+  if (!file) {
+    lock_guard<mutex> lock(openPathsMutex);
+    openPaths().erase(path);
+    H_THROW("Unable to open log file " + path);
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Send text to the file and/or the in-memory records.
+ *  \details Each line of text is one record.  Ring buffer slots are reused,
+ *           so once the buffer has filled, keeping records doesn't allocate.
+ */
+void Logger::Sink::write(const char *s, const streamsize n) {
+  if (file) {
+    LogWriter::instance().write(file, s, n);
+  }
+  if (!records.empty()) {
+    lock_guard<mutex> lock(recordsMutex);
+    const char *end = s + n;
+    while (s < end) {
+      const char *eol = find(s, end, '\n');
+      partial.append(s, eol);
+      if (eol == end) {
+        break;
+      }
+      records[nextRecord].swap(partial);
+      partial.clear();
+      nextRecord = (nextRecord + 1) % records.size();
+      nrecords = min(nrecords + 1, records.size());
+      s = eol + 1;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Boost.Iostreams sink that passes text on to a Logger::Sink.
+ *
+ *  The logger's stream calls write() each time it is flushed, which H_LOG
+ *  callers do at the end of every record with std::endl.
+ */
+class Logger::SinkDevice {
+public:
+  typedef char char_type;
+  typedef boost::iostreams::sink_tag category;
+
+  explicit SinkDevice(const shared_ptr<Sink> &sink) : sink(sink) {}
+
+  streamsize write(const char *s, streamsize n) {
+    sink->write(s, n);
+    return n;
+  }
+
+private:
+  shared_ptr<Sink> sink;
+};
+
 //------------------------------------------------------------------------------
 // Methods for Logger
 
 //------------------------------------------------------------------------------
 /*! \brief Create an uninitialized logger.
  */
-Logger::Logger() : minLogLevel(WARNING), isInitialized(false), loggerStream() {}
+Logger::Logger()
+    : minLogLevel(WARNING), isInitialized(false), echoToFile(false),
+      enabled(false), loggerStream() {}
 
 //------------------------------------------------------------------------------
 /*! \brief Destructor.
@@ -61,15 +201,17 @@ Logger::~Logger() { close(); }
  *                     console.
  * \param minLogLevel The minimum priority which will be processed.
  * \param echoToFile A flag to indicate if messages should be written to a log
- *                   file. If neither echoToScreen nor echoToFile is true, the
- *                   logger is disabled.
+ *                   file. If neither echoToScreen nor echoToFile is true, and
+ *                   no records are kept in memory, the logger is disabled.
  *                   (default: true)
+ * \param memoryRecords Number of the most recent records to keep in memory
+ *                      (see getRecentRecords()).  (default: 0)
  * \exception h_exception Exception thrown if the logger has already been
  *                        initialized.
  *
  */
 void Logger::open(const string &logName, bool echoToScreen, bool echoToFile,
-                  LogLevel minLogLevel) {
+                  LogLevel minLogLevel, size_t memoryRecords) {
   H_ASSERT(!isInitialized, "This log has already been initialized.");
 
   this->minLogLevel = minLogLevel;
@@ -85,29 +227,19 @@ void Logger::open(const string &logName, bool echoToScreen, bool echoToFile,
     loggerStream.push(screenEcho);
   }
 
+  // The sink is always the end point of the output stream.  If it has
+  // neither a file nor memory, output goes nowhere; this covers the cases:
+  //   1) that we are going to echo to screen but not file
+  //   2) If a user by passes shouldWrite / H_LOG this will ensure the output
+  //      still goes nowhere
+  sink = make_shared<Sink>();
   if (echoToFile) {
-    ensure_dir_exists(LOG_DIRECTORY);
-
-    const string fqName =
-        LOG_DIRECTORY + logName + LOG_EXTENSION; // fully-qualified name
-
-    file_sink fileBuff(fqName);
-    if (!fileBuff.is_open())
-      H_THROW("Unable to open log file " + fqName);
-
-    // add the file sink to the output stream which will serve as an end point
-    // for the output data
-    loggerStream.push(fileBuff);
-  } else {
-    // if we are not going to echo to file explicitly set the end point to
-    // a null device
-    // doing it this way covers the cases:
-    //   1) that we are going to echo to screen but not file
-    //   2) If a user by passes shouldWrite / H_LOG this will ensure the output
-    //      still goes nowhere
-    loggerStream.push(null_sink());
+    sink->openFile(logName);
   }
-  enabled = echoToScreen || echoToFile;
+  sink->records.resize(memoryRecords);
+  loggerStream.push(SinkDevice(sink));
+
+  enabled = echoToScreen || echoToFile || memoryRecords > 0;
 
   isInitialized = true;
 
@@ -116,12 +248,31 @@ void Logger::open(const string &logName, bool echoToScreen, bool echoToFile,
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Indicate whether a message at the given priority will be logged.
- *  \param writeLevel The priority level to check.
- *  \return True if this level would be logged, false otherwise.
+/*! \brief Open the logger as a child of another logger.
+ *
+ *  The child writes to the parent's file and/or in-memory records, but not to
+ *  the console, with the child's name added to each record.  The child
+ *  takes its minimum priority from the parent, but can raise it.
+ *
+ * \param logName Name added to each of this logger's records.
+ * \param parent The (open) logger to share output with.
+ * \param minLogLevel Lowest priority to process, if higher than the parent's.
+ * \exception h_exception If this logger is already open or the parent isn't.
  */
-bool Logger::shouldWrite(const LogLevel writeLevel) const {
-  return enabled && writeLevel >= minLogLevel;
+void Logger::open(const string &logName, const Logger &parent,
+                  LogLevel minLogLevel) {
+  H_ASSERT(!isInitialized, "This log has already been initialized.");
+  H_ASSERT(parent.isInitialized, "Parent log must be initialized.");
+
+  this->minLogLevel = max(parent.minLogLevel, minLogLevel);
+  this->echoToFile = parent.echoToFile;
+  sink = parent.sink;
+  recordTag = logName;
+  loggerStream.push(SinkDevice(sink));
+
+  enabled = sink->file != NULL || !sink->records.empty();
+
+  isInitialized = true;
 }
 
 //------------------------------------------------------------------------------
@@ -139,8 +290,12 @@ ostream &Logger::write(const LogLevel writeLevel, const string &functionInfo) {
   H_ASSERT(isInitialized, "can't write to logger until initialized");
 
   // note that we are not double checking the writeLevel
-  return loggerStream << getDateTimeStamp() << ':' << logLevelToStr(writeLevel)
-                      << ':' << functionInfo << ": ";
+  loggerStream << getDateTimeStamp() << ':' << logLevelToStr(writeLevel)
+               << ':';
+  if (!recordTag.empty()) {
+    loggerStream << recordTag << ':';
+  }
+  return loggerStream << functionInfo << ": ";
 }
 
 //------------------------------------------------------------------------------
@@ -152,8 +307,30 @@ void Logger::close() {
      *        be reopened.
      */
     isInitialized = false;
+    // flushes anything still buffered in the stream to the sink
     loggerStream.reset();
+    // the sink (and its file) is closed once no child still uses it
+    sink.reset();
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief The records kept in memory, oldest first.
+ *  \return Up to the number of records requested when the logger (or its
+ *          parent) was opened.  Empty if records aren't kept in memory.
+ */
+vector<string> Logger::getRecentRecords() const {
+  vector<string> recent;
+  if (sink) {
+    lock_guard<mutex> lock(sink->recordsMutex);
+    const vector<string> &records = sink->records;
+    const size_t first =
+        sink->nrecords < records.size() ? 0 : sink->nextRecord;
+    for (size_t i = 0; i < sink->nrecords; ++i) {
+      recent.push_back(records[(first + i) % records.size()]);
+    }
   }
+  return recent;
 }
 
 //------------------------------------------------------------------------------
@@ -170,24 +347,29 @@ const string &Logger::logLevelToStr(const LogLevel logLevel) {
 
 //------------------------------------------------------------------------------
 /*! \brief Get the current data and time stamp.
- *  \return A string representing the current date and time.
+ *  \return A string representing the current date and time, in the format
+ *          of asctime() without the trailing newline.
+ *  \details The stamp is only reformatted when the second changes, and each
+ *           thread has its own copy, so cores logging on different threads
+ *           don't share asctime()'s static buffer.
  */
 const char *Logger::getDateTimeStamp() {
-  time_t rawtime;
-  struct tm *timeinfo;
-  time(&rawtime);
-  timeinfo = localtime(&rawtime);
-  char *ret = asctime(timeinfo);
-  // remove the newline at the end of the string
-  int i = 0;
-  while (ret[i] != 0) {
-    i++;
-  }
-  if (i > 0) {
-    ret[i - 1] = 0;
+  thread_local time_t lasttime = -1;
+  thread_local char stamp[32];
+
+  const time_t rawtime = time(NULL);
+  if (rawtime != lasttime) {
+    struct tm timeinfo;
+#ifdef _WIN32
+    localtime_s(&timeinfo, &rawtime);
+#else
+    localtime_r(&rawtime, &timeinfo);
+#endif
+    strftime(stamp, sizeof stamp, "%a %b %e %H:%M:%S %Y", &timeinfo);
+    lasttime = rawtime;
   }
 
-  return ret;
+  return stamp;
 }
 
 //------------------------------------------------------------------------------
@@ -197,8 +379,12 @@ const char *Logger::getDateTimeStamp() {
 void Logger::printLogHeader(const LogLevel writeLevel) {
   H_ASSERT(isInitialized, "Logger must be initialized");
 
-  H_LOG((*this), writeLevel)
-      << MODEL_NAME << " version " << MODEL_VERSION << endl;
+  // Written directly rather than through H_LOG, so that the header isn't
+  // compiled out along with the low-priority messages.
+  if (enabled) {
+    write(writeLevel, __func__)
+        << MODEL_NAME << " version " << MODEL_VERSION << endl;
+  }
 }
 
 } // namespace Hector
@@ -0,0 +1,159 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  lognormal_cdf_table.cpp
+ *  hector
+ *
+ *  Tabulated lognormal cumulative distribution function.
+ *
+ */
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+
+// some boost headers generate warnings under clang; not our problem, ignore
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Weverything"
+#include <boost/math/distributions/lognormal.hpp>
+#pragma clang diagnostic pop
+
+#include "h_exception.hpp"
+#include "lognormal_cdf_table.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+namespace {
+//! The table extends this many standard deviations (of log x) either side of
+//! the mean, beyond which the CDF is within 1e-17 of zero or one...
+const double TABLE_NSIGMA = 8.5;
+//! ...but stops at this value if that comes first; the permafrost model only
+//! sees biome land temperature anomalies (degC), so larger values are rare.
+const double TABLE_XMAX = 60.0;
+//! Grid intervals in the first attempt; doubled until the error is small
+//! enough.
+const size_t TABLE_START_POINTS = 1024;
+const size_t TABLE_MAX_POINTS = 1 << 16;
+} // namespace
+
+//------------------------------------------------------------------------------
+/*! \brief Get the table for a lognormal distribution.
+ *  \param mu    Mean of the log of the variable.
+ *  \param sigma Standard deviation of the log of the variable.
+ *  \details Tables are built on first use and then shared, for as long as
+ *           anything holds on to them; the cache only keeps tables in use.
+ *           Safe to call from several threads.
+ */
+shared_ptr<const LognormalCDFTable> LognormalCDFTable::get(const double mu,
+                                                           const double sigma) {
+  H_ASSERT(sigma > 0, "lognormal sigma must be positive");
+
+  static mutex cacheMutex;
+  static map<pair<double, double>, weak_ptr<const LognormalCDFTable>> cache;
+
+  lock_guard<mutex> lock(cacheMutex);
+  weak_ptr<const LognormalCDFTable> &entry = cache[make_pair(mu, sigma)];
+  shared_ptr<const LognormalCDFTable> table = entry.lock();
+  if (!table) {
+    table.reset(new LognormalCDFTable(mu, sigma));
+    entry = table;
+
+    // Drop tables nobody holds any more, so an ensemble that varies the
+    // distribution doesn't leave an entry behind for every member
+    for (auto it = cache.begin(); it != cache.end();) {
+      if (it->second.expired()) {
+        it = cache.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  return table;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Build the table, refining it until it is accurate enough.
+ *  \exception h_exception If that would take an unreasonably large table.
+ */
+LognormalCDFTable::LognormalCDFTable(const double mu, const double sigma)
+    : mu(mu), sigma(sigma) {
+  umin = mu - TABLE_NSIGMA * sigma;
+  umax = min(mu + TABLE_NSIGMA * sigma, log(TABLE_XMAX));
+  xmin = exp(umin);
+  if (umax <= umin) {
+    // The whole distribution lies beyond TABLE_XMAX: build no table, so that
+    // cdf() gives zero below xmin and the exact CDF above it
+    step = 0.0;
+    inv_step = 0.0;
+    nintervals = 0;
+    return;
+  }
+  for (size_t n = TABLE_START_POINTS;; n *= 2) {
+    H_ASSERT(n <= TABLE_MAX_POINTS, "lognormal CDF table too large");
+    fill(n);
+    if (worst_error() < maxError) {
+      break;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief The exact CDF.
+ */
+double LognormalCDFTable::exact_cdf(const double x) const {
+  if (x <= 0.0) {
+    return 0.0;
+  }
+  return boost::math::cdf(boost::math::lognormal(mu, sigma), x);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief The exact slope of the CDF with respect to log(x), i.e. x * PDF.
+ */
+double LognormalCDFTable::exact_pdf(const double x) const {
+  if (x <= 0.0) {
+    return 0.0;
+  }
+  return x * boost::math::pdf(boost::math::lognormal(mu, sigma), x);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Tabulate the CDF on npoints intervals covering [umin, umax).
+ */
+void LognormalCDFTable::fill(const size_t npoints) {
+  step = (umax - umin) / npoints;
+  inv_step = npoints / (umax - umin);
+  nintervals = npoints;
+  // One extra point, so the last interval has a right-hand end
+  table.resize(2 * (npoints + 1));
+  for (size_t i = 0; i <= npoints; ++i) {
+    const double x = exp(umin + i * step);
+    table[2 * i] = exact_cdf(x);
+    table[2 * i + 1] = step * exact_pdf(x);
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Largest interpolation error, checked at several points in every
+ *         interval.
+ */
+double LognormalCDFTable::worst_error() const {
+  const double fractions[] = {0.25, 0.5, 0.75};
+  double worst = 0.0;
+  for (size_t i = 0; i + 1 < size(); ++i) {
+    for (double f : fractions) {
+      const double x = exp(umin + (i + f) * step);
+      worst = max(worst, fabs(cdf(x) - exact_cdf(x)));
+    }
+  }
+  return worst;
+}
+
+} // namespace Hector
@@ -19,7 +19,6 @@
 #include "csv_outputstream_visitor.hpp"
 #include "csv_tracking_visitor.hpp"
 #include "h_exception.hpp"
-#include "h_reader.hpp"
 #include "h_util.hpp"
 #include "ini_to_core_reader.hpp"
 #include "logger.hpp"
@@ -46,7 +45,6 @@ int main(int argc, char *const argv[]) {
     if (argc > 1) {
       if (ifstream(argv[1])) {
         H_LOG(glog, Logger::NOTICE) << "Reading input file " << argv[1] << endl;
-        h_reader reader(argv[1], INI_style);
       } else {
         H_LOG(glog, Logger::SEVERE)
             << "Couldn't find input file " << argv[1] << endl;
@@ -69,7 +67,6 @@ int main(int argc, char *const argv[]) {
     // Create visitors
     H_LOG(glog, Logger::NOTICE) << "Adding visitors to the core." << endl;
     filebuf csvoutputStreamFile;
-    filebuf csvFluxPoolTrackingFile;
 
     // Open the stream output file, which has an optional run name (specified in
     // the INI file) in it First ensure that OUTPUT_DIRECTORY exists so that we
@@ -88,21 +85,16 @@ int main(int argc, char *const argv[]) {
           string(string(OUTPUT_DIRECTORY) + "outputstream_" + rn + ".csv")
               .c_str(),
           ios::out);
-    // Open the simpleNbox tracking output file, similarly named
-    if (rn == "")
-      csvFluxPoolTrackingFile.open(
-          string(string(OUTPUT_DIRECTORY) + "tracking.csv").c_str(), ios::out);
-    else
-      csvFluxPoolTrackingFile.open(
-          string(string(OUTPUT_DIRECTORY) + "tracking_" + rn + ".csv").c_str(),
-          ios::out);
+    // The simpleNbox tracking output file is similarly named
+    const string trackingFileName =
+        rn == "" ? string(OUTPUT_DIRECTORY) + "tracking.csv"
+                 : string(OUTPUT_DIRECTORY) + "tracking_" + rn + ".csv";
 
     ostream outputStream(&csvoutputStreamFile);
     CSVOutputStreamVisitor csvOutputStreamVisitor(outputStream);
     core.addVisitor(&csvOutputStreamVisitor);
 
-    ostream trackingStream(&csvFluxPoolTrackingFile);
-    CSVFluxPoolVisitor csvFluxPoolVisitor(trackingStream);
+    CSVFluxPoolVisitor csvFluxPoolVisitor(trackingFileName);
     core.addVisitor(&csvFluxPoolVisitor);
 
     H_LOG(glog, Logger::NOTICE) << "Calling prepareToRun()\n";
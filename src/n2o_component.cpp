@@ -13,6 +13,7 @@
  */
 
 #include "n2o_component.hpp"
+#include "atmospheric_chemistry_engine.hpp"
 #include "avisitor.hpp"
 #include "core.hpp"
 #include "h_util.hpp"
@@ -25,7 +26,7 @@ using namespace std;
 //------------------------------------------------------------------------------
 /*! \brief Constructor
  */
-N2OComponent::N2OComponent() {
+N2OComponent::N2OComponent() : engine(NULL) {
   N2O_emissions.allowInterp(true);
   N2O_emissions.name = N2O_COMPONENT_NAME;
   N2O_natural_emissions.allowInterp(true);
@@ -52,9 +53,7 @@ string N2OComponent::getComponentName() const {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void N2OComponent::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
   core = coreptr;
   oldDate = core->getStartDate();
@@ -94,6 +93,10 @@ unitval N2OComponent::sendMessage(const std::string &message,
 //------------------------------------------------------------------------------
 // documentation is inherited
 void N2OComponent::setData(const string &varName, const message_data &data) {
+  if (engine) {
+    engine->invalidate();
+  }
+
   try {
     if (varName == D_PREINDUSTRIAL_N2O) {
       H_ASSERT(data.date == Core::undefinedIndex(), "date not allowed");
@@ -145,16 +148,26 @@ void N2OComponent::prepareToRun() {
     N0 = N2O_constrain.get(oldDate);
   }
   N2O.set(oldDate, N0);
+  aheadDate = oldDate;
+  if (engine) {
+    engine->invalidate();
+  }
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void N2OComponent::run(const double runToDate) {
+  if (engine) {
+    // The core has already run the engine for this year
+    H_ASSERT(oldDate == runToDate, "chemistry engine has not been run");
+    return;
+  }
+  H_CHECK(!core->inSpinup() && runToDate - oldDate == 1,
+          "timestep must equal 1");
 
-  H_ASSERT(!core->inSpinup() && runToDate - oldDate == 1,
-           "timestep must equal 1");
-
-  if (N2O_constrain.size() && N2O_constrain.exists(runToDate)) {
+  if (runToDate <= aheadDate) {
+    // Already set by runAhead()
+  } else if (N2O_constrain.size() && N2O_constrain.exists(runToDate)) {
     N2O.set(runToDate, N2O_constrain.get(runToDate));
   } else {
     // Approach modified from Ward and Mahowald, 2014, 10.5194/acp-14-12701-2014
@@ -164,23 +177,16 @@ void N2OComponent::run(const double runToDate) {
       previous_n2o = N2O.get(oldDate);
     }
 
-    // Decay constant varies based on N2O concentrations
-    // This is Eq. B8 in Ward and Mahowald, 2014
-    TAU_N2O.set(runToDate,
-                unitval(TN2O0.value(U_YRS) *
-                            (pow(previous_n2o / N0.value(U_PPBV_N2O), -0.05)),
-                        U_YRS));
+    const double tau = lifetime(previous_n2o);
+    TAU_N2O.set(runToDate, unitval(tau, U_YRS));
 
     // Current emissions are the sum of natural and anthropogenic sources
     const double current_n2oem =
         N2O_emissions.get(runToDate).value(U_TG_N) +
         N2O_natural_emissions.get(runToDate).value(U_TG_N);
 
-    // This calculation follows Eq. B7 in Ward and Mahowald 2014
-    const double dN2O = current_n2oem / UC_N2O -
-                        previous_n2o / TAU_N2O.get(runToDate).value(U_YRS);
-
-    N2O.set(runToDate, unitval(previous_n2o + dN2O, U_PPBV_N2O));
+    N2O.set(runToDate,
+            unitval(step(previous_n2o, tau, current_n2oem), U_PPBV_N2O));
     H_LOG(logger, Logger::DEBUG)
         << runToDate << "tau = " << TAU_N2O.get(runToDate);
   }
@@ -190,6 +196,54 @@ void N2OComponent::run(const double runToDate) {
       << runToDate << " N2O = " << N2O.get(runToDate) << std::endl;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief N2O lifetime, years, given last year's concentration (ppbv N2O).
+ *  \details Used by run() and by the chemistry engine.
+ */
+double N2OComponent::lifetime(const double previous_n2o) const {
+  // Decay constant varies based on N2O concentrations
+  // This is Eq. B8 in Ward and Mahowald, 2014
+  return TN2O0.value(U_YRS) * (pow(previous_n2o / N0.value(U_PPBV_N2O), -0.05));
+}
+
+//------------------------------------------------------------------------------
+/*! \brief This year's N2O concentration, from last year's and the sinks and
+ *         sources.
+ *  \param previous_n2o Last year's N2O concentration, ppbv N2O.
+ *  \param tau          This year's N2O lifetime, years.
+ *  \param emissions    Natural and anthropogenic emissions, Tg N.
+ *  \returns N2O concentration, ppbv N2O.
+ *  \details Used by run() and by the chemistry engine.
+ */
+double N2OComponent::step(const double previous_n2o, const double tau,
+                          const double emissions) const {
+  // This calculation follows Eq. B7 in Ward and Mahowald 2014
+  const double dN2O = emissions / UC_N2O - previous_n2o / tau;
+  return previous_n2o + dN2O;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief If N2O is constrained for every year from firstDate to lastDate,
+ *         set all of those concentrations now.
+ *  \details With the chemistry engine, the engine does this instead.
+ */
+bool N2OComponent::runAhead(const double firstDate, const double lastDate) {
+  aheadDate = firstDate - 1;
+  if (engine || !N2O_constrain.size()) {
+    return false;
+  }
+  for (double date = firstDate; date <= lastDate; date += 1.0) {
+    if (!N2O_constrain.exists(date)) {
+      return false;
+    }
+  }
+  for (double date = firstDate; date <= lastDate; date += 1.0) {
+    N2O.set(date, N2O_constrain.get(date));
+  }
+  aheadDate = lastDate;
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // documentation is inherited
 unitval N2OComponent::getData(const std::string &varName, const double date) {
@@ -234,8 +288,12 @@ unitval N2OComponent::getData(const std::string &varName, const double date) {
 void N2OComponent::reset(double time) {
   // reset time counter, and truncate output time series
   oldDate = time;
+  aheadDate = time;
   N2O.truncate(time);
   TAU_N2O.truncate(time);
+  if (engine) {
+    engine->invalidate();
+  }
   H_LOG(logger, Logger::NOTICE)
       << getComponentName() << " reset to time= " << time << "\n";
 }
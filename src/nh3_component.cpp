@@ -43,9 +43,7 @@ string NH3Component::getComponentName() const {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void NH3Component::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
   core = coreptr;
 
@@ -103,8 +101,8 @@ void NH3Component::prepareToRun() {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void NH3Component::run(const double runToDate) {
-  H_ASSERT(!core->inSpinup() && runToDate - oldDate == 1,
-           "timestep must equal 1");
+  H_CHECK(!core->inSpinup() && runToDate - oldDate == 1,
+          "timestep must equal 1");
   oldDate = runToDate;
 }
 
@@ -18,6 +18,7 @@
 #include "core.hpp"
 #include "h_util.hpp"
 #include "o3_component.hpp"
+#include "short_lived_forcer_engine.hpp"
 
 namespace Hector {
 
@@ -44,9 +45,7 @@ string OzoneComponent::getComponentName() const {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void OzoneComponent::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
   core = coreptr;
 
@@ -128,15 +127,30 @@ void OzoneComponent::run(const double runToDate) {
   // Calculate O3 based on NOX, CO, NMVOC, CH4.
   // Modified from Tanaka et al 2007
 
-  unitval current_nox = NOX_emissions.get(runToDate);
-  unitval current_co = CO_emissions.get(runToDate);
-  unitval current_nmvoc = NMVOC_emissions.get(runToDate);
   unitval current_ch4 = core->sendMessage(M_GETDATA, D_CH4_CONC, runToDate);
 
-  O3.set(runToDate,
-         unitval((5 * log(current_ch4)) + (0.125 * current_nox) +
-                     (0.0011 * current_co) + (0.0033 * current_nmvoc),
-                 U_DU_O3));
+  if (const ShortLivedForcerEngine *slf = core->getShortLivedForcerEngine()) {
+    // The emission terms have already been computed for the whole run
+    double terms[ShortLivedForcerEngine::N_OZONE_PRECURSORS];
+    slf->getOzonePrecursors(runToDate, terms);
+    O3.set(runToDate,
+           unitval(concentration(current_ch4.value(U_PPBV_CH4),
+                                 terms[ShortLivedForcerEngine::O3_NOX],
+                                 terms[ShortLivedForcerEngine::O3_CO],
+                                 terms[ShortLivedForcerEngine::O3_NMVOC]),
+                   U_DU_O3));
+  } else {
+    const double current_nox = NOX_emissions.get(runToDate).value(U_TG_N);
+    const double current_co = CO_emissions.get(runToDate).value(U_TG_CO);
+    const double current_nmvoc =
+        NMVOC_emissions.get(runToDate).value(U_TG_NMVOC);
+
+    O3.set(runToDate,
+           unitval(concentration(current_ch4.value(U_PPBV_CH4),
+                                 noxTerm(current_nox), coTerm(current_co),
+                                 nmvocTerm(current_nmvoc)),
+                   U_DU_O3));
+  }
 
   oldDate = runToDate;
 
@@ -145,6 +159,33 @@ void OzoneComponent::run(const double runToDate) {
       << std::endl;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief The NOX term of the ozone concentration, DU, from emissions (Tg N).
+ *  \details The precursor terms are used by run() and, for the whole run at
+ *           once, by the short-lived forcer engine.
+ */
+double OzoneComponent::noxTerm(const double nox) { return 0.125 * nox; }
+
+//------------------------------------------------------------------------------
+/*! \brief The CO term of the ozone concentration, DU, from emissions (Tg CO).
+ */
+double OzoneComponent::coTerm(const double co) { return 0.0011 * co; }
+
+//------------------------------------------------------------------------------
+/*! \brief The NMVOC term of the ozone concentration, DU, from emissions
+ *         (Tg NMVOC).
+ */
+double OzoneComponent::nmvocTerm(const double nmvoc) { return 0.0033 * nmvoc; }
+
+//------------------------------------------------------------------------------
+/*! \brief Ozone concentration, DU, from CH4 (ppbv) and the precursor terms.
+ */
+double OzoneComponent::concentration(const double ch4, const double nox_term,
+                                     const double co_term,
+                                     const double nmvoc_term) {
+  return (5 * log(ch4)) + nox_term + co_term + nmvoc_term;
+}
+
 //------------------------------------------------------------------------------
 // documentation is inherited
 unitval OzoneComponent::getData(const std::string &varName, const double date) {
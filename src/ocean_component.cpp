@@ -35,6 +35,7 @@
 
 #include <cmath>
 #include <limits>
+#include <sstream>
 
 #include "avisitor.hpp"
 #include "core.hpp"
@@ -50,7 +51,15 @@ using namespace std;
 /*! \brief Constructor
  */
 
-OceanComponent::OceanComponent() { spinup_chem = true; }
+OceanComponent::OceanComponent()
+    : circulation(OCEAN_NBOXES * OCEAN_NBOXES, 0.0),
+      box_fluxes(OCEAN_NBOXES * OCEAN_NBOXES, 0.0) {
+  spinup_chem = true;
+  boxes[OCEAN_BOX_LL] = &surfaceLL;
+  boxes[OCEAN_BOX_HL] = &surfaceHL;
+  boxes[OCEAN_BOX_IO] = &inter;
+  boxes[OCEAN_BOX_DO] = &deep;
+}
 
 //------------------------------------------------------------------------------
 /*! \brief Destructor
@@ -68,9 +77,7 @@ string OceanComponent::getComponentName() const {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void OceanComponent::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
 
   max_timestep = OCEAN_MAX_TIMESTEP;
@@ -246,14 +253,14 @@ void OceanComponent::prepareToRun() {
   H_LOG(logger, Logger::DEBUG) << "Setting up ocean box model" << std::endl;
   surfaceHL.initbox(HL_preind_C, "HL");
   surfaceHL.surfacebox = true;
-  surfaceHL.preindustrial_flux.set(1.000,
-                                   U_PGC_YR); // used if no spinup chemistry
+  surfaceHL.preindustrial_flux =
+      quantity<U_PGC_YR>(1.000); // used if no spinup chemistry
   surfaceHL.active_chemistry = spinup_chem;
 
   surfaceLL.initbox(LL_preind_C, "LL");
   surfaceLL.surfacebox = true;
-  surfaceLL.preindustrial_flux.set(-1.000,
-                                   U_PGC_YR); // used if no spinup chemistry
+  surfaceLL.preindustrial_flux =
+      quantity<U_PGC_YR>(-1.000); // used if no spinup chemistry
   surfaceLL.active_chemistry = spinup_chem;
 
   inter.initbox(I_preind_C, "intermediate");
@@ -275,13 +282,26 @@ void OceanComponent::prepareToRun() {
   double IO_DOex = (tid.value(U_M3_S) * spy) / I_volume;
 
   // Set up the flow connections between the boxes
-  surfaceLL.make_connection(&surfaceHL, LL_HL, 1);
-  surfaceLL.make_connection(&inter, LL_IOex, 1);
-  surfaceHL.make_connection(&deep, HL_DO, 1);
-  inter.make_connection(&surfaceLL, IO_LL + IO_LLex, 1);
-  inter.make_connection(&surfaceHL, IO_HL, 1);
-  inter.make_connection(&deep, IO_DOex, 1);
-  deep.make_connection(&inter, DO_IO + DO_IOex, 1);
+  const int n = OCEAN_NBOXES;
+  fill(circulation.begin(), circulation.end(), 0.0);
+  circulation[OCEAN_BOX_LL * n + OCEAN_BOX_HL] = LL_HL;
+  circulation[OCEAN_BOX_LL * n + OCEAN_BOX_IO] = LL_IOex;
+  circulation[OCEAN_BOX_HL * n + OCEAN_BOX_DO] = HL_DO;
+  circulation[OCEAN_BOX_IO * n + OCEAN_BOX_LL] = IO_LL + IO_LLex;
+  circulation[OCEAN_BOX_IO * n + OCEAN_BOX_HL] = IO_HL;
+  circulation[OCEAN_BOX_IO * n + OCEAN_BOX_DO] = IO_DOex;
+  circulation[OCEAN_BOX_DO * n + OCEAN_BOX_IO] = DO_IO + DO_IOex;
+  H_DIAGNOSTICS(logger, Logger::DEBUG) {
+    for (int i = 0; i < n; ++i) {
+      std::ostringstream row;
+      for (int j = 0; j < n; ++j) {
+        row << " " << circulation[i * n + j];
+      }
+      H_LOG(logger, Logger::DEBUG) << "Circulation from "
+                                   << boxes[i]->get_name() << ":" << row.str()
+                                   << std::endl;
+    }
+  }
 
   // Inputs for surface chemistry boxes
   surfaceHL.deltaT.set(-16.4,
@@ -327,18 +347,61 @@ fluxpool OceanComponent::totalcpool() const {
          surfaceHL.get_carbon();
 }
 
+//------------------------------------------------------------------------------
+/*! \brief             Move carbon between the boxes
+ *  \param[in] yf      year fraction (0-1)
+ *
+ *  Applies the circulation matrix to the box carbon pools, scheduling the
+ *  transfers in each box; they take effect when the boxes update their
+ *  states.  When carbon is being tracked, each transfer carries the source
+ *  box's tracking map with it, so those go to the boxes as fluxpools.
+ */
+void OceanComponent::circulate(const double yf) {
+  const int n = OCEAN_NBOXES;
+  const bool tracking = surfaceHL.get_carbon().tracking;
+
+  double carbon[OCEAN_NBOXES];
+  double additions[OCEAN_NBOXES];
+  double subtractions[OCEAN_NBOXES];
+  for (int i = 0; i < n; ++i) {
+    carbon[i] = boxes[i]->get_carbon().value(U_PGC);
+    additions[i] = subtractions[i] = 0.0;
+  }
+
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      const double k = circulation[i * n + j];
+      if (k == 0.0) {
+        continue;
+      }
+      const double closs = carbon[i] * k * yf;
+      additions[j] += closs;
+      subtractions[i] += closs;
+      box_fluxes[i * n + j] += closs;
+      if (tracking) {
+        boxes[j]->add_carbon(boxes[i]->get_carbon() * k * yf);
+      }
+    }
+  }
+
+  for (int i = 0; i < n; ++i) {
+    boxes[i]->set_circulation_fluxes(additions[i], subtractions[i], !tracking);
+  }
+}
+
 //------------------------------------------------------------------------------
 /*! \brief                  Internal function to calculate atmosphere-ocean C
  * flux \param[in] date         double, date of calculation (in case constraint
- * used) \param[in] CO2_conc     unitval, atmospheric CO2 concentration
+ * used) \param[in] CO2_conc     atmospheric CO2 concentration
  *  \param[in] cpoolscale   double, how much to scale surface C pools by
- *  \returns                unitval, annual atmosphere-ocean C flux
+ *  \returns                annual atmosphere-ocean C flux
  */
-unitval OceanComponent::annual_totalcflux(const double date,
-                                          const unitval &CO2_conc,
-                                          const double cpoolscale) const {
+quantity<U_PGC_YR>
+OceanComponent::annual_totalcflux(const double date,
+                                  const quantity<U_PPMV_CO2> CO2_conc,
+                                  const double cpoolscale) const {
 
-  unitval flux(0.0, U_PGC_YR);
+  quantity<U_PGC_YR> flux(0.0);
 
   if (in_spinup && !spinup_chem) {
     flux = surfaceHL.preindustrial_flux + surfaceLL.preindustrial_flux;
@@ -382,6 +445,7 @@ void OceanComponent::run(const double runToDate) {
   surfaceLL.new_year(SST);
   inter.new_year(SST);
   deep.new_year(SST);
+  fill(box_fluxes.begin(), box_fluxes.end(), 0.0);
   H_LOG(logger, Logger::DEBUG)
       << "----------------------------------------------------" << std::endl;
   H_LOG(logger, Logger::DEBUG)
@@ -399,9 +463,9 @@ void OceanComponent::run(const double runToDate) {
     surfaceLL.chem_equilibrate(CO2_conc);
   }
 
-  // Call compute_fluxes with do_boxfluxes=false to run just chemistry
-  surfaceHL.compute_fluxes(CO2_conc, atmosphere_cpool, 1.0, false);
-  surfaceLL.compute_fluxes(CO2_conc, atmosphere_cpool, 1.0, false);
+  // Call compute_fluxes to run just chemistry
+  surfaceHL.compute_fluxes(CO2_conc, atmosphere_cpool, 1.0);
+  surfaceLL.compute_fluxes(CO2_conc, atmosphere_cpool, 1.0);
 
   // Now wait for the solver to call us
 }
@@ -474,15 +538,15 @@ unitval OceanComponent::getData(const std::string &varName, const double date) {
               surfaceHL.mychemistry.convertToDIC(surfaceHL.get_carbon());
       returnval = unitval(value, U_UMOL_KG);
     } else if (varName == D_HL_DO) {
-      returnval = surfaceHL.annual_box_fluxes[&deep];
+      returnval = unitval(
+          box_fluxes[OCEAN_BOX_HL * OCEAN_NBOXES + OCEAN_BOX_DO], U_PGC_YR);
     } else if (varName == D_PCO2_HL) {
       returnval = surfaceHL.mychemistry.PCO2o;
     } else if (varName == D_PCO2_LL) {
       returnval = surfaceLL.mychemistry.PCO2o;
     } else if (varName == D_PCO2) {
-      double value = part_low * surfaceLL.mychemistry.PCO2o +
-                     part_high * surfaceHL.mychemistry.PCO2o;
-      returnval = unitval(value, U_UATM);
+      returnval = part_low * surfaceLL.mychemistry.PCO2o +
+                  part_high * surfaceHL.mychemistry.PCO2o;
     } else if (varName == D_PH_HL) {
       returnval = surfaceHL.mychemistry.pH;
     } else if (varName == D_PH_LL) {
@@ -607,13 +671,15 @@ int OceanComponent::calcderivs(double t, const double c[],
 
   // If the solver has adjusted the ocean and/or atmosphere pools,
   // need to be take into account in the flux computation
-  const unitval cpooldiff = unitval(c[SNBOX_OCEAN], U_PGC) - totalcpool();
-  const unitval surfacepools = surfaceLL.get_carbon() + surfaceHL.get_carbon();
+  const quantity<U_PGC> cpooldiff =
+      quantity<U_PGC>(c[SNBOX_OCEAN]) - quantity<U_PGC>(totalcpool());
+  const quantity<U_PGC> surfacepools =
+      quantity<U_PGC>(surfaceLL.get_carbon()) +
+      quantity<U_PGC>(surfaceHL.get_carbon());
   const double cpoolscale = (surfacepools + cpooldiff) / surfacepools;
-  unitval CO2_conc(c[SNBOX_ATMOS] * PGC_TO_PPMVCO2, U_PPMV_CO2);
+  const quantity<U_PPMV_CO2> CO2_conc(c[SNBOX_ATMOS] * PGC_TO_PPMVCO2);
 
-  dcdt[SNBOX_OCEAN] =
-      annual_totalcflux(t, CO2_conc, cpoolscale).value(U_PGC_YR);
+  dcdt[SNBOX_OCEAN] = annual_totalcflux(t, CO2_conc, cpoolscale).value();
 
   // If too big a timestep--i.e., stashCvalues below has signalled a reduced
   // step that we're exceeding--signal to the solver that this won't work for
@@ -670,11 +736,13 @@ void OceanComponent::stashCValues(double t, const double c[]) {
 
   unitval CO2_conc(c[SNBOX_ATMOS] * PGC_TO_PPMVCO2, U_PPMV_CO2);
 
-  // Compute fluxes between the boxes (advection of carbon)
+  // Compute the atmosphere-ocean fluxes, and the fluxes between the boxes
+  // (advection of carbon)
   surfaceHL.compute_fluxes(CO2_conc, atmosphere_cpool, yearfraction);
   surfaceLL.compute_fluxes(CO2_conc, atmosphere_cpool, yearfraction);
   inter.compute_fluxes(CO2_conc, atmosphere_cpool, yearfraction);
   deep.compute_fluxes(CO2_conc, atmosphere_cpool, yearfraction);
+  circulate(yearfraction);
 
   // At this point, compute_fluxes has (by calling the chemistry model) computed
   // atmosphere- ocean fluxes for the surface boxes. But these are
@@ -770,6 +838,7 @@ void OceanComponent::reset(double time) {
   surfaceLL = surfaceLL_tv.get(time);
   inter = inter_tv.get(time);
   deep = deep_tv.get(time);
+  box_fluxes = box_fluxes_tv.get(time);
 
   SST = SST_ts.get(time);
   CO2_conc = Ca_ts.get(time);
@@ -788,6 +857,7 @@ void OceanComponent::reset(double time) {
   surfaceLL_tv.truncate(time);
   inter_tv.truncate(time);
   deep_tv.truncate(time);
+  box_fluxes_tv.truncate(time);
 
   SST_ts.truncate(time);
   Ca_ts.truncate(time);
@@ -813,6 +883,7 @@ void OceanComponent::record_state(double time) {
   surfaceLL_tv.set(time, surfaceLL);
   inter_tv.set(time, inter);
   deep_tv.set(time, deep);
+  box_fluxes_tv.set(time, box_fluxes);
 
   // Record the state of the various ocean boxes and variables at each time step
   // in a unitval time series so that the output can be output by the
@@ -825,7 +896,9 @@ void OceanComponent::record_state(double time) {
   lastflux_annualized_ts.set(time, lastflux_annualized);
   C_IO_ts.set(time, inter.get_carbon());
   Ca_HL_ts.set(time, surfaceHL.get_carbon());
-  C_DO_ts.set(time, surfaceHL.annual_box_fluxes[&deep]);
+  C_DO_ts.set(time,
+              unitval(box_fluxes[OCEAN_BOX_HL * OCEAN_NBOXES + OCEAN_BOX_DO],
+                      U_PGC_YR));
   PH_HL_ts.set(time, surfaceHL.mychemistry.pH);
   PH_LL_ts.set(time, surfaceLL.mychemistry.pH);
   pco2_HL_ts.set(time, surfaceHL.mychemistry.PCO2o);
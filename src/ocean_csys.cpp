@@ -55,6 +55,7 @@
  *
  */
 
+#include <limits>
 #include <math.h>
 
 // some boost headers generate warnings under clang; not our problem, ignore
@@ -89,6 +90,9 @@ using namespace std;
 oceancsys::oceancsys() : ncoeffs(6), m_a(ncoeffs) {
   logger = NULL;
   S = alk = As = Ks = 0.0;
+  // NaN never compares equal, so the first run computes the constants
+  constantsTc = constantsS = constantsU =
+      numeric_limits<double>::quiet_NaN();
 }
 
 //------------------------------------------------------------------------------
@@ -156,44 +160,18 @@ double find_largest_root(const int ncoeffs, double *a) {
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Run Ocean csys
+/*! \brief Calculate the equilibrium constants
+ *  \param Tc  Box temperature (degC)
  *
- * DIC and ALK calculate pH, pCO2, omega Ar, omega Ca
- * (from Zeebe and Wolfe-Gladrow 2001)
- * pCO2 is used to calculate ocean-atmosphere fluxes
- * (from Takahashi et al, 2009, eq. 7 & 8)
+ *  The equilibrium constants, Schmidt number and gas transfer coefficient
+ *  depend only on temperature, salinity (and wind speed), not on the carbon
+ *  in the box, so ocean_csys_run only calls this when those change.
  */
-void oceancsys::ocean_csys_run(unitval tbox, unitval carbon) {
+void oceancsys::calc_constants(const double Tc) {
 
   double tmp, tmp1, tmp2, tmp3;
-
-  // Convert carbon to dic value and temperature to K
-  const double dic =
-      convertToDIC(carbon).value(U_UMOL_KG) / 1e6; // back to mol/kg
-  const double Tc = tbox.value(U_DEGC);
   const double Tk = Tc + 273.15;
 
-  // Using the recommended ranges Richard E. Zeebe and Dieter A. Wolf-Gladrow
-  // check the input values fro temperature, DIC, and alkalinity. If that is the
-  // case issue a warning, this may happen during idealized experiments or runs
-  // extending beyond 2100.
-  const bool questionable_Tk = !(Tk > 265 && Tk < 308);
-  const bool questionable_dic = !(dic > 1000e-6 && dic < 3700e-6);
-  const bool questionable_alk = !(alk >= 2000e-6 && alk <= 2750e-6);
-
-  if (questionable_Tk) {
-    OC_LOG(logger, Logger::NOTICE)
-        << "Temp value outside of Zeebe & Wolf-Gladrow range" << endl;
-  }
-  if (questionable_dic) {
-    OC_LOG(logger, Logger::NOTICE)
-        << "DIC value outside of Zeebe & Wolf-Gladrow range" << endl;
-  }
-  if (questionable_alk) {
-    OC_LOG(logger, Logger::NOTICE)
-        << "Alk value outside of Zeebe & Wolf-Gladrow range" << endl;
-  }
-
   /*---------------------------------------------------------------
 This section calculates the constants K0, Sc, K1, K2, Ksp, Ksi etc.
 ---------------------------------------------------------------*/
@@ -213,7 +191,7 @@ This section calculates the constants K0, Sc, K1, K2, Ksp, Ksi etc.
   // temperature and salinity. Equation Sc = A -  Bt +  Ct 2 -  Dt 3 (t in
   // degrees C) from WANNINKHOF 1992 see TABLE  A1 WANNINKHOF 1992 . for
   // coefficients.
-  const double Sc =
+  const double Sc_val =
       2073.1 - (125.62 * Tc) + (3.6276 * Tc * Tc) - (0.043219 * Tc * Tc * Tc);
 
   // --------------------- Kwater -----------------------------------
@@ -242,14 +220,14 @@ This section calculates the constants K0, Sc, K1, K2, Ksp, Ksi etc.
   // Lueker et al. (2000) equation 16
   const double pK1mehr = 3633.86 / Tk - 61.2172 + 9.6777 * log(Tk) -
                          0.011555 * S + 0.0001152 * S * S;
-  const unitval K1(pow(10, -pK1mehr), U_MOL_KG);
+  K1.set(pow(10, -pK1mehr), U_MOL_KG);
 
   // --------------------- K2 ----------------------------------------
   // Second acidity constants of carbonic acid
   // Lueker et al. (2000) equation 17
   const double pK2mehr = 471.78 / Tk + 25.9290 - 3.16967 * log(Tk) -
                          0.01781 * S + 0.0001122 * S * S;
-  const unitval K2(pow(10.0, -pK2mehr), U_MOL_KG);
+  K2.set(pow(10.0, -pK2mehr), U_MOL_KG);
 
   // --------------------- Kb  --------------------------------------------
   // The equilibrium constant of boric acid
@@ -261,7 +239,7 @@ This section calculates the constants K0, Sc, K1, K2, Ksp, Ksi etc.
   tmp3 = +(-24.4344 - 25.085 * sqrt(S) - 0.2474 * S) * log(Tk) +
          0.053105 * sqrt(S) * Tk;
   const double lnKb = tmp1 + tmp2 + tmp3;
-  const unitval Kb(exp(lnKb), U_MOL_KG);
+  Kb.set(exp(lnKb), U_MOL_KG);
 
   // --------------------- Kspc (calcite) ----------------------------
   // Solubility of calcite
@@ -270,7 +248,7 @@ This section calculates the constants K0, Sc, K1, K2, Ksp, Ksi etc.
   tmp2 = +(-0.77712 + 0.0028426 * Tk + 178.34 / Tk) * sqrt(S);
   tmp3 = -0.07711 * S + 0.0041249 * pow(S, 1.5);
   const double log10Kspc = tmp1 + tmp2 + tmp3;
-  const double Kspc = pow(10.0, log10Kspc); // mol/kg
+  Kspc.set(pow(10.0, log10Kspc), U_MOL_KG);
 
   // --------------------- Kspa (aragonite) ----------------------------
   // Solubility of aragonite
@@ -279,12 +257,81 @@ This section calculates the constants K0, Sc, K1, K2, Ksp, Ksi etc.
   tmp2 = +(-0.068393 + 0.0017276 * Tk + 88.135 / Tk) * sqrt(S);
   tmp3 = -0.10018 * S + 0.0059415 * pow(S, 1.5);
   const double log10Kspa = tmp1 + tmp2 + tmp3;
-  const double Kspa = pow(10.0, log10Kspa); // mol/kg
+  Kspa.set(pow(10.0, log10Kspa), U_MOL_KG);
 
   //------------------------- boron --------------------------------------
   // Total boron concentration related to seawater salinity
   // DOE 1994
-  const double bor = 1 * (416.0 * (S / 35.0)) * 1.e-6; // (mol/kg)
+  bor = 1 * (416.0 * (S / 35.0)) * 1.e-6; // (mol/kg)
+
+  //------------------------- calcium --------------------------------------
+  // this is 0.010285*S/35
+  calcium =
+      0.02128 / 40.087 *
+      (S /
+       1.80655); // mol/kg Riley, and Tongudai, Chemical Geology 2:263-269, 1967
+
+  // ----------------------------------------------------------------------------
+  /*! Gas transfer coefficient for the air-sea flux of carbon
+   * based on Takahashi et al, 2009 Deep Sea Research
+   * Uses K0 (solubility), Sc (Schmidt number) , U (wind stress)
+   */
+  Sc.set(Sc_val, U_UNITLESS);
+  Tr = quantity<U_gC_m2_month_uatm>(
+      0.585 * K0.value(U_MOL_L_ATM) * pow(Sc_val, -0.5) * U *
+      U); // units : gC m-2 month-1 uatm-1.
+  // 0.585 is a unit conversion factor from Takahashi et al, 2009 equation 8
+  // unit conversion * solubility * Schmidt number * wind speed^2
+
+  constantsTc = Tc;
+  constantsS = S;
+  constantsU = U;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Run Ocean csys
+ *
+ * DIC and ALK calculate pH, pCO2, omega Ar, omega Ca
+ * (from Zeebe and Wolfe-Gladrow 2001)
+ * pCO2 is used to calculate ocean-atmosphere fluxes
+ * (from Takahashi et al, 2009, eq. 7 & 8)
+ */
+void oceancsys::ocean_csys_run(unitval tbox, unitval carbon) {
+
+  double tmp;
+
+  // Convert carbon to dic value and temperature to K
+  const double dic =
+      convertToDIC(carbon).value(U_UMOL_KG) / 1e6; // back to mol/kg
+  const double Tc = tbox.value(U_DEGC);
+  const double Tk = Tc + 273.15;
+
+  // Using the recommended ranges Richard E. Zeebe and Dieter A. Wolf-Gladrow
+  // check the input values fro temperature, DIC, and alkalinity. If that is the
+  // case issue a warning, this may happen during idealized experiments or runs
+  // extending beyond 2100.
+  const bool questionable_Tk = !(Tk > 265 && Tk < 308);
+  const bool questionable_dic = !(dic > 1000e-6 && dic < 3700e-6);
+  const bool questionable_alk = !(alk >= 2000e-6 && alk <= 2750e-6);
+
+  if (questionable_Tk) {
+    OC_LOG(logger, Logger::NOTICE)
+        << "Temp value outside of Zeebe & Wolf-Gladrow range" << endl;
+  }
+  if (questionable_dic) {
+    OC_LOG(logger, Logger::NOTICE)
+        << "DIC value outside of Zeebe & Wolf-Gladrow range" << endl;
+  }
+  if (questionable_alk) {
+    OC_LOG(logger, Logger::NOTICE)
+        << "Alk value outside of Zeebe & Wolf-Gladrow range" << endl;
+  }
+
+  // The constants depend only on temperature and salinity, which change
+  // once a year at most, so don't recalculate them on every call
+  if (Tc != constantsTc || S != constantsS || U != constantsU) {
+    calc_constants(Tc);
+  }
 
   /* ---------------------------------------
 Since ALK and DIC are given, solve for pH and pCO2
@@ -337,32 +384,16 @@ Since ALK and DIC are given, solve for pH and pCO2
   TCO2o.set(co2st * million, U_UMOL_KG);
   HCO3.set(hco3 * million, U_UMOL_KG);
   CO3.set(co3 * million, U_UMOL_KG);
-  PCO2o.set(co2st * million / Kh.value(U_MOL_KG_ATM), U_UATM);
+  PCO2o = quantity<U_UATM>(co2st * million / Kh.value(U_MOL_KG_ATM));
   pH.set(-log10(h), U_PH);
 
-  // ----------------------------------------------------------------------------
-  /*! Calculate air-sea flux of carbon
-   * based on Takahashi et al, 2009 Deep Sea Research
-   * Uses K0 (solubility), Sc (Schmidt number) , U (wind stress), PCO2atm, PCO2o
-   */
-
-  Tr.set((0.585 * K0.value(U_MOL_L_ATM) * pow(Sc, -0.5) * U * U),
-         U_gC_m2_month_uatm); // units : gC m-2 month-1 uatm-1.
-  // 0.585 is a unit conversion factor from Takahashi et al, 2009 equation 8
-  // unit conversion * solubility * Schmidt number * wind speed^2
-
   //------------------------------------------------------------------------
   /*! \brief calculate Omega of Ca/Ar
    * Uses Ksp of Ca and Ar, CO3, S, and pH
    */
 
-  // this is 0.010285*S/35
-  const double calcium =
-      0.02128 / 40.087 *
-      (S /
-       1.80655); // mol/kg Riley, and Tongudai, Chemical Geology 2:263-269, 1967
-  OmegaCa.set(((co3 * calcium) / Kspc), U_UNITLESS);
-  OmegaAr.set(((co3 * calcium) / Kspa), U_UNITLESS);
+  OmegaCa.set(((co3 * calcium) / Kspc.value(U_MOL_KG)), U_UNITLESS);
+  OmegaAr.set(((co3 * calcium) / Kspa.value(U_MOL_KG)), U_UNITLESS);
 }
 
 //-------------------------------------------------------------------------------
@@ -372,11 +403,11 @@ Since ALK and DIC are given, solve for pH and pCO2
  *  \return             Monthly atmospheric C flux, gC/m2/month (positive = into
  * ocean)
  */
-double oceancsys::calc_monthly_surface_flux(const unitval &CO2_conc,
-                                            const double cpoolscale) const {
-  // Tr is the gas transfer coefficient
-  return ((CO2_conc.value(U_PPMV_CO2) - PCO2o.value(U_UATM) * cpoolscale) *
-          Tr.value(U_gC_m2_month_uatm)); // units : gC m-2 month-1
+double oceancsys::calc_monthly_surface_flux(
+    const quantity<U_PPMV_CO2> CO2_conc, const double cpoolscale) const {
+  // Tr is the gas transfer coefficient; ppmv CO2 is taken as uatm
+  return ((CO2_conc.value() - PCO2o.value() * cpoolscale) *
+          Tr.value()); // units : gC m-2 month-1
 }
 
 //-------------------------------------------------------------------------------
@@ -386,13 +417,13 @@ double oceancsys::calc_monthly_surface_flux(const unitval &CO2_conc,
  *  \return             Annual atmospheric C flux, Pg C/yr (positive = into
  * ocean)
  */
-unitval oceancsys::calc_annual_surface_flux(const unitval &CO2_conc,
-                                            const double cpoolscale) const {
+quantity<U_PGC_YR>
+oceancsys::calc_annual_surface_flux(const quantity<U_PPMV_CO2> CO2_conc,
+                                    const double cpoolscale) const {
   // Surface flux (gC m-2 month-1) * area of the box * number of months in the
   // year / conversion constant
-  return unitval((calc_monthly_surface_flux(CO2_conc, cpoolscale) * As * 12.0) /
-                     1e15,
-                 U_PGC_YR);
+  return quantity<U_PGC_YR>(
+      (calc_monthly_surface_flux(CO2_conc, cpoolscale) * As * 12.0) / 1e15);
 }
 
 //-------------------------------------------------------------------------------
@@ -40,7 +40,7 @@ oceanbox::oceanbox() {
   surfacebox = false;
   Tbox = unitval(-999, U_DEGC);
   atmosphere_flux.set(0.0, U_PGC);
-  preindustrial_flux.set(0.0, U_PGC_YR);
+  preindustrial_flux = quantity<U_PGC_YR>(0.0);
   ao_flux.set(0.0, U_PGC);
   oa_flux.set(0.0, U_PGC);
 }
@@ -58,11 +58,6 @@ void oceanbox::set_carbon(const unitval C) {
 /*! \brief initialize all needed information in an oceanbox
  */
 void oceanbox::initbox(double boxc, string name) {
-  connection_list.clear();
-  connection_k.clear();
-  connection_window.clear();
-  annual_box_fluxes.clear();
-
   // Each box is separate from each other, and we keep track of carbon in each
   // box
   Name = name;
@@ -89,6 +84,27 @@ void oceanbox::add_carbon(fluxpool carbon) {
       << CarbonSubtractions << ")" << endl;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief                  Set the carbon moved in and out of the box by
+ *                          circulation this timestep
+ *  \param[in] additions    Carbon arriving from other boxes (Pg C)
+ *  \param[in] subtractions Carbon leaving for other boxes (Pg C)
+ *  \param[in] set_additions If false, additions have already arrived via
+ *                          add_carbon() (as they must when tracking carbon),
+ *                          and the value is ignored
+ *
+ *  Like add_carbon(), this only schedules the change; it happens in
+ *  update_state().
+ */
+void oceanbox::set_circulation_fluxes(const double additions,
+                                      const double subtractions,
+                                      const bool set_additions) {
+  if (set_additions) {
+    CarbonAdditions.set(additions, U_PGC, carbon.tracking, Name);
+  }
+  CarbonSubtractions.set(subtractions, U_PGC, carbon.tracking, Name);
+}
+
 //------------------------------------------------------------------------------
 /*! \brief          Compute absolute temperature of box in C
  *  \param[in] SST Mean ocean temperature change from preindustrial, C
@@ -98,48 +114,6 @@ unitval oceanbox::compute_tabsC(const unitval SST) const {
   return SST + unitval(MEAN_TOS_TEMP, U_DEGC) + deltaT;
 }
 
-//------------------------------------------------------------------------------
-/*! \brief          Add (or replace) a box-to-box connection
- *  \param[in] ob   pointer to another oceanbox
- *  \param[in] k    weight of the connection
- *  \param[in] ws   connection window size: 0=current state only, 1=mean of
- * current and 1 year back, etc. \exception      if ob is same as current box
- *
- *  Establishes a one-way connection from the current box to another, with a
- * weight of k. If a connection already exists, it will be overwritten (i.e.
- * only two connections between any two boxes are allowed, one in each
- * direction).  Window establishes how many previous time step connections to
- * use.
- */
-void oceanbox::make_connection(
-    oceanbox *ob, const double k,
-    const int ws) { //, window=1 or whatever we are averaging over.  use curent
-                    // state of 1 or will use what we tell it to use.
-
-  H_ASSERT(ob != this, "can't make connection to same box");
-  OB_LOG(logger, Logger::NOTICE) << "Adding connection " << Name << " to "
-                                 << ob->Name << ", k=" << k << endl;
-
-  // If a connection to this box already exists, replace it
-  for (unsigned i = 0; i < connection_list.size(); i++) {
-    if (connection_list[i] == ob) {
-      connection_k[i] = k;
-      connection_window[i] = ws;
-      OB_LOG(logger, Logger::WARNING)
-          << "** overwriting connection in " << Name << " ** " << endl;
-      OB_LOG(logger, Logger::WARNING)
-          << "** Are you sure about this? ** " << endl;
-      return;
-    }
-  }
-
-  // Otherwise, make a new connection
-  connection_list.push_back(ob); // add new element to vector
-  connection_k.push_back(k);
-  H_ASSERT(ws >= 0, "window negative number");
-  connection_window.push_back(ws);
-}
-
 //------------------------------------------------------------------------------
 double round(const double d) { return floor(d + 0.5); }
 
@@ -147,9 +121,14 @@ double round(const double d) { return floor(d + 0.5); }
 /*! \brief Log the current box state
  *
  *  Writes a variety of information (carbon, temperature, DIC, etc.),
- *  as well as connection summaries, to the active log.
+ *  to the active log.
  */
 void oceanbox::log_state() {
+  // All of this is only computed for the log
+  if (logger == NULL || !logger->shouldWrite(Logger::DEBUG)) {
+    return;
+  }
+
   OB_LOG(logger, Logger::DEBUG)
       << "----- State of " << Name << " box -----" << endl;
   fluxpool futurec =
@@ -186,25 +165,18 @@ void oceanbox::log_state() {
     unitval dic = mychemistry.convertToDIC(carbon);
     OB_LOG(logger, Logger::DEBUG) << "   Surface DIC = " << dic << endl;
   }
-  for (unsigned i = 0; i < connection_list.size(); i++) {
-    OB_LOG(logger, Logger::DEBUG)
-        << "   Connection #" << i << " to " << connection_list[i]->Name
-        << ", k=" << connection_k[i] << ", window=" << connection_window[i]
-        << endl;
-  }
 }
 
 //------------------------------------------------------------------------------
-/*! \brief Compute all fluxes between boxes
+/*! \brief Compute the atmosphere-box flux
  * \param[in] current_Ca                atmospheric CO2
  * \param[in] yf                year fraction (0-1)
- * \param[in] do_circ           flag: do circulation, or not?
  */
 void oceanbox::compute_fluxes(const unitval current_Ca,
-                              const fluxpool atmosphere_cpool, const double yf,
-                              const bool do_circ) {
+                              const fluxpool atmosphere_cpool,
+                              const double yf) {
 
-  CO2_conc = current_Ca;
+  CO2_conc = quantity<U_PPMV_CO2>(current_Ca);
 
   // Step 1 : run chemistry mode, if applicable
   if (active_chemistry) {
@@ -213,14 +185,14 @@ void oceanbox::compute_fluxes(const unitval current_Ca,
 
     mychemistry.ocean_csys_run(Tbox, carbon);
     atmosphere_flux = unitval(
-        mychemistry.calc_annual_surface_flux(CO2_conc).value(U_PGC_YR), U_PGC);
+        mychemistry.calc_annual_surface_flux(CO2_conc).value(), U_PGC);
 
   } else {
     // No active chemistry, so atmosphere-box flux is simply a function of the
     // difference between box carbon and atmospheric carbon s.t. it is
     // preindustrial_flux
     if (surfacebox)
-      atmosphere_flux = unitval(preindustrial_flux.value(U_PGC_YR), U_PGC);
+      atmosphere_flux = unitval(preindustrial_flux.value(), U_PGC);
     else
       atmosphere_flux = unitval(0.0, U_PGC);
   }
@@ -229,34 +201,6 @@ void oceanbox::compute_fluxes(const unitval current_Ca,
   atmosphere_flux = atmosphere_flux * yf;
 
   separate_surface_fluxes(atmosphere_cpool);
-
-  // Step 3: check if this box is oscillating
-  /*
-  const bool osc = oscillating( 10, // over the last 10 states,
-                                 1,   // has box C varied by >1%
-                                 3 ); // while changing direction 3+ times?
-  */
-
-  // Step 4 : calculate the carbon transports between the boxes
-  if (do_circ) {
-    fluxpool closs_total(0.0, U_PGC, carbon.tracking);
-
-    for (unsigned i = 0; i < connection_window.size(); i++) {
-
-      fluxpool closs = carbon * connection_k[i] * yf;
-
-      OB_LOG(logger, Logger::DEBUG)
-          << Name << " conn " << i << " flux= " << closs << endl;
-
-      connection_list[i]->add_carbon(closs);
-      CarbonSubtractions = CarbonSubtractions + closs; // PgC
-      closs_total = closs_total + closs;
-      annual_box_fluxes[connection_list[i]] =
-          annual_box_fluxes[connection_list[i]] +
-          unitval(closs.value(U_PGC), U_PGC_YR);
-    } // for i
-
-  } // if do_circulation
 }
 
 void oceanbox::separate_surface_fluxes(fluxpool atmosphere_pool) {
@@ -308,9 +252,6 @@ void oceanbox::update_state() {
  */
 void oceanbox::new_year(const unitval SST) {
 
-  for (unsigned i = 0; i < connection_window.size(); i++) {
-    annual_box_fluxes[connection_list[i]] = unitval(0.0, U_PGC_YR);
-  }
   Tbox = compute_tabsC(SST);
 
   // save for Revelle Calc
@@ -340,7 +281,7 @@ double oceanbox::fmin(double alk, void *params) {
 
   double f_target = *(double *)params;
   double diff =
-      fabs(mychemistry.calc_annual_surface_flux(CO2_conc).value(U_PGC_YR) -
+      fabs(mychemistry.calc_annual_surface_flux(CO2_conc).value() -
            f_target);
   //    OB_LOG( logger, Logger::DEBUG) << "fmin at " << alk << ", f_target=" <<
   //    f_target << ", returning " << diff << endl;
@@ -383,7 +324,7 @@ void oceanbox::chem_equilibrate(const unitval current_Ca) {
 
   using namespace std;
 
-  CO2_conc = current_Ca;
+  CO2_conc = quantity<U_PPMV_CO2>(current_Ca);
 
   H_ASSERT(active_chemistry, "chemistry not turned on");
   OB_LOG(logger, Logger::DEBUG)
@@ -406,7 +347,7 @@ void oceanbox::chem_equilibrate(const unitval current_Ca) {
   // f0 passed in
 
   double alk_min = 2100e-6, alk_max = 2750e-6;
-  double f_target = preindustrial_flux.value(U_PGC_YR);
+  double f_target = preindustrial_flux.value();
 
   // Find a best-guess point; the GSL algorithm seems to need it
   OB_LOG(logger, Logger::DEBUG) << "Looking for best-guess alkalinity" << endl;
@@ -13,6 +13,7 @@
  */
 
 #include "oh_component.hpp"
+#include "atmospheric_chemistry_engine.hpp"
 #include "avisitor.hpp"
 #include "core.hpp"
 #include "h_util.hpp"
@@ -25,7 +26,7 @@ using namespace std;
 //------------------------------------------------------------------------------
 /*! \brief Constructor
  */
-OHComponent::OHComponent() {
+OHComponent::OHComponent() : engine(NULL) {
   NOX_emissions.allowInterp(true);
   NMVOC_emissions.allowInterp(true);
   CO_emissions.allowInterp(true);
@@ -49,9 +50,7 @@ string OHComponent::getComponentName() const {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void OHComponent::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
   core = coreptr;
 
@@ -87,6 +86,10 @@ unitval OHComponent::sendMessage(const std::string &message,
 //------------------------------------------------------------------------------
 // documentation is inherited
 void OHComponent::setData(const string &varName, const message_data &data) {
+  if (engine) {
+    engine->invalidate();
+  }
+
   try {
     if (varName == D_EMISSIONS_NOX) {
       H_ASSERT(data.date != Core::undefinedIndex(), "date required");
@@ -130,46 +133,40 @@ void OHComponent::prepareToRun() {
   // get intial CH4 concentration
   M0 = core->sendMessage(M_GETDATA, D_PREINDUSTRIAL_CH4);
   TAU_OH.set(oldDate, TOH0);
+  if (engine) {
+    engine->invalidate();
+  }
 }
 
 //------------------------------------------------------------------------------
 // documentation is inherited
 void OHComponent::run(const double runToDate) {
+  if (engine) {
+    // The core has already run the engine for this year
+    H_ASSERT(oldDate == runToDate, "chemistry engine has not been run");
+    return;
+  }
   H_LOG(logger, Logger::DEBUG)
       << "olddate:  " << oldDate << " runToDate: " << runToDate << std::endl;
-  H_ASSERT(!core->inSpinup() && runToDate - oldDate == 1,
-           "timestep must equal 1");
-
-  // modified from Tanaka et al 2007 and Wigley et al 2002.
-  unitval current_nox = NOX_emissions.get(runToDate);
-  unitval current_co = CO_emissions.get(runToDate);
-  unitval current_nmvoc = NMVOC_emissions.get(runToDate);
+  H_CHECK(!core->inSpinup() && runToDate - oldDate == 1,
+          "timestep must equal 1");
+
+  // Emissions relative to the first year
+  const double dNOX =
+      NOX_emissions.get(runToDate).value(U_TG_N) -
+      NOX_emissions.get(NOX_emissions.firstdate()).value(U_TG_N);
+  const double dCO = CO_emissions.get(runToDate).value(U_TG_CO) -
+                     CO_emissions.get(CO_emissions.firstdate()).value(U_TG_CO);
+  const double dNMVOC =
+      NMVOC_emissions.get(runToDate).value(U_TG_NMVOC) -
+      NMVOC_emissions.get(NMVOC_emissions.firstdate()).value(U_TG_NMVOC);
 
   // get this from CH4 component, this is last year's value
   const double previous_ch4 =
       core->sendMessage(M_GETDATA, D_CH4_CONC, oldDate).value(U_PPBV_CH4);
 
-  double toh = 0.0;
-  if (previous_ch4 != M0) // if we are not at the first time
-  {
-    const double a =
-        CCH4 * ((1.0 * log(previous_ch4)) - log(M0.value(U_PPBV_CH4)));
-    const double b =
-        CNOX * ((1.0 * current_nox) -
-                NOX_emissions.get(NOX_emissions.firstdate()).value(U_TG_N));
-    const double c =
-        CCO * ((1.0 * +current_co) -
-               CO_emissions.get(CO_emissions.firstdate()).value(U_TG_CO));
-    const double d =
-        CNMVOC *
-        ((1.0 * +current_nmvoc) -
-         NMVOC_emissions.get(NMVOC_emissions.firstdate()).value(U_TG_NMVOC));
-    toh = a + b + c + d;
-    H_LOG(logger, Logger::DEBUG)
-        << "Year " << runToDate << " toh = " << toh << std::endl;
-  }
-
-  TAU_OH.set(runToDate, TOH0 * exp(-toh));
+  TAU_OH.set(runToDate,
+             unitval(lifetime(previous_ch4, dNOX, dCO, dNMVOC), U_YRS));
 
   oldDate = runToDate;
   H_LOG(logger, Logger::DEBUG)
@@ -177,6 +174,30 @@ void OHComponent::run(const double runToDate) {
       << std::endl;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief OH lifetime, given last year's CH4 and this year's emissions.
+ *  \param previous_ch4 Last year's CH4 concentration, ppbv CH4.
+ *  \param dNOX         NOX emissions less the first year's, Tg N.
+ *  \param dCO          CO emissions less the first year's, Tg CO.
+ *  \param dNMVOC       NMVOC emissions less the first year's, Tg NMVOC.
+ *  \returns OH lifetime, years.
+ *  \details Used by run() and by the chemistry engine.
+ */
+double OHComponent::lifetime(const double previous_ch4, const double dNOX,
+                             const double dCO, const double dNMVOC) const {
+  // modified from Tanaka et al 2007 and Wigley et al 2002.
+  double toh = 0.0;
+  if (previous_ch4 != M0) // if we are not at the first time
+  {
+    const double a = CCH4 * (log(previous_ch4) - log(M0.value(U_PPBV_CH4)));
+    const double b = CNOX * dNOX;
+    const double c = CCO * dCO;
+    const double d = CNMVOC * dNMVOC;
+    toh = a + b + c + d;
+  }
+  return TOH0.value(U_YRS) * exp(-toh);
+}
+
 //------------------------------------------------------------------------------
 // documentation is inherited
 unitval OHComponent::getData(const std::string &varName, const double date) {
@@ -207,6 +228,9 @@ unitval OHComponent::getData(const std::string &varName, const double date) {
 // documentation is inherited
 void OHComponent::reset(double time) {
   oldDate = time;
+  if (engine) {
+    engine->invalidate();
+  }
   H_LOG(logger, Logger::NOTICE)
       << getComponentName() << " reset to time= " << time << "\n";
 }
@@ -1,7 +1,9 @@
 #include <Rcpp.h>
 #include <fstream>
+#include <memory>
 #include <sstream>
 
+#include "ensemble_runner.hpp"
 #include "hector.hpp"
 #include "logger.hpp"
 #include "message_data.hpp"
@@ -25,6 +27,32 @@ Hector::Core *gethcore(Environment core) {
   return hcore;
 }
 
+// Finish setting up a new core and construct the handle returned to R.
+Environment newcore_handle(int coreidx, const std::string &inifile,
+                           String name) {
+  Hector::Core *hcore = Hector::Core::getcore(coreidx);
+
+  // Run the last bit of setup
+  hcore->prepareToRun();
+
+  // Construct the object we are going to return to R
+  double strtdate = hcore->getStartDate();
+  double enddate = hcore->getEndDate();
+  double trackdate = hcore->getTrackingDate();
+
+  Environment rv(new_env());
+  rv["coreidx"] = coreidx;
+  rv["strtdate"] = strtdate;
+  rv["enddate"] = enddate;
+  rv["trackdate"] = trackdate;
+  rv["inifile"] = inifile;
+  rv["name"] = name;
+  rv["clean"] = true;
+  rv["reset_date"] = 0;
+
+  return rv;
+}
+
 // This is the C++ implementation of the core constructor.  It should only ever
 // be called from the `newcore` wrapper function.
 // [[Rcpp::export]]
@@ -59,25 +87,47 @@ Environment newcore_impl(String inifile, int loglevel, bool suppresslogging,
       Rcpp::stop(msg.str());
     }
 
-    // Run the last bit of setup
-    hcore->prepareToRun();
-
-    // Construct the object we are going to return to R
-    double strtdate = hcore->getStartDate();
-    double enddate = hcore->getEndDate();
-    double trackdate = hcore->getTrackingDate();
-
-    Environment rv(new_env());
-    rv["coreidx"] = coreidx;
-    rv["strtdate"] = strtdate;
-    rv["enddate"] = enddate;
-    rv["trackdate"] = trackdate;
-    rv["inifile"] = inifile;
-    rv["name"] = name;
-    rv["clean"] = true;
-    rv["reset_date"] = 0;
-
-    return rv;
+    return newcore_handle(coreidx, fn, name);
+  } catch (h_exception &e) {
+    std::stringstream msg;
+    msg << "During hector core setup: " << e;
+    Rcpp::stop(msg.str());
+  }
+}
+
+// Read an input file into a scenario.  It should only ever be called from the
+// `read_scenario` wrapper function.
+// [[Rcpp::export]]
+SEXP read_scenario_impl(String inifile) {
+  std::string fn = inifile;
+  try {
+    return XPtr<Hector::Scenario>(new Hector::Scenario(fn), true);
+  } catch (h_exception &e) {
+    std::stringstream msg;
+    msg << "While parsing hector input file " << fn << ": " << e;
+    Rcpp::stop(msg.str());
+  }
+}
+
+// The C++ implementation of the core constructor for a scenario.  It should
+// only ever be called from the `newcore` wrapper function.
+// [[Rcpp::export]]
+Environment newcore_scenario_impl(SEXP scenario, int loglevel,
+                                  bool suppresslogging, String name) {
+  XPtr<Hector::Scenario> scen(scenario);
+  if (!scen.get()) {
+    // e.g. a scenario saved in an earlier R session
+    Rcpp::stop("Invalid hector scenario; read it again with read_scenario()");
+  }
+  try {
+    int coreidx = Hector::Core::mkcore(
+        !suppresslogging, (Hector::Logger::LogLevel)loglevel, false);
+
+    Hector::Core *hcore = Hector::Core::getcore(coreidx);
+    hcore->init();
+    hcore->applyScenario(*scen);
+
+    return newcore_handle(coreidx, scen->getFileName(), name);
   } catch (h_exception &e) {
     std::stringstream msg;
     msg << "During hector core setup: " << e;
@@ -355,6 +405,130 @@ DataFrame sendmessage(Environment core, String msgtype, String capability,
   return result;
 }
 
+// This is the C++ implementation of the bulk data retrieval used by
+// `fetchvars`.  It returns a list with a dates x vars matrix of values and the
+// units of each value, in the same order.
+// [[Rcpp::export]]
+List fetchvars_impl(Environment core, StringVector vars, NumericVector dates) {
+  Hector::Core *hcore = gethcore(core);
+
+  std::vector<std::string> datums(vars.size());
+  for (R_xlen_t j = 0; j < vars.size(); ++j) {
+    datums[j] = Rcpp::as<std::string>(vars[j]);
+  }
+  std::vector<double> hdates(dates.size());
+  for (R_xlen_t i = 0; i < dates.size(); ++i) {
+    if (NumericVector::is_na(dates[i]))
+      hdates[i] = Hector::Core::undefinedIndex();
+    else
+      hdates[i] = dates[i];
+  }
+
+  std::vector<double> values;
+  std::vector<std::string> units;
+  try {
+    hcore->getDataBlock(datums, hdates, values, units);
+  } catch (h_exception &e) {
+    std::stringstream emsg;
+    emsg << "fetchvars: " << e;
+    Rcpp::stop(emsg.str());
+  }
+
+  NumericMatrix valueout(hdates.size(), datums.size(), values.begin());
+  return List::create(Named("values") = valueout,
+                      Named("units") = wrap(units));
+}
+
+// This is the C++ implementation of `run_ensemble`.  It should only ever be
+// called from that wrapper function.  The input file is read here, on the
+// main thread, because parsing it may call back into R; only the ensemble
+// members themselves are set up and run on worker threads.
+// [[Rcpp::export]]
+List run_ensemble_impl(String inifile, NumericMatrix params,
+                       StringVector param_names, StringVector param_units,
+                       StringVector vars, NumericVector dates, int threads) {
+  const size_t nmember = params.nrow();
+  const size_t nparam = params.ncol();
+  if ((size_t)param_names.size() != nparam ||
+      (size_t)param_units.size() != nparam) {
+    Rcpp::stop("Need one name and one unit for each parameter column.");
+  }
+
+  std::vector<std::string> names(nparam);
+  std::vector<Hector::unit_types> units(nparam);
+  for (size_t p = 0; p < nparam; ++p) {
+    names[p] = Rcpp::as<std::string>(param_names[p]);
+    std::string unitstr = Rcpp::as<std::string>(param_units[p]);
+    try {
+      units[p] = Hector::unitval::parseUnitsName(unitstr);
+    } catch (h_exception &e) {
+      Rcpp::stop("invalid unit type '" + unitstr + "' for parameter " +
+                 names[p]);
+    }
+  }
+
+  std::vector<std::string> datums(vars.size());
+  for (R_xlen_t j = 0; j < vars.size(); ++j) {
+    datums[j] = Rcpp::as<std::string>(vars[j]);
+  }
+  std::vector<double> hdates(dates.size());
+  for (R_xlen_t i = 0; i < dates.size(); ++i) {
+    if (NumericVector::is_na(dates[i]))
+      hdates[i] = Hector::Core::undefinedIndex();
+    else
+      hdates[i] = dates[i];
+  }
+
+  // The input file is read once, here on the main thread, because parsing it
+  // may call back into R; the members' cores are set up from it on the
+  // worker threads.  They belong to the runner, not to the core registry, so
+  // R never holds handles to them.
+  std::string fn = inifile;
+  std::unique_ptr<Hector::Scenario> scenario;
+  try {
+    scenario.reset(new Hector::Scenario(fn));
+  } catch (h_exception &e) {
+    std::stringstream msg;
+    msg << "While setting up ensemble from input file " << fn << ": " << e;
+    Rcpp::stop(msg.str());
+  }
+
+  Hector::EnsembleRunner runner(names, units, datums, hdates);
+  NumericVector valueout(runner.memberSize() * nmember);
+  try {
+    runner.run(*scenario, threads, params.begin(), nmember,
+               valueout.begin());
+  } catch (h_exception &e) {
+    std::stringstream msg;
+    msg << "run_ensemble: " << e;
+    Rcpp::stop(msg.str());
+  }
+
+  // Failed members are flagged with NA rather than NaN
+  const std::vector<std::string> &errors = runner.getErrors();
+  int nfail = 0;
+  for (size_t m = 0; m < nmember; ++m) {
+    if (!errors[m].empty()) {
+      if (nfail++ == 0) {
+        Rcpp::warning("Ensemble member " + std::to_string(m + 1) +
+                      " failed: " + errors[m]);
+      }
+      std::fill(valueout.begin() + m * runner.memberSize(),
+                valueout.begin() + (m + 1) * runner.memberSize(), NA_REAL);
+    }
+  }
+  if (nfail > 1) {
+    Rcpp::warning(std::to_string(nfail) + " of " + std::to_string(nmember) +
+                  " ensemble members failed.");
+  }
+
+  valueout.attr("dim") = IntegerVector::create(
+      (int)hdates.size(), (int)datums.size(), (int)nmember);
+  return List::create(Named("values") = valueout,
+                      Named("units") = wrap(runner.getUnits()),
+                      Named("errors") = wrap(errors));
+}
+
 // helper for isactive()
 // [[Rcpp::export]]
 bool chk_core_valid(Environment core) {
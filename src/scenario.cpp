@@ -0,0 +1,83 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  scenario.cpp
+ *  hector
+ *
+ *  The parsed contents of an input file, for setting up many cores.
+ *
+ */
+
+// some boost headers generate warnings under clang; not our problem, ignore
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Weverything"
+#include <boost/algorithm/string/trim.hpp>
+#pragma clang diagnostic pop
+
+#include "core.hpp"
+#include "h_exception.hpp"
+#include "ini_to_core_reader.hpp"
+#include "scenario.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+/*! \brief Read an input file and the tables it names.
+ *
+ *  The file is read into a scratch core, so every value is checked exactly
+ *  as it would be when reading the file into a core directly.
+ *
+ *  \param filename The INI file to read.
+ *  \exception h_exception Any error reading the file or setting its values.
+ */
+Scenario::Scenario(const string &filename) : fileName(filename) {
+  shared_ptr<vector<ScenarioSetting>> parsed(new vector<ScenarioSetting>());
+  {
+    Core core(Logger::SEVERE, false, false);
+    core.init();
+    core.settingsLog = parsed.get();
+    INIToCoreReader reader(&core);
+    reader.parse(filename);
+  }
+  for (ScenarioSetting &setting : *parsed) {
+    compile(setting.data);
+  }
+  settings = parsed;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Convert a value read as text to a unitval, if it is a number.
+ *  \details The text is kept, for components that want it (e.g. the run
+ *           name, or log messages).  The unitval has the units the text
+ *           gave, or U_UNDEFINED if it gave none, so that
+ *           message_data::getUnitval() accepts and rejects exactly what it
+ *           would for the text.
+ */
+void Scenario::compile(message_data &data) {
+  if (data.isVal) {
+    return;
+  }
+  try {
+    // Units are either in units_str, or after a comma in the value
+    string unitsStr = data.units_str;
+    const size_t comma = data.value_str.find(',');
+    if (unitsStr.empty() && comma != string::npos) {
+      unitsStr = boost::trim_copy(data.value_str.substr(comma + 1));
+    }
+    const unit_types units =
+        unitsStr.empty() ? U_UNDEFINED : unitval::parseUnitsName(unitsStr);
+    data.value_unitval =
+        unitval::parse_unitval(data.value_str, data.units_str, units);
+    data.isVal = true;
+  } catch (h_exception &) {
+    // Not a number; whoever takes it will convert it, or complain
+  }
+}
+
+} // namespace Hector
@@ -0,0 +1,233 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  short_lived_forcer_engine.cpp
+ *  hector
+ *
+ *  Tabulated aerosol and ozone-precursor forcing terms.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "bc_component.hpp"
+#include "core.hpp"
+#include "engine_tables.hpp"
+#include "forcing_component.hpp"
+#include "h_exception.hpp"
+#include "nh3_component.hpp"
+#include "o3_component.hpp"
+#include "oc_component.hpp"
+#include "short_lived_forcer_engine.hpp"
+#include "so2_component.hpp"
+
+namespace Hector {
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+/*! \brief Constructor
+ *  \param core       The core that owns the components.
+ *  \param components The core's (enabled) components; the engine uses
+ *                    whichever of the aerosol, ozone, and forcing components
+ *                    are among them.
+ */
+ShortLivedForcerEngine::ShortLivedForcerEngine(
+    Core *core, const vector<IModelComponent *> &components)
+    : core(core), bc(NULL), oc(NULL), so2(NULL), nh3(NULL), o3(NULL),
+      forcing(NULL), firstDate(0.0), lastTableDate(-1.0), stale(true) {
+  for (auto c : components) {
+    if (!bc) {
+      bc = dynamic_cast<BlackCarbonComponent *>(c);
+    }
+    if (!oc) {
+      oc = dynamic_cast<OrganicCarbonComponent *>(c);
+    }
+    if (!so2) {
+      so2 = dynamic_cast<SulfurComponent *>(c);
+    }
+    if (!nh3) {
+      nh3 = dynamic_cast<NH3Component *>(c);
+    }
+    if (!o3) {
+      o3 = dynamic_cast<OzoneComponent *>(c);
+    }
+    if (!forcing) {
+      forcing = dynamic_cast<ForcingComponent *>(c);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Make sure the tables cover runToDate and are up to date.
+ *  \details Called by the core at the start of each year, before any
+ *           component runs.
+ */
+void ShortLivedForcerEngine::run(const double runToDate) {
+  if (stale || runToDate < firstDate) {
+    load(runToDate);
+  } else if (runToDate > lastTableDate) {
+    extend(runToDate);
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Tabulate the inputs from the start of the run through the end date
+ *         (or runToDate, if that is later), and compute the forcings for
+ *         every year.
+ */
+void ShortLivedForcerEngine::load(const double runToDate) {
+  firstDate = core->getStartDate() + 1;
+  H_ASSERT(runToDate >= firstDate, "date is before the start of the run");
+
+  for (auto table : {&E_BC, &E_OC, &E_SO2, &E_NH3, &E_NOX, &E_CO, &E_NMVOC,
+                     &volcanicRF}) {
+    table->clear();
+  }
+  for (auto &rf : aerosolRF) {
+    rf.clear();
+  }
+  for (auto &terms : ozoneTerms) {
+    terms.clear();
+  }
+  lastTableDate = firstDate - 1;
+  extend(max(runToDate, core->getEndDate()));
+  stale = false;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Add rows to the tables through newLastDate, and compute the
+ *         forcings for the new rows.
+ *  \details Rows already computed are kept, so running past the end date
+ *           costs one row per year.  The forcings and ozone terms use the same
+ *           member functions as ForcingComponent::run() and
+ *           OzoneComponent::run(), so the results are identical.
+ */
+void ShortLivedForcerEngine::extend(const double newLastDate) {
+  const size_t first = static_cast<size_t>(lastTableDate + 1 - firstDate);
+  const size_t nyears = static_cast<size_t>(newLastDate - firstDate) + 1;
+
+  if (hasAerosols() && forcing) {
+    tabulate(bc->BC_emissions, U_TG, firstDate, newLastDate, E_BC);
+    tabulate(oc->OC_emissions, U_TG, firstDate, newLastDate, E_OC);
+    tabulate(so2->SO2_emissions, U_GG_S, firstDate, newLastDate, E_SO2);
+    tabulate(nh3->NH3_emissions, U_TG, firstDate, newLastDate, E_NH3);
+    for (auto &rf : aerosolRF) {
+      rf.resize(nyears);
+    }
+    for (size_t y = first; y < nyears; ++y) {
+      aerosolRF[RF_BC][y] = forcing->ariForcing(forcing->rho_bc, E_BC[y]);
+      aerosolRF[RF_OC][y] = forcing->ariForcing(forcing->rho_oc, E_OC[y]);
+      aerosolRF[RF_SO2][y] = forcing->ariForcing(forcing->rho_so2, E_SO2[y]);
+      aerosolRF[RF_NH3][y] = forcing->ariForcing(forcing->rho_nh3, E_NH3[y]);
+      aerosolRF[RF_ACI][y] = forcing->aciForcing(E_SO2[y], E_BC[y], E_OC[y]);
+    }
+  }
+
+  if (so2 && forcing) {
+    if (so2->SV.size()) {
+      tabulate(so2->SV, U_W_M2, firstDate, newLastDate, volcanicRF);
+    } else {
+      volcanicRF.resize(nyears, 0.0);
+    }
+    for (size_t y = first; y < nyears; ++y) {
+      volcanicRF[y] = forcing->volcanicForcing(volcanicRF[y]);
+    }
+  }
+
+  if (o3) {
+    tabulate(o3->NOX_emissions, U_TG_N, firstDate, newLastDate, E_NOX);
+    tabulate(o3->CO_emissions, U_TG_CO, firstDate, newLastDate, E_CO);
+    tabulate(o3->NMVOC_emissions, U_TG_NMVOC, firstDate, newLastDate,
+             E_NMVOC);
+    for (auto &terms : ozoneTerms) {
+      terms.resize(nyears);
+    }
+    for (size_t y = first; y < nyears; ++y) {
+      ozoneTerms[O3_NOX][y] = OzoneComponent::noxTerm(E_NOX[y]);
+      ozoneTerms[O3_CO][y] = OzoneComponent::coTerm(E_CO[y]);
+      ozoneTerms[O3_NMVOC][y] = OzoneComponent::nmvocTerm(E_NMVOC[y]);
+    }
+  }
+
+  lastTableDate = newLastDate;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Index of a date in the tables.
+ */
+size_t ShortLivedForcerEngine::row(const double date) const {
+  H_ASSERT(!stale && date >= firstDate && date <= lastTableDate,
+           "short-lived forcer engine has not been run for this date");
+  return static_cast<size_t>(date - firstDate);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief The aerosol forcings in a year.
+ *  \param date The year.
+ *  \param rf   Filled with the N_AEROSOL_FORCINGS forcings, W/m2.
+ */
+void ShortLivedForcerEngine::getAerosolForcings(const double date,
+                                                double rf[]) const {
+  H_ASSERT(hasAerosols() && forcing, "aerosol components are not enabled");
+  const size_t y = row(date);
+  for (int i = 0; i < N_AEROSOL_FORCINGS; ++i) {
+    rf[i] = aerosolRF[i][y];
+    if (std::isnan(rf[i])) {
+      checkAerosolInputs(date);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief The volcanic forcing in a year, W/m2.
+ */
+double ShortLivedForcerEngine::getVolcanicForcing(const double date) const {
+  H_ASSERT(hasVolcanic() && forcing, "SO2 component is not enabled");
+  const double rf = volcanicRF[row(date)];
+  if (std::isnan(rf)) {
+    // Let the time series say why it's missing
+    so2->SV.get(date);
+    H_THROW("No volcanic forcing for this date");
+  }
+  return rf;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief The ozone precursor terms in a year.
+ *  \param date  The year.
+ *  \param terms Filled with the N_OZONE_PRECURSORS terms, DU.
+ */
+void ShortLivedForcerEngine::getOzonePrecursors(const double date,
+                                                double terms[]) const {
+  H_ASSERT(o3, "ozone component is not enabled");
+  const size_t y = row(date);
+  for (int i = 0; i < N_OZONE_PRECURSORS; ++i) {
+    terms[i] = ozoneTerms[i][y];
+  }
+  if (std::isnan(terms[O3_NOX] + terms[O3_CO] + terms[O3_NMVOC])) {
+    // Let the time series say why it's missing
+    o3->NOX_emissions.get(date);
+    o3->CO_emissions.get(date);
+    o3->NMVOC_emissions.get(date);
+    H_THROW("No ozone precursor emissions for this date");
+  }
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Throw the error that looking up a missing aerosol emission gives.
+ */
+void ShortLivedForcerEngine::checkAerosolInputs(const double date) const {
+  bc->BC_emissions.get(date);
+  oc->OC_emissions.get(date);
+  so2->SO2_emissions.get(date);
+  nh3->NH3_emissions.get(date);
+  H_THROW("No aerosol emissions for this date");
+}
+
+} // namespace Hector
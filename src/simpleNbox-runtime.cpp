@@ -38,22 +38,24 @@ using namespace boost;
  */
 void SimpleNbox::log_pools(const double t, const string msg) {
   // Log pool states
-  H_LOG(logger, Logger::DEBUG)
-      << "---- pool states at t=" << t << " " << msg << " ----" << std::endl;
-  H_LOG(logger, Logger::DEBUG) << "Atmos = " << atmos_c << std::endl;
-  H_LOG(logger, Logger::DEBUG)
-      << "Biome \tveg_c \t\tdetritus_c \tsoil_c \tpermafrost_c "
-         "\tthawed_permafrost_c \tstatic_c"
-      << std::endl;
-  for (auto biome : biome_list) {
+  H_DIAGNOSTICS(logger, Logger::DEBUG) {
     H_LOG(logger, Logger::DEBUG)
-        << biome << "\t" << veg_c[biome].value(U_PGC) << "\t\t"
-        << detritus_c[biome].value(U_PGC) << "\t\t"
-        << soil_c[biome].value(U_PGC) << "\t\t"
-        << permafrost_c[biome].value(U_PGC) << "\t\t"
-        << thawed_permafrost_c[biome].value(U_PGC) << "\t\t" << std::endl;
+        << "---- pool states at t=" << t << " " << msg << " ----" << std::endl;
+    H_LOG(logger, Logger::DEBUG) << "Atmos = " << atmos_c << std::endl;
+    H_LOG(logger, Logger::DEBUG)
+        << "Biome \tveg_c \t\tdetritus_c \tsoil_c \tpermafrost_c "
+           "\tthawed_permafrost_c \tstatic_c"
+        << std::endl;
+    for (auto biome : biome_list) {
+      H_LOG(logger, Logger::DEBUG)
+          << biome << "\t" << veg_c[biome].value(U_PGC) << "\t\t"
+          << detritus_c[biome].value(U_PGC) << "\t\t"
+          << soil_c[biome].value(U_PGC) << "\t\t"
+          << permafrost_c[biome].value(U_PGC) << "\t\t"
+          << thawed_permafrost_c[biome].value(U_PGC) << "\t\t" << std::endl;
+    }
+    H_LOG(logger, Logger::DEBUG) << "Earth = " << earth_c << std::endl;
   }
-  H_LOG(logger, Logger::DEBUG) << "Earth = " << earth_c << std::endl;
 }
 
 //------------------------------------------------------------------------------
@@ -147,12 +149,12 @@ void SimpleNbox::prepareToRun() {
                                    D_THAWEDPC);
   }
   // Lognormal distribution for current biome's mu and sigma
-  // We precompute these (one for each biome) since they don't change over time
+  // We precompute these (one for each biome) since they don't change over time;
+  // the CDF is tabulated, and tables are shared between cores
   // This is equation 10 in Woodard et al. 2021
   // https://doi.org/10.5194/gmd-14-4751-2021
   for (auto biome : biome_list) {
-    boost::math::lognormal s(pf_mu.at(biome), pf_sigma.at(biome));
-    pf_s[biome] = s;
+    pf_s[biome] = LognormalCDFTable::get(pf_mu.at(biome), pf_sigma.at(biome));
   }
 
   // Zero the cumulative tracker of CH4 release from permafrost
@@ -485,7 +487,8 @@ void SimpleNbox::stashCValues(double t, const double c[]) {
       // We pass in the annual fluxes here, because want annual thaw and
       // refreeze
       auto [x, y, z] =
-          compute_pf_thaw_refreeze(biome, rh_ftpa_co2_adj, rh_ftpa_ch4_adj);
+          compute_pf_thaw_refreeze(biome, rh_ftpa_co2_adj.value(U_PGC_YR),
+                                   rh_ftpa_ch4_adj.value(U_PGC_YR));
       // Construct fluxes...
       fluxpool pf_thaw =
           yf * permafrost_c[biome].flux_from_fluxpool(fluxpool(x, U_PGC_YR));
@@ -503,7 +506,7 @@ void SimpleNbox::stashCValues(double t, const double c[]) {
     }
 
     // Update litter from veg to soil and detritus
-    fluxpool litter_flux = veg_c[biome] * (0.035 * yf);
+    fluxpool litter_flux = veg_c[biome] * (LITTER_RATE * yf);
     fluxpool litter_fvd_flux = litter_flux * f_litterd.at(biome);
     fluxpool litter_fvs_flux = litter_flux * (1 - f_litterd.at(biome));
     detritus_c[biome] = detritus_c[biome] + litter_fvd_flux;
@@ -511,7 +514,7 @@ void SimpleNbox::stashCValues(double t, const double c[]) {
     veg_c[biome] = veg_c[biome] - litter_flux;
 
     // Update detritus and soil with detsoil flux
-    fluxpool detsoil_flux = detritus_c[biome] * (0.6 * yf);
+    fluxpool detsoil_flux = detritus_c[biome] * (DETSOIL_RATE * yf);
     soil_c[biome] = soil_c[biome] + detsoil_flux;
     // Detritus is a small pool that turns over very quickly (i.e. has large
     // fluxes in and out). As a result calculating it this way produces lots of
@@ -620,18 +623,16 @@ double SimpleNbox::calc_co2fert(std::string biome, double time) const {
  *  \returns    current annual NPP
  */
 fluxpool SimpleNbox::npp(std::string biome, double time) const {
-  fluxpool npp(npp_flux0.at(biome).value(U_PGC_YR),
-               U_PGC_YR); // 'at' throws exception if not found
+  double fert;
   if (time == Core::undefinedIndex()) {
-    npp = npp * co2fert.at(biome); // that's why used here instead of []
+    fert = co2fert.at(biome); // 'at' throws exception if not found
   } else {
-    npp = npp * calc_co2fert(biome, time);
+    fert = calc_co2fert(biome, time);
   }
 
-  // LUC causes loss (or gains) to vegetation; account for this
-  npp = npp * npp_luc_adjust;
-
-  return npp;
+  // LUC causes loss (or gains) to vegetation; npp_flux accounts for this
+  return fluxpool(npp_flux(npp_flux0.at(biome).value(), fert, npp_luc_adjust),
+                  U_PGC_YR);
 }
 
 //------------------------------------------------------------------------------
@@ -660,8 +661,7 @@ fluxpool SimpleNbox::rh_fda(std::string biome, double time) const {
     det_t = detritus_c_tv.get(time).at(biome);
     tfd = tempfertd_tv.get(time).at(biome);
   }
-  fluxpool dflux(det_t.value(U_PGC) * 0.25, U_PGC_YR);
-  return dflux * tfd;
+  return fluxpool(rh_det_flux(det_t.value(U_PGC), tfd), U_PGC_YR);
 }
 
 //------------------------------------------------------------------------------
@@ -678,8 +678,7 @@ fluxpool SimpleNbox::rh_fsa(std::string biome, double time) const {
     soil_t = soil_c_tv.get(time).at(biome);
     tfs = tempferts_tv.get(time).at(biome);
   }
-  fluxpool soilflux(soil_t.value(U_PGC) * 0.02, U_PGC_YR);
-  return soilflux * tfs;
+  return fluxpool(rh_soil_flux(soil_t.value(U_PGC), tfs), U_PGC_YR);
 }
 
 //------------------------------------------------------------------------------
@@ -688,16 +687,20 @@ fluxpool SimpleNbox::rh_fsa(std::string biome, double time) const {
  */
 fluxpool SimpleNbox::rh_ftpa_co2(std::string biome, double time) const {
   double tfs;
-  fluxpool tpfc;
+  double tpfc;
+  double labile_frac;
   if (time == Core::undefinedIndex()) {
     tfs = tempferts.at(biome);
-    tpfc = thawed_permafrost_c.at(biome) * (1 - fpf_static.at(biome));
+    tpfc = thawed_permafrost_c.at(biome).value(U_PGC);
+    labile_frac = 1 - fpf_static.at(biome);
   } else {
     tfs = tempferts_tv.get(time).at(biome);
-    tpfc = thawed_permafrost_c_tv.get(time).at(biome) * fpf_static.at(biome);
+    tpfc = thawed_permafrost_c_tv.get(time).at(biome).value(U_PGC);
+    labile_frac = fpf_static.at(biome);
   }
-  fluxpool tpflux(tpfc.value(U_PGC) * 0.02, U_PGC_YR);
-  return tpflux * tfs * (1.0 - rh_ch4_frac.at(biome));
+  return fluxpool(
+      rh_thawedp_co2_flux(tpfc, labile_frac, tfs, rh_ch4_frac.at(biome)),
+      U_PGC_YR);
 }
 
 //------------------------------------------------------------------------------
@@ -706,8 +709,9 @@ fluxpool SimpleNbox::rh_ftpa_co2(std::string biome, double time) const {
  */
 fluxpool SimpleNbox::rh_ftpa_ch4(std::string biome, double time) const {
   // Calculate the CO2 flux, then calculate CH4 component of total
-  return rh_ftpa_co2(biome, time) / (1.0 - rh_ch4_frac.at(biome)) *
-         rh_ch4_frac.at(biome);
+  return fluxpool(rh_thawedp_ch4_flux(rh_ftpa_co2(biome, time).value(U_PGC_YR),
+                                      rh_ch4_frac.at(biome)),
+                  U_PGC_YR);
 }
 
 //------------------------------------------------------------------------------
@@ -735,15 +739,15 @@ fluxpool SimpleNbox::sum_rh(double time) const {
 //------------------------------------------------------------------------------
 /*! \brief      Compute permafrost thaw and refreeze fluxes
  *  \param biome Name of the biome, a string
- *  \param rh_co2 Flux of CO2-C from thawed permafrost
- *  \param rh_ch4 Flux of CH4-C from thawed permafrost
+ *  \param rh_co2 Flux of CO2-C from thawed permafrost (Pg C/yr)
+ *  \param rh_ch4 Flux of CH4-C from thawed permafrost (Pg C/yr)
  *  \returns    A tuple of pf_thaw_c, pf_refreeze_tp, pf_refreeze_soil (Pg C,
  * but all doubles for speed) \note This logic follows Woodard et al. 2021
  * https://gmd.copernicus.org/articles/14/4751/2021/
  */
 tuple<double, double, double>
-SimpleNbox::compute_pf_thaw_refreeze(string biome, fluxpool rh_co2,
-                                     fluxpool rh_ch4) const {
+SimpleNbox::compute_pf_thaw_refreeze(const string &biome, const double rh_co2,
+                                     const double rh_ch4) const {
 
   H_ASSERT(!in_spinup, "We should not be here!");
 
@@ -759,8 +763,7 @@ SimpleNbox::compute_pf_thaw_refreeze(string biome, fluxpool rh_co2,
     const double pf_refreeze = -biome_c_thaw;
     biome_c_thaw = 0.0;
     const double thawed_remaining = thawed_permafrost_c.at(biome).value(U_PGC) -
-                                    rh_co2.value(U_PGC_YR) -
-                                    rh_ch4.value(U_PGC_YR);
+                                    rh_co2 - rh_ch4;
     pf_refreeze_tp = std::min(pf_refreeze, thawed_remaining);
     // TODO: allowing soil refreeze causes biome tests to fail
     // (see #xxx). Since this has a negligible climate impact,
@@ -783,104 +786,109 @@ int SimpleNbox::calcderivs(double t, const double c[], double dcdt[]) const {
   // Atmosphere-ocean flux is calculated by ocean_component
   const int omodel_err = omodel->calcderivs(t, c, dcdt);
   const double ao_exchange = dcdt[SNBOX_OCEAN];
-  fluxpool ocean_uptake(0.0, U_PGC_YR);
-  fluxpool ocean_release(0.0, U_PGC_YR);
+  double ocean_uptake = 0.0;
+  double ocean_release = 0.0;
   if (ao_exchange >= 0.0) {
-    ocean_uptake.set(ao_exchange, U_PGC_YR);
+    ocean_uptake = ao_exchange;
   } else {
-    ocean_release.set(-ao_exchange, U_PGC_YR);
+    ocean_release = -ao_exchange;
   }
 
-  // NPP: Net primary productivity
-  fluxpool npp_biome(0.0, U_PGC_YR);
-  fluxpool npp_current(0.0, U_PGC_YR);
-  fluxpool npp_fav(0.0, U_PGC_YR);
-  fluxpool npp_fad(0.0, U_PGC_YR);
-  fluxpool npp_fas(0.0, U_PGC_YR);
-
-  // RH: heterotrophic respiration from detritus and soil
-  // Permafrost HR is handled below
-  fluxpool rh_fda_current(0.0, U_PGC_YR);
-  fluxpool rh_fsa_current(0.0, U_PGC_YR);
-  // Heterotrophic respiration (CO2 and CH4) from thawed permafrost
-  fluxpool rh_ftpa_co2_current(0.0, U_PGC_YR);
-  fluxpool rh_ftpa_ch4_current(0.0, U_PGC_YR);
+  // All land fluxes are computed in a single pass over the biomes, looking up
+  // each biome's state and parameters once and summing into plain doubles
+  // (Pg C/yr). Each sum is accumulated in biome_list order, and each
+  // per-biome flux comes from the same helpers that npp(), rh_fda(), etc.
+  // use, so the results are identical to summing those functions' outputs.
 
-  for (auto biome : biome_list) {
-    // NPP is scaled by CO2 from preindustrial value
-    npp_biome = npp(biome);
-    npp_current = npp_current + npp_biome;
-    npp_fav = npp_fav + npp_biome * f_nppv.at(biome);
-    npp_fad = npp_fad + npp_biome * f_nppd.at(biome);
-    npp_fas = npp_fas + npp_biome * (1 - f_nppv.at(biome) - f_nppd.at(biome));
-    rh_fda_current = rh_fda_current + rh_fda(biome);
-    rh_fsa_current = rh_fsa_current + rh_fsa(biome);
-    rh_ftpa_co2_current = rh_ftpa_co2_current + rh_ftpa_co2(biome);
-    rh_ftpa_ch4_current = rh_ftpa_ch4_current + rh_ftpa_ch4(biome);
-  }
-  fluxpool rh_current = rh_fda_current + rh_fsa_current + rh_ftpa_co2_current;
-  fluxpool rh_ch4_current = rh_ftpa_ch4_current;
+  // NPP: Net primary productivity
+  double npp_current = 0.0;
+  double npp_fav = 0.0;
+  double npp_fad = 0.0;
+  double npp_fas = 0.0;
+
+  // RH: heterotrophic respiration from detritus and soil, and
+  // heterotrophic respiration (CO2 and CH4) from thawed permafrost
+  double rh_fda_current = 0.0;
+  double rh_fsa_current = 0.0;
+  double rh_ftpa_co2_current = 0.0;
+  double rh_ftpa_ch4_current = 0.0;
+
+  // Detritus flux comes from the vegetation pool, and some detritus goes
+  // to soil
+  double litter_flux = 0.0;
+  double litter_fvd = 0.0;
+  double litter_fvs = 0.0;
+  double detsoil_flux = 0.0;
 
-  // Detritus flux comes from the vegetation pool
-  fluxpool litter_flux(0.0, U_PGC_YR);
-  fluxpool litter_fvd(0.0, U_PGC_YR);
-  fluxpool litter_fvs(0.0, U_PGC_YR);
-  for (auto biome : biome_list) {
-    fluxpool v = fluxpool(veg_c.at(biome).value(U_PGC) * 0.035, U_PGC_YR);
-    litter_flux = litter_flux + v;
-    litter_fvd = litter_fvd + v * f_litterd.at(biome);
-    litter_fvs = litter_fvs + v * (1 - f_litterd.at(biome));
-  }
+  // As permafrost thaws, the C is mobilized into the thawed permafrost pool.
+  double pf_thaw_c = 0.0;
+  double pf_refreeze_tp = 0.0;
+  double pf_refreeze_soil = 0.0;
 
-  // Some detritus goes to soil
-  fluxpool detsoil_flux(0.0, U_PGC_YR);
-  for (auto biome : biome_list) {
-    detsoil_flux = detsoil_flux +
-                   fluxpool(detritus_c.at(biome).value(U_PGC) * 0.6, U_PGC_YR);
+  for (const auto &biome : biome_list) {
+    // NPP is scaled by CO2 from preindustrial value
+    const double npp_biome = npp_flux(npp_flux0.at(biome).value(),
+                                      co2fert.at(biome), npp_luc_adjust);
+    const double fv = f_nppv.at(biome);
+    const double fd = f_nppd.at(biome);
+    npp_current += npp_biome;
+    npp_fav += npp_biome * fv;
+    npp_fad += npp_biome * fd;
+    npp_fas += npp_biome * (1 - fv - fd);
+
+    const double det = detritus_c.at(biome).value(U_PGC);
+    const double tfs = tempferts.at(biome);
+    const double ch4_frac = rh_ch4_frac.at(biome);
+    const double rh_co2 =
+        rh_thawedp_co2_flux(thawed_permafrost_c.at(biome).value(U_PGC),
+                            1 - fpf_static.at(biome), tfs, ch4_frac);
+    const double rh_ch4 = rh_thawedp_ch4_flux(rh_co2, ch4_frac);
+    rh_fda_current += rh_det_flux(det, tempfertd.at(biome));
+    rh_fsa_current += rh_soil_flux(soil_c.at(biome).value(U_PGC), tfs);
+    rh_ftpa_co2_current += rh_co2;
+    rh_ftpa_ch4_current += rh_ch4;
+
+    const double v = veg_c.at(biome).value(U_PGC) * LITTER_RATE;
+    const double fld = f_litterd.at(biome);
+    litter_flux += v;
+    litter_fvd += v * fld;
+    litter_fvs += v * (1 - fld);
+    detsoil_flux += det * DETSOIL_RATE;
+
+    if (!in_spinup) { // No permafrost dynamics during spinup
+      auto [biome_c_thaw, biome_pf_refreeze_tp, biome_pf_refreeze_soil] =
+          compute_pf_thaw_refreeze(biome, rh_co2, rh_ch4);
+      pf_thaw_c += biome_c_thaw;
+      pf_refreeze_tp += biome_pf_refreeze_tp;
+      pf_refreeze_soil += biome_pf_refreeze_soil;
+    }
   }
+  double rh_current = rh_fda_current + rh_fsa_current + rh_ftpa_co2_current;
 
   // Land-use change emissions come from veg, detritus, and soil proportionately
+  const double luc_e = current_luc_e.value(U_PGC_YR);
+  const double luc_u = current_luc_u.value(U_PGC_YR);
   const double total = c[SNBOX_VEG] + c[SNBOX_DET] + c[SNBOX_SOIL];
-  fluxpool luc_fva = current_luc_e * c[SNBOX_VEG] / total;
-  fluxpool luc_fda = current_luc_e * c[SNBOX_DET] / total;
-  fluxpool luc_fsa = current_luc_e * c[SNBOX_SOIL] / total;
+  const double luc_fva = luc_e * c[SNBOX_VEG] / total;
+  const double luc_fda = luc_e * c[SNBOX_DET] / total;
+  const double luc_fsa = luc_e * c[SNBOX_SOIL] / total;
   // ...whereas uptake goes entirely to vegetation
-  fluxpool luc_fav = current_luc_u;
+  const double luc_fav = luc_u;
 
   // Oxidized methane of fossil fuel origin
-  fluxpool ch4ox_current(0.0, U_PGC_YR); // TODO: implement this
-
-  // As permafrost thaws, the C is mobilized into the thawed permafrost pool.
-  fluxpool pf_thaw_c(0.0, U_PGC_YR);
-  fluxpool pf_refreeze_tp(0.0, U_PGC_YR);
-  fluxpool pf_refreeze_soil(0.0, U_PGC_YR);
-  if (!in_spinup) { // No permafrost dynamics during spinup
-    // Sum permafrost thaw and refreeze across all biomes
-    for (auto biome : biome_list) {
-      auto [biome_c_thaw, biome_pf_refreeze_tp, biome_pf_refreeze_soil] =
-          compute_pf_thaw_refreeze(biome, rh_ftpa_co2(biome),
-                                   rh_ftpa_ch4(biome));
-      pf_thaw_c = pf_thaw_c + fluxpool(biome_c_thaw, U_PGC_YR);
-      pf_refreeze_tp =
-          pf_refreeze_tp + fluxpool(biome_pf_refreeze_tp, U_PGC_YR);
-      pf_refreeze_soil =
-        pf_refreeze_soil + fluxpool(biome_pf_refreeze_soil, U_PGC_YR);
-    }
-  }
+  const double ch4ox_current = 0.0; // TODO: implement this
 
   // If user has supplied NBP (net biome production) values,
   // adjust NPP and RH to match
   const int rounded_t = round(t);
   if (!in_spinup && NBP_constrain.size() && NBP_constrain.exists(rounded_t)) {
     // Compute how different we are from the user-specified constraint
-    const double nbp =
-        npp_current.value(U_PGC_YR) - rh_current.value(U_PGC_YR) -
-        current_luc_e.value(U_PGC_YR) + current_luc_u.value(U_PGC_YR);
-    const unitval diff = NBP_constrain.get(rounded_t) - unitval(nbp, U_PGC_YR);
+    const double nbp = npp_current - rh_current - luc_e + luc_u;
+    const double diff = NBP_constrain.get(rounded_t).value(U_PGC_YR) - nbp;
 
     // Adjust total NPP and total RH equally (but not LUC, which is an input)
     // so that their net total will match the NBP constraint
-    fluxpool npp_current_old = npp_current;
+    const double npp_current_old = npp_current;
     npp_current = npp_current + diff / 2.0;
     // ...also need to adjust their sub-components
     const double npp_ratio = npp_current / npp_current_old;
@@ -889,46 +897,43 @@ int SimpleNbox::calcderivs(double t, const double c[], double dcdt[]) const {
     npp_fas = npp_fas * npp_ratio;
 
     // Do same thing for the RH sub-components
-    fluxpool rh_current_old = rh_current;
+    const double rh_current_old = rh_current;
     rh_current = rh_current - diff / 2.0;
     const double rh_ratio = rh_current / rh_current_old;
     rh_fda_current = rh_fda_current * rh_ratio;
     rh_fsa_current = rh_fsa_current * rh_ratio;
     rh_ftpa_co2_current = rh_ftpa_co2_current * rh_ratio;
+
+    H_ASSERT(npp_current >= 0 && rh_current >= 0,
+             "NBP constraint makes NPP or RH negative");
   }
 
   // Compute fluxes
+  const double ffi_e = current_ffi_e.value(U_PGC_YR);
+  const double daccs_u = current_daccs_u.value(U_PGC_YR);
   dcdt[SNBOX_ATMOS] = // change in atmosphere pool
-      current_ffi_e.value(U_PGC_YR) - current_daccs_u.value(U_PGC_YR) +
-      current_luc_e.value(U_PGC_YR) - current_luc_u.value(U_PGC_YR) +
-      ch4ox_current.value(U_PGC_YR) - ocean_uptake.value(U_PGC_YR) +
-      ocean_release.value(U_PGC_YR) -
-      npp_current.value(U_PGC_YR)
+      ffi_e - daccs_u + luc_e - luc_u + ch4ox_current - ocean_uptake +
+      ocean_release -
+      npp_current
       // Note that RH{CH4} exits thawed permafrost below but does not,
       // from the solver's point of view, go into the atmosphere. We deal
       // with the resulting mass-balance problem in stashCValues() above.
-      + rh_current.value(U_PGC_YR);
+      + rh_current;
   dcdt[SNBOX_VEG] = // change in vegetation pool
-      npp_fav.value(U_PGC_YR) - litter_flux.value(U_PGC_YR) -
-      luc_fva.value(U_PGC_YR) + luc_fav.value(U_PGC_YR);
+      npp_fav - litter_flux - luc_fva + luc_fav;
   dcdt[SNBOX_DET] = // change in detritus pool
-      npp_fad.value(U_PGC_YR) + litter_fvd.value(U_PGC_YR) -
-      detsoil_flux.value(U_PGC_YR) - rh_fda_current.value(U_PGC_YR) -
-      luc_fda.value(U_PGC_YR);
+      npp_fad + litter_fvd - detsoil_flux - rh_fda_current - luc_fda;
   dcdt[SNBOX_SOIL] = // change in soil pool
-      npp_fas.value(U_PGC_YR) + litter_fvs.value(U_PGC_YR) +
-      detsoil_flux.value(U_PGC_YR) - rh_fsa_current.value(U_PGC_YR) -
-      pf_refreeze_soil.value(U_PGC_YR) - luc_fsa.value(U_PGC_YR);
+      npp_fas + litter_fvs + detsoil_flux - rh_fsa_current - pf_refreeze_soil -
+      luc_fsa;
   dcdt[SNBOX_PERMAFROST] = // change in permafrost pool
-      -pf_thaw_c.value(U_PGC_YR) + pf_refreeze_soil.value(U_PGC_YR) +
-      pf_refreeze_tp.value(U_PGC_YR);
+      -pf_thaw_c + pf_refreeze_soil + pf_refreeze_tp;
   dcdt[SNBOX_THAWEDP] = // change in thawed permafrost pool
-      pf_thaw_c.value(U_PGC_YR) - pf_refreeze_tp.value(U_PGC_YR) -
-      rh_ftpa_ch4_current.value(U_PGC_YR) - rh_ftpa_co2_current.value(U_PGC_YR);
+      pf_thaw_c - pf_refreeze_tp - rh_ftpa_ch4_current - rh_ftpa_co2_current;
   dcdt[SNBOX_OCEAN] = // change in ocean pool
-      ocean_uptake.value(U_PGC_YR) - ocean_release.value(U_PGC_YR);
+      ocean_uptake - ocean_release;
   dcdt[SNBOX_EARTH] = // change in earth pool
-      -current_ffi_e.value(U_PGC_YR) + current_daccs_u.value(U_PGC_YR);
+      -ffi_e + daccs_u;
 
   return omodel_err;
 }
@@ -1025,7 +1030,7 @@ void SimpleNbox::slowparameval(double t, const double c[]) {
         // Tland_biome <= 0
         double f_frozen_current = 1.0;
         if (Tland_biome > 0) {
-          f_frozen_current = 1 - cdf(pf_s[biome], Tland_biome);
+          f_frozen_current = 1 - pf_s[biome]->cdf(Tland_biome);
           H_LOG(logger, Logger::DEBUG)
               << "slowparameval: f_frozen_current = " << f_frozen_current
               << std::endl;
@@ -323,8 +323,7 @@ void SimpleNbox::setData(const std::string &varName, const message_data &data) {
     // Initial fluxes
     else if (varNameParsed == D_NPP_FLUX0) {
       H_ASSERT(data.date == Core::undefinedIndex(), "date not allowed");
-      npp_flux0[biome] =
-          fluxpool(data.getUnitval(U_PGC_YR).value(U_PGC_YR), U_PGC_YR);
+      npp_flux0[biome] = quantity<U_PGC_YR>(data.getUnitval(U_PGC_YR));
     }
 
     // Fossil fuels and industry contributions time series
@@ -897,7 +896,7 @@ void SimpleNbox::createBiome(const std::string &biome) {
   final_npp[biome] = fluxpool(0, U_PGC_YR, false, D_NPP);
   add_biome_to_ts(final_npp_tv, biome, final_npp.at(biome));
 
-  npp_flux0[biome] = fluxpool(0, U_PGC_YR);
+  npp_flux0[biome] = quantity<U_PGC_YR>(0.0);
 
   // Other defaults (these will be re-calculated later)
   co2fert[biome] = 1.0;
@@ -44,9 +44,7 @@ string slrComponent::getComponentName() const {
 // documentation is inherited
 void slrComponent::init(Core *coreptr) {
 
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
 
   core = coreptr;
@@ -103,10 +101,6 @@ void slrComponent::prepareToRun() {
   H_ASSERT(refperiod_high >= refperiod_low, "bad refperiod");
 }
 
-//------------------------------------------------------------------------------
-
-tseries<double> tgav_vals;
-
 //------------------------------------------------------------------------------
 /*! \brief compute sea-level rise
  * from Vermeer and Rahmstorf (2009)
@@ -121,6 +115,9 @@ void slrComponent::compute_slr(const double date) {
   // First need to compute dTdt, the first derivative of the temperature curve
   double dTdt_double = 0.0;
   if (tgav.size() > 2) {
+    // Built fresh on every call, so that it never holds temperatures left
+    // over from before a reset (or from another core)
+    tseries<double> tgav_vals;
     for (int i = tgav.firstdate(); i <= tgav.lastdate(); i++) {
       tgav_vals.set(i, tgav.get(i).value(U_DEGC));
     }
@@ -50,9 +50,7 @@ string SulfurComponent::getComponentName() const {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void SulfurComponent::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
   core = coreptr;
 
@@ -118,8 +116,8 @@ void SulfurComponent::prepareToRun() {
 //------------------------------------------------------------------------------
 // documentation is inherited
 void SulfurComponent::run(const double runToDate) {
-  H_ASSERT(!core->inSpinup() && runToDate - oldDate == 1,
-           "timestep must equal 1");
+  H_CHECK(!core->inSpinup() && runToDate - oldDate == 1,
+          "timestep must equal 1");
   oldDate = runToDate;
 }
 
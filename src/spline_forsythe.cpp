@@ -158,7 +158,9 @@ double seval_forsythe(int n, double u, double *x, double *y, double *b,
 
   H_ASSERT(n && x && y && b && c && d, "seval_forsythe needs nonzero params");
 
-  static int i = 0;
+  // Cached interval from the previous call; per-thread so that cores may run
+  // concurrently on different threads.
+  thread_local static int i = 0;
   int j, k;
   double dx;
 
@@ -215,7 +217,7 @@ double seval_deriv_forsythe(int n, double u, double *x, double *y, double *b,
 
   H_ASSERT(n && x && y && b && c && d, "seval_forsythe needs nonzero params");
 
-  static int i = 0;
+  thread_local static int i = 0; // see seval_forsythe
   int j, k;
   double dx;
 
@@ -32,18 +32,13 @@
 // 2023 and Boost 1.81.0_1: lexical_cast.hpp still generates many warnings
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Weverything"
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #pragma clang diagnostic pop
 
 #include <cmath>
 #include <limits>
 
-// The MinGW C++ compiler doesn't seem to pull in the cmath constants? (see
-// #384) As a workaround, we define M_PI here if needed
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 #include "avisitor.hpp"
 #include "core.hpp"
 #include "h_util.hpp"
@@ -72,33 +67,10 @@ string TemperatureComponent::getComponentName() const {
   return name;
 }
 
-//------------------------------------------------------------------------------
-/*! \brief              Calculates inverse of x and stores in y
- *  \param[in] x        Assume x is setup like x = [a,b,c,d] -> x = |a, b|
- *                                                |c, d|
- *  \param[out] y        Inverted 1-d matrix
- */
-void TemperatureComponent::invert_1d_2x2_matrix(double *x, double *y) {
-  double temp_d = (x[0] * x[3] - x[1] * x[2]);
-
-  if (temp_d == 0) {
-    H_THROW("Temperature: Matrix inversion divide by zero.");
-  }
-  double temp = 1 / temp_d;
-  y[0] = temp * x[3];
-  y[1] = temp * -1 * x[1];
-  y[2] = temp * -1 * x[2];
-  y[3] = temp * x[0];
-
-  return;
-}
-
 //------------------------------------------------------------------------------
 // documentation is inherited
 void TemperatureComponent::init(Core *coreptr) {
-  logger.open(getComponentName(), false,
-              coreptr->getGlobalLogger().getEchoToFile(),
-              coreptr->getGlobalLogger().getMinLogLevel());
+  logger.open(getComponentName(), coreptr->getGlobalLogger());
   H_LOG(logger, Logger::DEBUG) << "hello " << getComponentName() << std::endl;
 
   tas.set(0.0, U_DEGC, 0.0);
@@ -165,10 +137,10 @@ void TemperatureComponent::setData(const string &varName,
   try {
     if (varName == D_ECS) {
       H_ASSERT(data.date == Core::undefinedIndex(), "date not allowed");
-      S = data.getUnitval(U_DEGC);
+      S = quantity<U_DEGC>(data.getUnitval(U_DEGC));
     } else if (varName == D_DIFFUSIVITY) {
       H_ASSERT(data.date == Core::undefinedIndex(), "date not allowed");
-      diff = data.getUnitval(U_CM2_S);
+      diff = quantity<U_CM2_S>(data.getUnitval(U_CM2_S));
     } else if (varName == D_QCO2) {
       H_ASSERT(data.date == Core::undefinedIndex(), "date not allowed");
       qco2 = data.getUnitval(U_UNITLESS).value(U_UNITLESS);
@@ -215,17 +187,7 @@ void TemperatureComponent::prepareToRun() {
 
   // Initializing all model components that depend on the number of timesteps
   // (ns)
-  ns = core->getEndDate() - core->getStartDate() + 1;
-
-  KT0 = std::vector<double>(ns, 0.0);
-  KTA1 = std::vector<double>(ns, 0.0);
-  KTB1 = std::vector<double>(ns, 0.0);
-  KTA2 = std::vector<double>(ns, 0.0);
-  KTB2 = std::vector<double>(ns, 0.0);
-  KTA3 = std::vector<double>(ns, 0.0);
-  KTB3 = std::vector<double>(ns, 0.0);
-
-  Ker.resize(ns);
+  const int ns = core->getEndDate() - core->getStartDate() + 1;
 
   temp.resize(ns);
   temp_surface.resize(ns);
@@ -240,176 +202,10 @@ void TemperatureComponent::prepareToRun() {
   lo_temp_oceanair.resize(ns);
   lo_sst.resize(ns);
 
-  for (int i = 0; i < 3; i++) {
-    B[i] = 0.0;
-    C[i] = 0.0;
-  }
-
-  // DOECLIM model parameters, based on constants set in the header
-  //
-  // Constants & conversion factors
-  kcon = secs_per_Year / 10000; // conversion factor from cm2/s to m2/yr;
-  ocean_area = (1.0 - flnd) * earth_area; // m2
-
-  // Calculate climate feedback parameterisation
-  cnum = rlam * flnd +
-         bsi * (1.0 - flnd); // denominator used to calculate climate senstivity
-                             // feedback parameters over land & sea
-  cden = rlam * flnd -
-         ak * (rlam - bsi); // another denominator use to calculate climate
-                            // senstivity feedback parameters over land & sea
-  cfl = flnd * cnum / cden * qco2 / S -
-        bk * (rlam - bsi) / cden; // calculate the land climate feedback
-                                  // parameter (W/(m2K)) eq A.19 Kriegler 2005
-  cfs = (rlam * flnd - ak / (1.0 - flnd) * (rlam - bsi)) * cnum / cden * qco2 /
-            S +
-        rlam * flnd / (1.0 - flnd) * bk * (rlam - bsi) /
-            cden; // calculate the sea climate feedback parameter (W/(m2K)) eq
-                  // A.20 Kriegler 2005
-  kls = bk * rlam * flnd / cden - ak * flnd * cnum / cden * qco2 /
-                                      S; // land-sea heat exchange coefficient
-                                         // (W/(m2K)) eq A.21 Kriegler 2005
-
-  // Calculate ocean heat flux parameters & conversion factors
-  keff = kcon * diff; // covert units of ocean heat diffusivity (m2/yr)
-  powtoheat =
-      ocean_area * secs_per_Year /
-      pow(10.0,
-          22); // conversion factor to convert total ocean heat flux to (m2*s)
-
-  // Get the six different times scales used in the numerical aproximation of
-  // the heat flux into the interior ocean See eq A.22 Kriegler 2005 for more
-  // details.
-  taubot = pow(zbot, 2) /
-           keff; // number of years for the ocean to equilibrates, bottom water
-                 // has warmed as much as the surface (yr)
-  taucfs = cas / cfs; // sea climate feedback time scale (yr)
-  taucfl = cal / cfl; // land climate feedback time scale (yr)
-  taudif = pow(cas, 2) / pow(csw, 2) * M_PI /
-           keff; // interior ocean heat uptake time scale (yr)
-  tauksl = (1.0 - flnd) * cas / kls; // sea-land heat exchange time scale (yr)
-  taukls = flnd * cal / kls;         // land-sea heat exchange time scale (yr)
-
-  // Set up and solve the correction terms for the analytical solution for the
-  // DOECLIM integrands.
-
-  // Set Up
-  // Components of the analytical solution to the integral found in the
-  // temperature difference equation Third order bottom correction terms will be
-  // "more than sufficient" for simulations out to 2500 (Equation A.25, EK05,
-  // or 2.3.23, TK07)
-
-  // First order
-  KT0[ns - 1] = 4.0 - 2.0 * pow(2.0, 0.5);
-  KTA1[ns - 1] =
-      -8.0 * exp(-taubot / dt) + 4.0 * pow(2.0, 0.5) * exp(-0.5 * taubot / dt);
-  KTB1[ns - 1] = 4.0 * pow((M_PI * taubot / dt), 0.5) *
-                 (1.0 + erf(pow(0.5 * taubot / dt, 0.5)) -
-                  2.0 * erf(pow(taubot / dt, 0.5)));
-
-  // Second order
-  KTA2[ns - 1] = 8.0 * exp(-4.0 * taubot / dt) -
-                 4.0 * pow(2.0, 0.5) * exp(-2.0 * taubot / dt);
-  KTB2[ns - 1] = -8.0 * pow((M_PI * taubot / dt), 0.5) *
-                 (1.0 + erf(pow((2.0 * taubot / dt), 0.5)) -
-                  2.0 * erf(2.0 * pow((taubot / dt), 0.5)));
-
-  // Third order
-  KTA3[ns - 1] = -8.0 * exp(-9.0 * taubot / dt) +
-                 4.0 * pow(2.0, 0.5) * exp(-4.5 * taubot / dt);
-  KTB3[ns - 1] = 12.0 * pow((M_PI * taubot / dt), 0.5) *
-                 (1.0 + erf(pow((4.5 * taubot / dt), 0.5)) -
-                  2.0 * erf(3.0 * pow((taubot / dt), 0.5)));
-
-  // Calculate the kernel component vectors
-  for (int i = 0; i < (ns - 1); i++) {
-
-    // First order
-    KT0[i] = 4.0 * pow(double(ns - i), 0.5) -
-             2.0 * pow(double(ns + 1 - i), 0.5) -
-             2.0 * pow(double(ns - 1 - i), 0.5);
-    KTA1[i] =
-        -8.0 * pow(double(ns - i), 0.5) * exp(-taubot / dt / double(ns - i)) +
-        4.0 * pow(double(ns + 1 - i), 0.5) *
-            exp(-taubot / dt / double(ns + 1 - i)) +
-        4.0 * pow(double(ns - 1 - i), 0.5) *
-            exp(-taubot / dt / double(ns - 1 - i));
-    KTB1[i] = 4.0 * pow((M_PI * taubot / dt), 0.5) *
-              (erf(pow((taubot / dt / double(ns - 1 - i)), 0.5)) +
-               erf(pow((taubot / dt / double(ns + 1 - i)), 0.5)) -
-               2.0 * erf(pow((taubot / dt / double(ns - i)), 0.5)));
-
-    // Second order
-    KTA2[i] = 8.0 * pow(double(ns - i), 0.5) *
-                  exp(-4.0 * taubot / dt / double(ns - i)) -
-              4.0 * pow(double(ns + 1 - i), 0.5) *
-                  exp(-4.0 * taubot / dt / double(ns + 1 - i)) -
-              4.0 * pow(double(ns - 1 - i), 0.5) *
-                  exp(-4.0 * taubot / dt / double(ns - 1 - i));
-    KTB2[i] = -8.0 * pow((M_PI * taubot / dt), 0.5) *
-              (erf(2.0 * pow((taubot / dt / double(ns - 1 - i)), 0.5)) +
-               erf(2.0 * pow((taubot / dt / double(ns + 1 - i)), 0.5)) -
-               2.0 * erf(2.0 * pow((taubot / dt / double(ns - i)), 0.5)));
-
-    // Third order
-    KTA3[i] = -8.0 * pow(double(ns - i), 0.5) *
-                  exp(-9.0 * taubot / dt / double(ns - i)) +
-              4.0 * pow(double(ns + 1 - i), 0.5) *
-                  exp(-9.0 * taubot / dt / double(ns + 1 - i)) +
-              4.0 * pow(double(ns - 1 - i), 0.5) *
-                  exp(-9.0 * taubot / dt / double(ns - 1 - i));
-    KTB3[i] = 12.0 * pow((M_PI * taubot / dt), 0.5) *
-              (erf(3.0 * pow((taubot / dt / double(ns - 1 - i)), 0.5)) +
-               erf(3.0 * pow((taubot / dt / double(ns + 1 - i)), 0.5)) -
-               2.0 * erf(3.0 * pow((taubot / dt / double(ns - i)), 0.5)));
-  }
-
-  // Sum up the kernel components
-  for (int i = 0; i < ns; i++) {
-
-    Ker[i] = KT0[i] + KTA1[i] + KTB1[i] + KTA2[i] + KTB2[i] + KTA3[i] + KTB3[i];
-  }
-
-  // Correction terms, remove oscillation artefacts due to short-term forcings
-  // (Equation 2.3.27, TK07)
-  C[0] = 1.0 / pow(taucfl, 2.0) + 1.0 / pow(taukls, 2.0) +
-         2.0 / taucfl / taukls + bsi / taukls / tauksl;
-  C[1] = -1 * bsi / pow(taukls, 2.0) - bsi / taucfl / taukls -
-         bsi / taucfs / taukls - pow(bsi, 2.0) / taukls / tauksl;
-  C[2] = -1 * bsi / pow(tauksl, 2.0) - 1.0 / taucfs / tauksl -
-         1.0 / taucfl / tauksl - 1.0 / taukls / tauksl;
-  C[3] = 1.0 / pow(taucfs, 2.0) + pow(bsi, 2.0) / pow(tauksl, 2.0) +
-         2.0 * bsi / taucfs / tauksl + bsi / taukls / tauksl;
-
-  for (int i = 0; i < 4; i++) {
-    C[i] = C[i] * (pow(dt, 2.0) / 12.0);
-  }
-
-  //------------------------------------------------------------------
-  // Matrices of difference equation system, see A.27 Kriegler 2005.
-  // B*T(i+1) = Q(i) + A*T(i)
-  // T = (TL,TS)
-  // successor temperatures (TL;i+1; TS;i+1)
-  B[0] = 1.0 + dt / (2.0 * taucfl) + dt / (2.0 * taukls);
-  B[1] = -dt / (2.0 * taukls) * bsi;
-  B[2] = -dt / (2.0 * tauksl);
-  B[3] = 1.0 + dt / (2.0 * taucfs) + dt / (2.0 * tauksl) * bsi +
-         2.0 * fso * pow((dt / taudif), 0.5);
-
-  // predecessors temperatures
-  A[0] = 1.0 - dt / (2.0 * taucfl) - dt / (2.0 * taukls);
-  A[1] = dt / (2.0 * taukls) * bsi;
-  A[2] = dt / (2.0 * tauksl);
-  A[3] = 1.0 - dt / (2.0 * taucfs) - dt / (2.0 * tauksl) * bsi +
-         Ker[ns - 1] * fso * pow((dt / taudif), 0.5);
-
-  // The algorithm to integrate Model
-  for (int i = 0; i < 4; i++) {
-    B[i] = B[i] + C[i];
-    A[i] = A[i] + C[i];
-  }
-  // Calculate the inverse of B
-  invert_1d_2x2_matrix(B, IB);
+  // DOECLIM coefficients, from the parameters; the diffusion kernel depends
+  // only on ns, taubot, and dt, so it's shared with any other core that has
+  // the same ones.
+  doeclim.prepare(ns, S.value(), diff.value(), qco2);
 }
 
 //------------------------------------------------------------------------------
@@ -436,18 +232,6 @@ void TemperatureComponent::run(const double runToDate) {
   forcing[tstep] = core->sendMessage(M_GETDATA, D_RF_TOTAL, message_data(runToDate)).value(U_W_M2);
 
 
-  // Initialize variables for time-stepping through the model
-  double DQ1 = 0.0;
-  double DQ2 = 0.0;
-  double QC1 = 0.0;
-  double QC2 = 0.0;
-  double DelQL = 0.0;
-  double DelQO = 0.0;
-  double DPAST1 = 0.0;
-  double DPAST2 = 0.0;
-  double DTEAUX1 = 0.0;
-  double DTEAUX2 = 0.0;
-
   // Reset the endogenous varibales for this time step
   temp[tstep] = 0.0;
   temp_surface[tstep] = 0.0;
@@ -458,53 +242,19 @@ void TemperatureComponent::run(const double runToDate) {
   heatflux_mixed[tstep] = 0.0;
   heatflux_interior[tstep] = 0.0;
 
-  // Assume land and ocean forcings are equal to global forcing
-  std::vector<double> QL = forcing;
-  std::vector<double> QO = forcing;
-
   if (tstep > 0) {
-
-    DelQL = QL[tstep] - QL[tstep - 1];
-    DelQO = QO[tstep] - QO[tstep - 1];
-
-    // Assume linear forcing change between tstep and tstep+1
-    QC1 = (DelQL / cal * (1.0 / taucfl + 1.0 / taukls) -
-           bsi * DelQO / cas / taukls);
-    QC2 = (DelQO / cas * (1.0 / taucfs + bsi / tauksl) - DelQL / cal / tauksl);
-    QC1 = QC1 * pow(dt, 2.0) / 12.0;
-    QC2 = QC2 * pow(dt, 2.0) / 12.0;
-
-    // ----------------- Initial Conditions --------------------
-    // Initialization of temperature and forcing vector:
-    // Factor 1/2 in front of Q in Equation A.27, EK05, and Equation 2.3.27,
-    // TK07 is a typo! Assumption: linear forcing change between n and n+1
-    DQ1 = 0.5 * dt / cal * (QL[tstep] + QL[tstep - 1]);
-    DQ2 = 0.5 * dt / cas * (QO[tstep] + QO[tstep - 1]);
-    DQ1 = DQ1 + QC1;
-    DQ2 = DQ2 + QC2;
-
     // ---------- SOLVE MODEL ------------------
     // Calculate temperatures
-    for (int i = 0; i <= tstep; i++) {
-      DPAST2 = DPAST2 + temp_sst[i] * Ker[ns - tstep + i - 1];
-    }
-    DPAST2 = DPAST2 * fso * pow((dt / taudif), 0.5);
-
-    DTEAUX1 = A[0] * temp_landair[tstep - 1] + A[1] * temp_sst[tstep - 1];
-    DTEAUX2 = A[2] * temp_landair[tstep - 1] + A[3] * temp_sst[tstep - 1];
-
-    temp_landair[tstep] =
-        IB[0] * (DQ1 + DPAST1 + DTEAUX1) + IB[1] * (DQ2 + DPAST2 + DTEAUX2);
-    temp_sst[tstep] =
-        IB[2] * (DQ1 + DPAST1 + DTEAUX1) + IB[3] * (DQ2 + DPAST2 + DTEAUX2);
+    double DQ1, DQ2;
+    doeclim.inputs(forcing[tstep], forcing[tstep - 1], DQ1, DQ2);
+    doeclim.solve(tstep, DQ1, DQ2, temp_landair, temp_sst);
   } else { // Handle the initial conditions
     temp_landair[0] = 0.0;
     temp_sst[0] = 0.0;
   }
-  temp[tstep] =
-      flnd * temp_landair[tstep] + (1.0 - flnd) * bsi * temp_sst[tstep];
+  temp[tstep] = doeclim.airTemperature(temp_landair[tstep], temp_sst[tstep]);
   temp_surface[tstep] =
-      flnd * temp_landair[tstep] + (1.0 - flnd) * temp_sst[tstep];
+      doeclim.surfaceTemperature(temp_landair[tstep], temp_sst[tstep]);
 
   // If the user has supplied temperature data, use that instead
   if (tas_constrain.size() && runToDate >= tas_constrain.firstdate() &&
@@ -515,33 +265,20 @@ void TemperatureComponent::run(const double runToDate) {
 
     // Now back-calculate the land and ocean values, overwriting what was
     // computed above
+    const double flnd = doeclim.flnd, bsi = doeclim.bsi;
     temp_landair[tstep] =
         (temp[tstep] - (1.0 - flnd) * bsi * temp_sst[tstep]) / flnd;
     temp_sst[tstep] =
         (temp[tstep] - flnd * temp_landair[tstep]) / ((1.0 - flnd) * bsi);
     temp_surface[tstep] =
-        flnd * temp_landair[tstep] + (1.0 - flnd) * temp_sst[tstep];
+        doeclim.surfaceTemperature(temp_landair[tstep], temp_sst[tstep]);
 
   }
 
   // Calculate ocean heat uptake [W/m^2]
-  // heatflux[tstep] captures in the heat flux in the period between tstep-1 and
-  // tstep. Numerical implementation of Equation 2.7, EK05, or Equation 2.3.13,
-  // TK07)
-  // ------------------------------------------------------------------------
   if (tstep > 0) {
-    heatflux_mixed[tstep] = cas * (temp_sst[tstep] - temp_sst[tstep - 1]);
-    for (int i = 0; i < tstep; i++) {
-      heatflux_interior[tstep] =
-          heatflux_interior[tstep] + temp_sst[i] * Ker[ns - tstep + i];
-    }
-    heatflux_interior[tstep] =
-        cas * fso / pow((taudif * dt), 0.5) *
-        (2.0 * temp_sst[tstep] - heatflux_interior[tstep]);
-    heat_mixed[tstep] =
-        heat_mixed[tstep - 1] + heatflux_mixed[tstep] * (powtoheat * dt);
-    heat_interior[tstep] = heat_interior[tstep - 1] +
-                           heatflux_interior[tstep] * (fso * powtoheat * dt);
+    doeclim.heatFlux(tstep, temp_sst, heatflux_mixed, heatflux_interior,
+                     heat_mixed, heat_interior);
   }
 
   else { // Handle the initial conditions
@@ -556,6 +293,67 @@ void TemperatureComponent::run(const double runToDate) {
       << " tas=" << tas << " in " << runToDate << std::endl;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Find the stored yearly series behind a dated output.
+ *  \param varName The output.
+ *  \param scale   (output) Factor to multiply the series by.
+ *  \param units   (output) Units of the output.
+ *  \returns The series, indexed by years since the start date, or NULL if
+ *           varName isn't one of these outputs.
+ */
+const std::vector<double> *
+TemperatureComponent::datedSeries(const std::string &varName, double &scale,
+                                  unit_types &units) const {
+  const bool lo = lo_warming_ratio != 0;
+  scale = 1.0;
+  units = U_DEGC;
+  if (varName == D_GLOBAL_TAS) {
+    return &temp;
+  } else if (varName == D_GMST) {
+    return &temp_surface;
+  } else if (varName == D_LAND_TAS) {
+    return lo ? &lo_temp_landair : &temp_landair;
+  } else if (varName == D_OCEAN_TAS) {
+    if (lo) {
+      return &lo_temp_oceanair;
+    }
+    scale = doeclim.bsi;
+    return &temp_sst;
+  } else if (varName == D_SST) {
+    return lo ? &lo_sst : &temp_sst;
+  } else if (varName == D_FLUX_MIXED) {
+    units = U_W_M2;
+    return &heatflux_mixed;
+  } else if (varName == D_FLUX_INTERIOR) {
+    units = U_W_M2;
+    return &heatflux_interior;
+  }
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+// documentation is inherited
+void TemperatureComponent::getDataSeries(const std::string &varName,
+                                         const std::vector<double> &dates,
+                                         std::vector<unitval> &values) {
+  double scale;
+  unit_types units;
+  const std::vector<double> *series = datedSeries(varName, scale, units);
+  if (!series || std::find(dates.begin(), dates.end(),
+                           Core::undefinedIndex()) != dates.end()) {
+    IModelComponent::getDataSeries(varName, dates, values);
+    return;
+  }
+
+  values.resize(dates.size());
+  for (size_t i = 0; i < dates.size(); ++i) {
+    H_ASSERT(dates[i] <= core->getCurrentDate(),
+             "Date must be <= current date.");
+    const int tstep = dates[i] - core->getStartDate();
+    values[i] = unitval(scale * (*series)[tstep], units);
+  }
+}
+
 //------------------------------------------------------------------------------
 // documentation is inherited
 unitval TemperatureComponent::getData(const std::string &varName,
@@ -570,78 +368,34 @@ unitval TemperatureComponent::getData(const std::string &varName,
   H_ASSERT(date <= core->getCurrentDate(), "Date must be <= current date.");
   int tstep = date - core->getStartDate();
 
+  double scale;
+  unit_types units;
+  const std::vector<double> *series = datedSeries(varName, scale, units);
+  if (series && date != Core::undefinedIndex()) {
+    return unitval(scale * (*series)[tstep], units);
+  }
+
   if (varName == D_GLOBAL_TAS) {
-    if (date == Core::undefinedIndex()) {
-      returnval = tas;
-    } else {
-      returnval = unitval(temp[tstep], U_DEGC);
-    }
+    returnval = tas;
   } else if (varName == D_GMST) {
-      if (date == Core::undefinedIndex()) {
-          returnval = gmst_val;
-      } else {
-          returnval = unitval(temp_surface[tstep], U_DEGC);
-      }
+    returnval = gmst_val;
   } else if (varName == D_LAND_TAS) {
-    if (lo_warming_ratio != 0) {
-      if (date == Core::undefinedIndex()) {
-        returnval = lo_tas_land;
-      } else {
-        returnval = unitval(lo_temp_landair[tstep], U_DEGC);
-      }
-    } else {
-      if (date == Core::undefinedIndex()) {
-        returnval = tas_land;
-      } else {
-        returnval = unitval(temp_landair[tstep], U_DEGC);
-      }
-    }
+    returnval = lo_warming_ratio != 0 ? lo_tas_land : tas_land;
   } else if (varName == D_OCEAN_TAS) {
-    if (lo_warming_ratio != 0) {
-      if (date == Core::undefinedIndex()) {
-        returnval = lo_tas_ocean;
-      } else {
-        returnval = unitval(lo_temp_oceanair[tstep], U_DEGC);
-      }
-    } else {
-      if (date == Core::undefinedIndex()) {
-        returnval = tas_ocean;
-      } else {
-        returnval = bsi * unitval(temp_sst[tstep], U_DEGC);
-      }
-    }
+    returnval = lo_warming_ratio != 0 ? lo_tas_ocean : tas_ocean;
   } else if (varName == D_SST) {
-    if (lo_warming_ratio != 0) {
-      if (date == Core::undefinedIndex()) {
-        returnval = lo_seast;
-      } else {
-        returnval = unitval(lo_sst[tstep], U_DEGC);
-      }
-    } else {
-      if (date == Core::undefinedIndex()) {
-        returnval = sst;
-      } else {
-        returnval = unitval(temp_sst[tstep], U_DEGC);
-      }
-    }
+    returnval = lo_warming_ratio != 0 ? lo_seast : sst;
   } else if (varName == D_FLUX_MIXED) {
-    if (date == Core::undefinedIndex()) {
-      returnval = flux_mixed;
-    } else {
-      returnval = unitval(heatflux_mixed[tstep], U_W_M2);
-    }
+    returnval = flux_mixed;
   } else if (varName == D_FLUX_INTERIOR) {
-    if (date == Core::undefinedIndex()) {
-      returnval = flux_interior;
-    } else {
-      returnval = unitval(heatflux_interior[tstep], U_W_M2);
-    }
+    returnval = flux_interior;
   } else if (varName == D_HEAT_FLUX) {
     if (date == Core::undefinedIndex()) {
       returnval = heatflux;
     } else {
-      double value = heatflux_mixed[tstep] + fso * heatflux_interior[tstep];
-      returnval = unitval(value, U_W_M2);
+      double value =
+          heatflux_mixed[tstep] + doeclim.fso * heatflux_interior[tstep];
+      returnval.set(value, U_W_M2);
     }
   } else if (varName == D_TAS_CONSTRAIN) {
     H_ASSERT(date != Core::undefinedIndex(),
@@ -708,13 +462,13 @@ void TemperatureComponent::setoutputs(int tstep) {
 
   flux_mixed.set(heatflux_mixed[tstep], U_W_M2, 0.0);
   flux_interior.set(heatflux_interior[tstep], U_W_M2, 0.0);
-  heatflux.set(heatflux_mixed[tstep] + fso * heatflux_interior[tstep], U_W_M2,
-               0.0);
+  heatflux.set(heatflux_mixed[tstep] + doeclim.fso * heatflux_interior[tstep],
+               U_W_M2, 0.0);
   tas.set(temp[tstep], U_DEGC, 0.0);
   gmst_val.set(temp_surface[tstep], U_DEGC, 0.0);
   tas_land.set(temp_landair[tstep], U_DEGC, 0.0);
   sst.set(temp_sst[tstep], U_DEGC, 0.0);
-  temp_oceanair = bsi * temp_sst[tstep];
+  temp_oceanair = doeclim.bsi * temp_sst[tstep];
   tas_ocean.set(temp_oceanair, U_DEGC, 0.0);
 
   // If a user provided land-ocean warming ratio is provided, use it to over
@@ -724,9 +478,9 @@ void TemperatureComponent::setoutputs(int tstep) {
     // Calculations using tas weighted average and ratio (land warming/ocean
     // warming = lo_warming_ratio)
     double temp_oceanair_constrain =
-        temp[tstep] / ((lo_warming_ratio * flnd) + (1 - flnd));
+        temp[tstep] / ((lo_warming_ratio * doeclim.flnd) + (1 - doeclim.flnd));
     double temp_landair_constrain = temp_oceanair_constrain * lo_warming_ratio;
-    double temp_sst_constrain = temp_oceanair_constrain / bsi;
+    double temp_sst_constrain = temp_oceanair_constrain / doeclim.bsi;
 
     lo_temp_landair[tstep] = temp_landair_constrain;
     lo_temp_oceanair[tstep] = temp_oceanair_constrain;
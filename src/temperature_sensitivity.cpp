@@ -0,0 +1,107 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  temperature_sensitivity.cpp
+ *  hector
+ *
+ *  Temperature trajectories with their derivatives by climate parameter.
+ *
+ */
+
+#include <utility>
+
+#include "doeclim.hpp"
+#include "dual.hpp"
+#include "h_exception.hpp"
+#include "temperature_component.hpp"
+#include "temperature_sensitivity.hpp"
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief Take the parameters of a temperature component.
+ *  \param temperature A component that has been prepared to run.
+ *  \exception h_exception If the component hasn't been prepared, or has a
+ *             temperature constraint.
+ */
+TemperatureSensitivity::TemperatureSensitivity(
+    const TemperatureComponent &temperature)
+    : ns(temperature.doeclim.ns), qco2(temperature.qco2) {
+  H_ASSERT(temperature.doeclim.Ker && temperature.doeclim.Ker->size() == ns,
+           "temperature component has not been prepared to run");
+  H_ASSERT(!temperature.tas_constrain.size(),
+           "temperature is constrained, so has no derivatives");
+  S = temperature.S.value();
+  diff = temperature.diff.value();
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Compute trajectories, and their derivatives, for a forcing pathway.
+ *  \param forcing Total forcing (W/m2) by year, from the start date; as for
+ *                 LinearTemperatureResponse::compute(), forcing[0] should be
+ *                 zero to reproduce a model run.
+ *  \param values  The trajectories, as long as forcing.
+ *  \param derivs  Their derivatives with respect to each Parameter, per unit
+ *                 of the parameter (degC, cm2/s, W/m2).
+ *  \exception h_exception If forcing has more years than the model run.
+ *  \details The equations are those TemperatureComponent runs, with the
+ *           parameters as dual numbers.
+ */
+void TemperatureSensitivity::compute(const std::vector<double> &forcing,
+                                     Trajectories &values,
+                                     Trajectories derivs[N_PARAMETERS]) const {
+  typedef Dual<N_PARAMETERS> dual;
+
+  const size_t n = forcing.size();
+  H_ASSERT(n <= ns, "forcing has more years than the model run");
+
+  DOECLIM<dual> doeclim;
+  doeclim.prepare(static_cast<int>(ns), dual(S, ECS), dual(diff, DIFFUSIVITY),
+                  dual(qco2, QCO2));
+
+  std::vector<dual> temp(n), temp_surface(n), temp_landair(n), temp_sst(n),
+      heatflux_mixed(n), heatflux_interior(n), heat_mixed(n),
+      heat_interior(n);
+  for (size_t tstep = 1; tstep < n; ++tstep) {
+    dual DQ1, DQ2;
+    doeclim.inputs(forcing[tstep], forcing[tstep - 1], DQ1, DQ2);
+    doeclim.solve(tstep, DQ1, DQ2, temp_landair, temp_sst);
+    temp[tstep] = doeclim.airTemperature(temp_landair[tstep], temp_sst[tstep]);
+    temp_surface[tstep] =
+        doeclim.surfaceTemperature(temp_landair[tstep], temp_sst[tstep]);
+    doeclim.heatFlux(tstep, temp_sst, heatflux_mixed, heatflux_interior,
+                     heat_mixed, heat_interior);
+  }
+
+  // Split the dual numbers into values and derivatives
+  const std::pair<const std::vector<dual> *, std::vector<double> Trajectories::*>
+      outputs[] = {{&temp, &Trajectories::temp},
+                   {&temp_surface, &Trajectories::temp_surface},
+                   {&temp_landair, &Trajectories::temp_landair},
+                   {&temp_sst, &Trajectories::temp_sst},
+                   {&heatflux_mixed, &Trajectories::heatflux_mixed},
+                   {&heatflux_interior, &Trajectories::heatflux_interior},
+                   {&heat_mixed, &Trajectories::heat_mixed},
+                   {&heat_interior, &Trajectories::heat_interior}};
+  for (auto &output : outputs) {
+    const std::vector<dual> &x = *output.first;
+    std::vector<double> &v = values.*output.second;
+    v.resize(n);
+    for (size_t t = 0; t < n; ++t) {
+      v[t] = x[t].value();
+    }
+    for (int p = 0; p < N_PARAMETERS; ++p) {
+      std::vector<double> &d = derivs[p].*output.second;
+      d.resize(n);
+      for (size_t t = 0; t < n; ++t) {
+        d[t] = x[t].derivative(p);
+      }
+    }
+  }
+}
+
+} // namespace Hector
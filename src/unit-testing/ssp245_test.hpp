@@ -0,0 +1,87 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef SSP245_TEST_HPP
+#define SSP245_TEST_HPP
+/*
+ *  ssp245_test.hpp
+ *  hector
+ *
+ *  Base fixture for unit tests that run the model.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "component_data.hpp"
+#include "component_names.hpp"
+#include "core.hpp"
+#include "message_data.hpp"
+#include "scenario.hpp"
+
+/*! \brief Base fixture for unit tests that run the model from the default
+ *         SSP245 input file.
+ *
+ *  The input file is read once, into a Scenario that every test applies to
+ *  its cores.  Its path is relative, so these tests must be run from the top
+ *  level of the repository.  Running the model is what makes tests slow, so
+ *  a test should end its runs (see endDate()) as early as what it checks
+ *  allows.
+ */
+class SSP245Test : public testing::Test {
+protected:
+    static const char *iniFile() { return "inst/input/hector_ssp245.ini"; }
+
+    //! The input file, read the first time it's needed
+    static const Hector::Scenario &scenario() {
+        static const Hector::Scenario ssp245( iniFile() );
+        return ssp245;
+    }
+
+    //! A setting for the core
+    static Hector::ScenarioSetting coreSetting( const std::string &varName, const double value ) {
+        return Hector::ScenarioSetting( CORE_COMPONENT_NAME, varName,
+                                        Hector::message_data( Hector::unitval( value, Hector::U_UNDEFINED ) ) );
+    }
+
+    //! A setting to end the run at date instead of the input file's end date
+    static Hector::ScenarioSetting endDate( const double date ) {
+        return coreSetting( D_END_DATE, date );
+    }
+
+    //! A core set up from the input file and then the overrides, ready to be
+    //! prepared to run
+    static std::unique_ptr<Hector::Core> makeCore( const std::vector<Hector::ScenarioSetting> &overrides = {} ) {
+        std::unique_ptr<Hector::Core> core( new Hector::Core( Hector::Logger::SEVERE, false, false ) );
+        core->init();
+        core->applyScenario( scenario(), overrides );
+        return core;
+    }
+
+    //! Variables for every year from first through last, as
+    //! Core::getDataBlock() gives them
+    static std::vector<double> fetch( Hector::Core &core, const std::vector<std::string> &vars,
+                                      const double first, const double last ) {
+        std::vector<double> dates;
+        for( double d = first; d <= last; ++d ) {
+            dates.push_back( d );
+        }
+        std::vector<double> values;
+        std::vector<std::string> units;
+        core.getDataBlock( vars, dates, values, units );
+        return values;
+    }
+
+    //! Variables for every year of the run after the start date
+    static std::vector<double> fetch( Hector::Core &core, const std::vector<std::string> &vars ) {
+        return fetch( core, vars, core.getStartDate() + 1, core.getEndDate() );
+    }
+};
+
+#endif // SSP245_TEST_HPP
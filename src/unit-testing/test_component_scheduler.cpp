@@ -0,0 +1,171 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_component_scheduler.cpp
+ *  hector
+ *
+ *  Unit tests for running a core's components concurrently.
+ *
+ */
+
+#include <map>
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "component_data.hpp"
+#include "core.hpp"
+#include "h_exception.hpp"
+#include "imodel_component.hpp"
+#include "message_data.hpp"
+#include "ssp245_test.hpp"
+
+using namespace Hector;
+
+/*! \brief Unit tests for the ComponentScheduler class.
+ */
+class TestComponentScheduler : public SSP245Test {
+protected:
+    // Create a core configured to run its components on nthreads threads
+    // through 2100
+    std::unique_ptr<Core> makeScheduledCore( int nthreads, IModelComponent* extra1 = NULL,
+                                             IModelComponent* extra2 = NULL ) {
+        std::unique_ptr<Core> core( new Core( Logger::SEVERE, false, false ) );
+        if( extra1 ) {
+            core->addModelComponent( extra1 );
+        }
+        if( extra2 ) {
+            core->addModelComponent( extra2 );
+        }
+        core->init();
+        core->applyScenario( scenario(), { coreSetting( D_COMPONENT_THREADS, nthreads ),
+                                           endDate( 2100 ) } );
+        core->prepareToRun();
+        return core;
+    }
+
+    // A component that doesn't exchange any messages, recording the years it
+    // has run
+    class ClockComponent: public IModelComponent {
+    public:
+        virtual std::string getComponentName() const { return "clock"; }
+        virtual void init( Core* core ) { core->registerCapability( "clock", getComponentName() ); }
+        virtual unitval sendMessage( const std::string& message, const std::string& datum,
+                                     const message_data info = message_data() ) {
+            return unitval( lastDate, U_UNDEFINED );
+        }
+        virtual void setData( const std::string& varName, const message_data& data ) {}
+        virtual void prepareToRun() { lastDate = 0; }
+        virtual void run( const double runToDate ) { lastDate = runToDate; }
+        virtual void reset( double time ) { lastDate = time; }
+        virtual void shutDown() {}
+        virtual void accept( AVisitor* visitor ) {}
+    private:
+        virtual unitval getData( const std::string& varName, const double date ) {
+            return unitval( lastDate, U_UNDEFINED );
+        }
+        double lastDate;
+    };
+
+    // A component that starts reading the clock partway through the run,
+    // once the scheduler has already placed both of them in the same level
+    class LateReaderComponent: public IModelComponent {
+    public:
+        virtual std::string getComponentName() const { return "late-reader"; }
+        virtual void init( Core* core ) { this->core = core; }
+        virtual unitval sendMessage( const std::string& message, const std::string& datum,
+                                     const message_data info = message_data() ) {
+            return unitval();
+        }
+        virtual void setData( const std::string& varName, const message_data& data ) {}
+        virtual void prepareToRun() {}
+        virtual void run( const double runToDate ) {
+            if( runToDate >= 1950 ) {
+                seen[runToDate] = core->sendMessage( M_GETDATA, "clock" ).value( U_UNDEFINED );
+            }
+        }
+        virtual void reset( double time ) {
+            seen.erase( seen.upper_bound( time ), seen.end() );
+        }
+        virtual void shutDown() {}
+        virtual void accept( AVisitor* visitor ) {}
+
+        std::map<double, double> seen;
+    private:
+        virtual unitval getData( const std::string& varName, const double date ) {
+            return unitval();
+        }
+        Core* core;
+    };
+};
+
+TEST_F(TestComponentScheduler, MatchesSequentialRun) {
+    std::unique_ptr<Core> sequential = makeScheduledCore( 1 );
+    std::unique_ptr<Core> parallel = makeScheduledCore( 4 );
+    sequential->run();
+    parallel->run();
+
+    const std::vector<std::string> vars = { D_GLOBAL_TAS, D_CO2_CONC, D_CH4_CONC,
+        D_RF_TOTAL, D_RF_CFC11, D_RF_SO2, D_OCEAN_C, D_ATMOSPHERIC_O3 };
+    const std::vector<double> expected = fetch( *sequential, vars );
+    std::vector<double> actual = fetch( *parallel, vars );
+
+    // Results must be identical, not just close
+    ASSERT_EQ( expected.size(), actual.size() );
+    const size_t ndates = expected.size() / vars.size();
+    for( size_t i = 0; i < expected.size(); ++i ) {
+        EXPECT_EQ( expected[i], actual[i] ) << vars[i / ndates] << " "
+                                            << sequential->getStartDate() + 1 + i % ndates;
+    }
+
+    // Resetting and rerunning uses the same schedule
+    parallel->reset( 2000 );
+    parallel->run();
+    actual = fetch( *parallel, vars );
+    EXPECT_EQ( expected, actual );
+}
+
+TEST_F(TestComponentScheduler, DefaultRunDoesNotFallBack) {
+    // Messages that the standard components only start sending after the
+    // first year (e.g. forcing asking simpleNbox for albedo forcing once it
+    // reaches its base year) must already be allowed for
+    Core core( Logger::NOTICE, false, false, 100000 );
+    core.init();
+    core.applyScenario( scenario(), { coreSetting( D_COMPONENT_THREADS, 4 ),
+                                      endDate( 2100 ) } );
+    core.prepareToRun();
+    core.run();
+
+    bool built = false;
+    for( const std::string& record : core.getGlobalLogger().getRecentRecords() ) {
+        EXPECT_EQ( record.find( "rerunning" ), std::string::npos ) << record;
+        built = built || record.find( "levels on 4 threads" ) != std::string::npos;
+    }
+    EXPECT_TRUE( built );
+}
+
+TEST_F(TestComponentScheduler, NewMessagesFallBackToSequential) {
+    // The serial model accepts a message that first appears after the
+    // levels are built, so the parallel one must too, with the same results
+    LateReaderComponent* sequentialReader = new LateReaderComponent;
+    LateReaderComponent* parallelReader = new LateReaderComponent;
+    std::unique_ptr<Core> sequential = makeScheduledCore( 1, new ClockComponent, sequentialReader );
+    std::unique_ptr<Core> parallel = makeScheduledCore( 4, new ClockComponent, parallelReader );
+    sequential->run( 2000 );
+    ASSERT_NO_THROW( parallel->run( 2000 ) );
+
+    EXPECT_EQ( sequentialReader->seen.size(), 51 );
+    EXPECT_EQ( sequentialReader->seen, parallelReader->seen );
+    EXPECT_EQ( sequential->sendMessage( M_GETDATA, D_GLOBAL_TAS ).value( U_DEGC ),
+               parallel->sendMessage( M_GETDATA, D_GLOBAL_TAS ).value( U_DEGC ) );
+}
+
+TEST_F(TestComponentScheduler, NeedsAtLeastOneThread) {
+    Core core( Logger::SEVERE, false, false );
+    EXPECT_THROW( core.setData( CORE_COMPONENT_NAME, D_COMPONENT_THREADS,
+                                message_data( unitval( 0, U_UNDEFINED ) ) ),
+                  h_exception );
+}
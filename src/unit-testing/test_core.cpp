@@ -19,6 +19,7 @@
 #include "core.hpp"
 #include "dummy_model_component.hpp"
 #include "avisitor.hpp"
+#include "ini_to_core_reader.hpp"
 
 using namespace Hector;
 
@@ -77,6 +78,27 @@ protected:
         
         bool didVisit;
     };
+
+    // A component with one variable, whose units change in 2000
+    class UnitsByDateComponent: public IModelComponent {
+    public:
+        virtual std::string getComponentName() const { return "units-by-date"; }
+        virtual void init( Core* core ) { core->registerCapability( "units-by-date", getComponentName() ); }
+        virtual unitval sendMessage( const std::string& message, const std::string& datum,
+                                     const message_data info = message_data() ) {
+            return getData( datum, info.date );
+        }
+        virtual void setData( const std::string& varName, const message_data& data ) {}
+        virtual void prepareToRun() {}
+        virtual void run( const double runToDate ) {}
+        virtual void reset( double time ) {}
+        virtual void shutDown() {}
+        virtual void accept( AVisitor* visitor ) {}
+    private:
+        virtual unitval getData( const std::string& varName, const double date ) {
+            return date < 2000 ? unitval( date, U_PGC ) : unitval( date, U_PGC_YR );
+        }
+    };
 };
 
 TEST_F(TestCore, InitCreatesComponents) {
@@ -157,3 +179,50 @@ TEST_F(TestCore, CanNotAddCompAfterInit) {
     core.init();
     ASSERT_THROW( core.addModelComponent( new DummyModelComponent ), h_exception );
 }
+
+TEST_F(TestCore, DataBlockHasUnitsForEachValue) {
+    Core core(Logger::SEVERE, false, false);
+    core.addModelComponent( new UnitsByDateComponent );
+    core.init();
+    std::vector<double> values;
+    std::vector<std::string> units;
+    core.getDataBlock( { "units-by-date" }, { 1999, 2000 }, values, units );
+    ASSERT_EQ( units.size(), 2 );
+    EXPECT_EQ( values[0], 1999 );
+    EXPECT_EQ( units[0], unitval::unitsName( U_PGC ) );
+    EXPECT_EQ( values[1], 2000 );
+    EXPECT_EQ( units[1], unitval::unitsName( U_PGC_YR ) );
+}
+
+TEST_F(TestCore, DataBlockMatchesMessages) {
+    Core core(Logger::SEVERE, false, false);
+    core.init();
+    INIToCoreReader reader( &core );
+    reader.parse( "inst/input/hector_ssp245.ini" );
+    core.prepareToRun();
+    core.run( 1900 );
+
+    // Dated series from components that look them up once, and others
+    const std::vector<std::string> vars = { D_GLOBAL_TAS, D_OCEAN_TAS, D_FLUX_MIXED, D_RF_TOTAL,
+                                            D_RF_CO2, D_CO2_CONC, D_NPP };
+    const std::vector<double> dates = { 1745, 1800, 1850, 1900 };
+    std::vector<double> values;
+    std::vector<std::string> units;
+    core.getDataBlock( vars, dates, values, units );
+    ASSERT_EQ( values.size(), vars.size() * dates.size() );
+    for( size_t j = 0; j < vars.size(); ++j ) {
+        for( size_t i = 0; i < dates.size(); ++i ) {
+            const unitval expected = core.sendMessage( M_GETDATA, vars[j], message_data( dates[i] ) );
+            EXPECT_EQ( values[j * dates.size() + i], expected.value( expected.units() ) ) << vars[j];
+            EXPECT_EQ( units[j * dates.size() + i], expected.unitsName() ) << vars[j];
+        }
+    }
+
+    // Undated values, from the same components
+    core.getDataBlock( { D_ECS, D_DELTA_CO2 }, { Core::undefinedIndex() }, values, units );
+    EXPECT_EQ( values[0], core.sendMessage( M_GETDATA, D_ECS ).value( U_DEGC ) );
+    EXPECT_EQ( values[1], core.sendMessage( M_GETDATA, D_DELTA_CO2 ).value( U_UNITLESS ) );
+
+    EXPECT_THROW( core.getDataBlock( { D_RF_TOTAL }, { Core::undefinedIndex() }, values, units ),
+                  h_exception );
+}
@@ -277,3 +277,22 @@ TEST_F(TestCSVTableReader, CanIgnoreExtralineCR) {
     core.accept( &check );
     ASSERT_EQ( check.valueResult, 6 );
 }
+
+TEST_F(TestCSVTableReader, ReadsTableOnce) {
+    Core core(Logger::SEVERE, false, false);
+    core.addModelComponent( new DummyModelComponent );
+    testFile << "Date," << testVarName << ",Other" << std::endl;
+    testFile << "2,6,1" << std::endl;
+    testFile.close();
+    ASSERT_NO_THROW(reader.process(&core, testComponentName, testVarName));
+
+    // Later processing uses the table as first read, not the file
+    testFile.open( TestCSVTableReaderEnv::testFileName.c_str(), std::ios::out | std::ios::trunc );
+    testFile << "Date," << testVarName << ",Other" << std::endl;
+    testFile << "2,7,1" << std::endl;
+    testFile.close();
+    ASSERT_NO_THROW(reader.process(&core, testComponentName, testVarName));
+    CheckDummyVisitor check( 2 );
+    core.accept( &check );
+    ASSERT_EQ( check.valueResult, 6 );
+}
@@ -0,0 +1,134 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_csv_tracking_visitor.cpp
+ *  hector
+ *
+ *  Unit tests for the carbon tracking output.
+ *
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include "component_data.hpp"
+#include "core.hpp"
+#include "csv_tracking_visitor.hpp"
+#include "h_exception.hpp"
+#include "message_data.hpp"
+#include "ssp245_test.hpp"
+
+using namespace Hector;
+
+/*! \brief Unit tests for the CSVFluxPoolVisitor class.
+ */
+class TestCSVTrackingVisitor : public SSP245Test {
+protected:
+    // Create a core that tracks carbon from 1850 to 2000
+    std::unique_ptr<Core> makeTrackingCore() {
+        return makeCore( { coreSetting( D_TRACKING_DATE, 1850 ), endDate( 2000 ) } );
+    }
+
+    // Tracking output of a run, streamed to a string
+    std::string streamed() {
+        std::unique_ptr<Core> core = makeTrackingCore();
+        std::ostringstream out;
+        {
+            CSVFluxPoolVisitor visitor( out );
+            core->addVisitor( &visitor );
+            core->prepareToRun();
+            core->run();
+        }
+        return out.str();
+    }
+
+    // Tracking output of a run written to a file; if resetDate is given, run
+    // again from there to rerunDate (or the end)
+    std::string written( const double resetDate = -1, const double rerunDate = -1 ) {
+        const std::string fileName = "tracking_test_file.csv";
+        std::unique_ptr<Core> core = makeTrackingCore();
+        {
+            CSVFluxPoolVisitor visitor( fileName );
+            core->addVisitor( &visitor );
+            core->prepareToRun();
+            core->run();
+            if( resetDate >= 0 ) {
+                core->reset( resetDate );
+                core->run( rerunDate );
+            }
+        }
+        std::ifstream in( fileName.c_str(), std::ios::binary );
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        in.close();
+        std::remove( fileName.c_str() );
+        return contents.str();
+    }
+
+    // Tracking output of a run, kept in memory; if resetDate is given, run
+    // again from there to rerunDate (or the end)
+    std::string inMemory( const double resetDate = -1, const double rerunDate = -1 ) {
+        std::unique_ptr<Core> core = makeTrackingCore();
+        CSVFluxPoolVisitor visitor;
+        core->addVisitor( &visitor );
+        core->prepareToRun();
+        core->run();
+        if( resetDate >= 0 ) {
+            core->reset( resetDate );
+            core->run( rerunDate );
+        }
+        return core->getTrackingData();
+    }
+};
+
+// The outputs are long, so compare them without printing them
+TEST_F(TestCSVTrackingVisitor, StreamMatchesMemory) {
+    const std::string memory = inMemory();
+    EXPECT_EQ( memory.compare( 0, 4, "year" ), 0 );
+    // Big enough to have been written in several blocks
+    EXPECT_GT( memory.size(), 200000u );
+    EXPECT_TRUE( streamed() == memory );
+}
+
+TEST_F(TestCSVTrackingVisitor, FileMatchesMemory) {
+    EXPECT_TRUE( written() == inMemory() );
+}
+
+TEST_F(TestCSVTrackingVisitor, ResetRewinds) {
+    // Back into output that has already been written to the file
+    const std::string memory = inMemory( 1900 );
+    EXPECT_GT( memory.size(), 200000u );
+    EXPECT_TRUE( written( 1900 ) == memory );
+    // Back to before tracking started
+    EXPECT_TRUE( written( 1800 ) == inMemory( 1800 ) );
+}
+
+TEST_F(TestCSVTrackingVisitor, ResetTruncatesFile) {
+    // Rewinding and then stopping earlier leaves the file holding exactly the
+    // output through the new end, with nothing left over from the first run
+    const std::string memory = inMemory( 1900, 1950 );
+    const std::string file = written( 1900, 1950 );
+    EXPECT_TRUE( file == memory );
+    EXPECT_EQ( file.size(), memory.size() );
+    ASSERT_FALSE( file.empty() );
+    EXPECT_EQ( file.compare( file.size() - 1, 1, "\n" ), 0 );
+    EXPECT_EQ( file.find( "\n\n" ), std::string::npos );
+    EXPECT_EQ( file.compare( file.rfind( '\n', file.size() - 2 ) + 1, 5, "1950," ), 0 );
+}
+
+TEST_F(TestCSVTrackingVisitor, StreamCantRewind) {
+    std::unique_ptr<Core> core = makeTrackingCore();
+    std::ostringstream out;
+    CSVFluxPoolVisitor visitor( out );
+    core->addVisitor( &visitor );
+    core->prepareToRun();
+    core->run();
+    EXPECT_THROW( core->reset( 1900 ), h_exception );
+}
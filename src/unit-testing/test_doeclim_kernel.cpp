@@ -0,0 +1,48 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_doeclim_kernel.cpp
+ *  hector
+ *
+ *  Unit tests for the shared DOECLIM diffusion kernel.
+ *
+ */
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "doeclim_kernel.hpp"
+#include "h_exception.hpp"
+
+using namespace Hector;
+
+TEST(TestDOECLIMKernel, SharedBetweenUsers) {
+    auto a = DOECLIMKernel::get( 356, 2000.0, 1.0 );
+    auto b = DOECLIMKernel::get( 356, 2000.0, 1.0 );
+    auto c = DOECLIMKernel::get( 356, 2500.0, 1.0 );
+    auto d = DOECLIMKernel::get( 451, 2000.0, 1.0 );
+    EXPECT_EQ( a.get(), b.get() );
+    EXPECT_NE( a.get(), c.get() );
+    EXPECT_EQ( a->size(), 356u );
+    EXPECT_EQ( d->size(), 451u );
+
+    EXPECT_THROW( DOECLIMKernel::get( 0, 2000.0, 1.0 ), h_exception );
+}
+
+TEST(TestDOECLIMKernel, RecomputedAfterRelease) {
+    std::vector<double> first;
+    {
+        auto kernel = DOECLIMKernel::get( 100, 1234.5, 1.0 );
+        first = *kernel;
+    }
+    auto kernel = DOECLIMKernel::get( 100, 1234.5, 1.0 );
+    EXPECT_EQ( *kernel, first );
+    for( double k : first ) {
+        EXPECT_TRUE( std::isfinite( k ) );
+    }
+}
@@ -0,0 +1,48 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_dual.cpp
+ *  hector
+ *
+ *  Unit tests for dual numbers.
+ *
+ */
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "doeclim_kernel.hpp"
+#include "dual.hpp"
+
+using namespace Hector;
+
+TEST(TestDual, Derivatives) {
+    const Dual<2> x( 0.7, 0 ), y( 1.9, 1 );
+    const Dual<2> f = exp( x * y ) / ( 1.0 + pow( y, 0.5 ) ) - erf( x ) * 3.0;
+    const double h = 1e-6;
+    auto g = []( double a, double b ) {
+        return std::exp( a * b ) / ( 1.0 + std::pow( b, 0.5 ) ) - std::erf( a ) * 3.0;
+    };
+    EXPECT_DOUBLE_EQ( f.value(), g( 0.7, 1.9 ) );
+    EXPECT_NEAR( f.derivative( 0 ), ( g( 0.7 + h, 1.9 ) - g( 0.7 - h, 1.9 ) ) / ( 2 * h ), 1e-8 );
+    EXPECT_NEAR( f.derivative( 1 ), ( g( 0.7, 1.9 + h ) - g( 0.7, 1.9 - h ) ) / ( 2 * h ), 1e-8 );
+}
+
+TEST(TestDual, KernelMatchesDouble) {
+    // The kernel in dual numbers has the same values as the shared one
+    const double taubot = 2345.6, h = 1e-3;
+    const std::vector<Dual<1>> kernel = DOECLIMKernel::compute( 200, Dual<1>( taubot, 0 ), 1.0 );
+    const std::vector<double> plain = *DOECLIMKernel::get( 200, taubot, 1.0 );
+    const std::vector<double> up = DOECLIMKernel::compute( 200, taubot + h, 1.0 );
+    const std::vector<double> down = DOECLIMKernel::compute( 200, taubot - h, 1.0 );
+    ASSERT_EQ( kernel.size(), plain.size() );
+    for( size_t i = 0; i < plain.size(); ++i ) {
+        EXPECT_EQ( kernel[i].value(), plain[i] );
+        EXPECT_NEAR( kernel[i].derivative( 0 ), ( up[i] - down[i] ) / ( 2 * h ), 1e-9 );
+    }
+}
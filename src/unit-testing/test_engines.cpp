@@ -0,0 +1,146 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_engines.cpp
+ *  hector
+ *
+ *  Unit tests for the engines that run groups of components together.
+ *
+ */
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <gtest/gtest.h>
+
+#include "atmospheric_chemistry_engine.hpp"
+#include "component_data.hpp"
+#include "component_names.hpp"
+#include "core.hpp"
+#include "h_exception.hpp"
+#include "halocarbon_engine.hpp"
+#include "message_data.hpp"
+#include "short_lived_forcer_engine.hpp"
+#include "ssp245_test.hpp"
+
+using namespace Hector;
+
+namespace {
+
+// What the tests of each engine need to know about it
+struct EngineCase {
+    const char *name;
+    const char *setting;                         // core setting that enables it
+    std::function<bool( Core & )> attached;      // the core has the engine
+    std::function<bool( Core & )> complete;      // it runs all it should
+    std::function<void( Core & )> change;        // change a parameter and an input
+    std::vector<std::string> vars;               // outputs it affects
+};
+
+void PrintTo( const EngineCase &engine, std::ostream *os ) {
+    *os << engine.name;
+}
+
+const EngineCase ENGINES[] = {
+    { "Halocarbon", D_HALOCARBON_ENGINE,
+      []( Core &core ) { return core.getHalocarbonEngine() != nullptr; },
+      []( Core &core ) { return core.getHalocarbonEngine()->size() == 26u; },
+      []( Core &core ) {
+          core.setData( CFC11_COMPONENT_BASE HALOCARBON_EXTENSION,
+                        D_HCRHO_PREFIX CFC11_COMPONENT_BASE,
+                        message_data( unitval( 0.003, U_W_M2_PPTV ) ) );
+          core.setData( SF6_COMPONENT_BASE HALOCARBON_EXTENSION,
+                        SF6_COMPONENT_BASE EMISSIONS_EXTENSION,
+                        message_data( 2050, unitval( 100, U_GG ) ) );
+      },
+      { D_RF_CFC11, D_RF_HFC134a, D_RF_SF6, D_RF_CH3Cl,
+        CFC12_COMPONENT_BASE CONCENTRATION_EXTENSION, D_RF_TOTAL, D_GLOBAL_TAS } },
+
+    { "ShortLivedForcer", D_SHORT_LIVED_ENGINE,
+      []( Core &core ) { return core.getShortLivedForcerEngine() != nullptr; },
+      []( Core &core ) { return core.getShortLivedForcerEngine()->hasAerosols(); },
+      []( Core &core ) {
+          core.setData( FORCING_COMPONENT_NAME, D_AERO_SCALE,
+                        message_data( unitval( 0.8, U_UNITLESS ) ) );
+          core.setData( BLACK_CARBON_COMPONENT_NAME, D_EMISSIONS_BC,
+                        message_data( 2050, unitval( 20, U_TG ) ) );
+      },
+      { D_RF_BC, D_RF_OC, D_RF_SO2, D_RF_NH3, D_RF_ACI, D_RF_VOL,
+        D_ATMOSPHERIC_O3, D_RF_TOTAL, D_GLOBAL_TAS } },
+
+    { "AtmosphericChemistry", D_CHEMISTRY_ENGINE,
+      []( Core &core ) { return core.getChemistryEngine() != nullptr; },
+      []( Core &core ) {
+          return core.getChemistryEngine()->hasMethane() && core.getChemistryEngine()->hasN2O();
+      },
+      []( Core &core ) {
+          core.setData( OH_COMPONENT_NAME, D_COEFFICENT_NOX,
+                        message_data( unitval( 0.05, U_UNDEFINED ) ) );
+          core.setData( CH4_COMPONENT_NAME, D_EMISSIONS_CH4,
+                        message_data( 2050, unitval( 500, U_TG_CH4 ) ) );
+          core.setData( N2O_COMPONENT_NAME, D_CONSTRAINT_N2O,
+                        message_data( 2060, unitval( 400, U_PPBV_N2O ) ) );
+      },
+      { D_LIFETIME_OH, D_CH4_CONC, D_N2O_CONC, D_ATMOSPHERIC_O3, D_RF_CH4,
+        D_RF_N2O, D_RF_TOTAL, D_GLOBAL_TAS } },
+};
+
+} // namespace
+
+/*! \brief Unit tests for the engines, each of which must give exactly the
+ *         results of the components it runs.
+ */
+class TestEngines : public SSP245Test, public testing::WithParamInterface<EngineCase> {
+protected:
+    // Create a core prepared to run through 2100, optionally with the engine
+    std::unique_ptr<Core> makeEngineCore( const bool engine ) {
+        std::unique_ptr<Core> core = makeCore( { coreSetting( GetParam().setting, engine ),
+                                                 endDate( 2100 ) } );
+        core->prepareToRun();
+        return core;
+    }
+};
+
+TEST_P(TestEngines, MatchesComponents) {
+    std::unique_ptr<Core> separate = makeEngineCore( false );
+    std::unique_ptr<Core> engine = makeEngineCore( true );
+    EXPECT_FALSE( GetParam().attached( *separate ) );
+    ASSERT_TRUE( GetParam().attached( *engine ) );
+    EXPECT_TRUE( GetParam().complete( *engine ) );
+    separate->run();
+    engine->run();
+
+    // Results must be identical, not just close
+    EXPECT_EQ( fetch( *separate, GetParam().vars ), fetch( *engine, GetParam().vars ) );
+}
+
+TEST_P(TestEngines, PicksUpChanges) {
+    std::unique_ptr<Core> separate = makeEngineCore( false );
+    std::unique_ptr<Core> engine = makeEngineCore( true );
+    separate->run();
+    engine->run();
+
+    // Change a parameter and an input partway through, then rerun from there
+    for( Core *core : { separate.get(), engine.get() } ) {
+        GetParam().change( *core );
+        core->reset( 2000 );
+        core->run();
+    }
+    EXPECT_EQ( fetch( *separate, GetParam().vars ), fetch( *engine, GetParam().vars ) );
+}
+
+TEST_P(TestEngines, MustBeSetBeforeSetup) {
+    std::unique_ptr<Core> core = makeEngineCore( false );
+    EXPECT_THROW( core->setData( CORE_COMPONENT_NAME, GetParam().setting,
+                                 message_data( unitval( 1, U_UNDEFINED ) ) ),
+                  h_exception );
+}
+
+INSTANTIATE_TEST_SUITE_P(Engines, TestEngines, testing::ValuesIn( ENGINES ),
+                         []( const testing::TestParamInfo<EngineCase> &info ) {
+                             return std::string( info.param.name );
+                         });
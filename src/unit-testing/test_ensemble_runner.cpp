@@ -0,0 +1,128 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_ensemble_runner.cpp
+ *  hector
+ *
+ *  Unit tests for running parameter ensembles on worker threads.
+ *
+ */
+
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "component_data.hpp"
+#include "core.hpp"
+#include "ensemble_runner.hpp"
+#include "h_exception.hpp"
+#include "message_data.hpp"
+#include "scenario.hpp"
+#include "ssp245_test.hpp"
+
+using namespace Hector;
+
+/*! \brief Unit tests for the EnsembleRunner class.
+ */
+class TestEnsembleRunner : public SSP245Test {
+protected:
+    virtual void SetUp() {
+        paramNames = { D_BETA, D_ECS };
+        paramUnits = { U_UNITLESS, U_DEGC };
+        vars = { D_GLOBAL_TAS, D_CO2_CONC };
+        for( double d = 1850; d <= 2100; d += 50 ) {
+            dates.push_back( d );
+        }
+        // Three members, stored column-major: all betas, then all ECS values
+        paramValues = { 0.4, 0.5, 0.6, 2.5, 3.0, 3.5 };
+    }
+
+    // Run a core by hand for one member, with its parameters set before
+    // the run is prepared, the same way the runner does
+    std::vector<double> runByHand( const double beta, const double ecs ) {
+        std::unique_ptr<Core> core = makeCore();
+        core->sendMessage( M_SETDATA, D_BETA, message_data( Core::undefinedIndex(), unitval( beta, U_UNITLESS ) ) );
+        core->sendMessage( M_SETDATA, D_ECS, message_data( Core::undefinedIndex(), unitval( ecs, U_DEGC ) ) );
+        core->prepareToRun();
+        core->run();
+        std::vector<double> rtn;
+        for( size_t j = 0; j < vars.size(); ++j ) {
+            for( size_t i = 0; i < dates.size(); ++i ) {
+                unitval value = core->sendMessage( M_GETDATA, vars[j], message_data( dates[i] ) );
+                rtn.push_back( value.value( value.units() ) );
+            }
+        }
+        core->shutDown();
+        return rtn;
+    }
+
+    // One member's results out of a block of them
+    std::vector<double> member( const std::vector<double>& results, const size_t m, const size_t size ) {
+        return std::vector<double>( results.begin() + m * size, results.begin() + ( m + 1 ) * size );
+    }
+
+    std::vector<std::string> paramNames;
+    std::vector<unit_types> paramUnits;
+    std::vector<std::string> vars;
+    std::vector<double> dates;
+    std::vector<double> paramValues;
+};
+
+TEST_F(TestEnsembleRunner, MatchesSingleCoreRuns) {
+    const size_t nmember = 3;
+    EnsembleRunner runner( paramNames, paramUnits, vars, dates );
+    std::vector<double> results( runner.memberSize() * nmember );
+    runner.run( scenario(), 2, paramValues.data(), nmember, results.data() );
+
+    ASSERT_EQ( runner.getUnits().size(), runner.memberSize() );
+    EXPECT_EQ( runner.getUnits()[0], "degC" );
+
+    // Each member should match a core set up and run by hand exactly
+    for( size_t m = 0; m < nmember; ++m ) {
+        EXPECT_EQ( runner.getErrors()[m], "" );
+        EXPECT_EQ( member( results, m, runner.memberSize() ),
+                   runByHand( paramValues[m], paramValues[nmember + m] ) ) << "member " << m;
+    }
+}
+
+TEST_F(TestEnsembleRunner, ResultsDontDependOnWorkerHistory) {
+    // On one thread the third member runs after two others; it should come
+    // out the same as when it is the only member run
+    EnsembleRunner runner( paramNames, paramUnits, vars, dates );
+    const std::vector<double> used = { 0.4, 0.6, 0.4, 2.5, 3.5, 2.5 };
+    std::vector<double> usedResults( runner.memberSize() * 3 );
+    runner.run( scenario(), 1, used.data(), 3, usedResults.data() );
+
+    const std::vector<double> fresh = { 0.4, 2.5 };
+    std::vector<double> freshResults( runner.memberSize() );
+    runner.run( scenario(), 1, fresh.data(), 1, freshResults.data() );
+
+    EXPECT_EQ( member( usedResults, 2, runner.memberSize() ), freshResults );
+    EXPECT_EQ( member( usedResults, 0, runner.memberSize() ), freshResults );
+}
+
+TEST_F(TestEnsembleRunner, FailedMembersAreFlagged) {
+    paramNames[0] = "not-a-parameter";
+    const size_t nmember = 3;
+    EnsembleRunner runner( paramNames, paramUnits, vars, dates );
+    std::vector<double> results( runner.memberSize() * nmember );
+    runner.run( scenario(), 1, paramValues.data(), nmember, results.data() );
+
+    for( size_t m = 0; m < nmember; ++m ) {
+        EXPECT_NE( runner.getErrors()[m], "" );
+    }
+    for( double r : results ) {
+        EXPECT_TRUE( std::isnan( r ) );
+    }
+}
+
+TEST_F(TestEnsembleRunner, NeedsThreads) {
+    EnsembleRunner runner( paramNames, paramUnits, vars, dates );
+    std::vector<double> results( runner.memberSize() );
+    ASSERT_THROW( runner.run( scenario(), 0, paramValues.data(), 1, results.data() ), h_exception );
+}
@@ -12,6 +12,7 @@
  *
  */
 
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <gtest/gtest.h>
@@ -154,3 +155,32 @@ TEST_F(TestINIToCore, TableFilenameWithCSVPrefix) {
         ASSERT_EQ( e.get_filename(), "csv_table_reader.cpp" );
     }
 }
+
+TEST_F(TestINIToCore, TableRelativeToINIFile) {
+    // A table named relative to the INI file's directory rather than the
+    // working directory, and used on more than one line
+    std::filesystem::create_directory( "ini_test_dir" );
+    {
+        std::ofstream table( "ini_test_dir/ini_test_table.csv" );
+        table << "year,c" << std::endl << "1,5" << std::endl << "2,6" << std::endl;
+        std::ofstream ini( "ini_test_dir/ini_test_file.ini" );
+        ini << "[dummy-component]" << std::endl;
+        ini << "c=csv:ini_test_table.csv" << std::endl;
+        ini << "c=csv:ini_test_table.csv" << std::endl;
+    }
+    EXPECT_EQ( INIToCoreReader::findTable( "ini_test_table.csv", "ini_test_dir/ini_test_file.ini" ),
+               "ini_test_dir/ini_test_table.csv" );
+    // A path that exists as given is used as is
+    EXPECT_EQ( INIToCoreReader::findTable( "ini_test_dir/ini_test_table.csv", "elsewhere/hector.ini" ),
+               "ini_test_dir/ini_test_table.csv" );
+
+    ASSERT_NO_THROW( reader.parse( "ini_test_dir/ini_test_file.ini" ) );
+    const DummyModelComponent* dummy =
+        dynamic_cast<DummyModelComponent*>( core.getComponentByName( DUMMY_COMPONENT_NAME ) );
+    ASSERT_TRUE( dummy );
+    tseries<double> c = dummy->getC();
+    EXPECT_EQ( c.size(), 2 );
+    EXPECT_EQ( c.get( 1 ), 5 );
+    EXPECT_EQ( c.get( 2 ), 6 );
+    std::filesystem::remove_all( "ini_test_dir" );
+}
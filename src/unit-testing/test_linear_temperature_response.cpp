@@ -0,0 +1,103 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_linear_temperature_response.cpp
+ *  hector
+ *
+ *  Unit tests for temperature trajectories by impulse response.
+ *
+ */
+
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "component_data.hpp"
+#include "component_names.hpp"
+#include "core.hpp"
+#include "h_exception.hpp"
+#include "linear_temperature_response.hpp"
+#include "ssp245_test.hpp"
+#include "temperature_component.hpp"
+
+using namespace Hector;
+
+/*! \brief Unit tests for the LinearTemperatureResponse class.
+ */
+class TestLinearTemperatureResponse : public SSP245Test {
+protected:
+    void SetUp() override {
+        core = makeCore( { endDate( 2100 ) } );
+        core->prepareToRun();
+        temperature = dynamic_cast<TemperatureComponent *>(
+            core->getComponentByName( TEMPERATURE_COMPONENT_NAME ) );
+    }
+
+    std::unique_ptr<Core> core;
+    TemperatureComponent *temperature;
+};
+
+TEST_F(TestLinearTemperatureResponse, ReproducesRun) {
+    core->run();
+    // The model takes the forcing at the start date as zero
+    std::vector<double> forcing = fetch( *core, { D_RF_TOTAL } );
+    forcing.insert( forcing.begin(), 0.0 );
+
+    const LinearTemperatureResponse response( *temperature );
+    ASSERT_EQ( response.maxYears(), forcing.size() );
+    LinearTemperatureResponse::Trajectories out;
+    response.compute( forcing, out );
+
+    const std::pair<std::string, std::vector<double> *> checks[] = {
+        { D_GLOBAL_TAS, &out.temp },
+        { D_GMST, &out.temp_surface },
+        { D_LAND_TAS, &out.temp_landair },
+        { D_SST, &out.temp_sst },
+        { D_FLUX_MIXED, &out.heatflux_mixed },
+        { D_FLUX_INTERIOR, &out.heatflux_interior } };
+    for( auto &check : checks ) {
+        const std::vector<double> expected = fetch( *core, { check.first } );
+        const std::vector<double> &actual = *check.second;
+        ASSERT_EQ( actual.size(), expected.size() + 1 ) << check.first;
+        EXPECT_EQ( actual[0], 0.0 ) << check.first;
+        for( size_t i = 0; i < expected.size(); ++i ) {
+            EXPECT_NEAR( actual[i + 1], expected[i], 1e-10 ) << check.first << " " << i;
+        }
+    }
+}
+
+TEST_F(TestLinearTemperatureResponse, LinearInForcing) {
+    const LinearTemperatureResponse response( *temperature );
+    std::vector<double> step( 200, 1.0 ), ramp( 200 );
+    step[0] = 0.0;
+    for( size_t i = 0; i < ramp.size(); ++i ) {
+        ramp[i] = 0.02 * i;
+    }
+    std::vector<double> sum( 200 );
+    for( size_t i = 0; i < sum.size(); ++i ) {
+        sum[i] = 3.0 * step[i] + ramp[i];
+    }
+    LinearTemperatureResponse::Trajectories a, b, c;
+    response.compute( step, a );
+    response.compute( ramp, b );
+    response.compute( sum, c );
+    for( size_t i = 0; i < sum.size(); ++i ) {
+        EXPECT_NEAR( c.temp[i], 3.0 * a.temp[i] + b.temp[i], 1e-10 );
+        EXPECT_NEAR( c.heat_interior[i], 3.0 * a.heat_interior[i] + b.heat_interior[i], 1e-8 );
+    }
+    // Warming approaches the climate sensitivity to that forcing
+    EXPECT_GT( a.temp.back(), 0.5 );
+}
+
+TEST_F(TestLinearTemperatureResponse, Errors) {
+    const LinearTemperatureResponse response( *temperature );
+    LinearTemperatureResponse::Trajectories out;
+    EXPECT_THROW( response.compute( std::vector<double>( response.maxYears() + 1 ), out ),
+                  h_exception );
+
+    TemperatureComponent unprepared;
+    EXPECT_THROW( LinearTemperatureResponse response2( unprepared ), h_exception );
+}
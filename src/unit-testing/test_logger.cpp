@@ -15,6 +15,9 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <gtest/gtest.h>
 
 #include "h_exception.hpp"
@@ -134,3 +137,163 @@ loggerEcho.close();
                  h_exception );
     EXPECT_EQ(consoleTestBuff.str(), oldlog);  // i.e. no change
 }
+
+TEST_F(LoggerTest, FileGetsAllMessagesInOrder) {
+    // Log from two threads at once; each file should end up with all of its
+    // own messages, in order, once its logger is closed.
+    const int nmsg = 10000;
+    const std::string names[] = { "logger_test_thread1", "logger_test_thread2" };
+    Logger loggers[2];
+    auto logMany = [nmsg]( Logger* logger ) {
+        for( int i = 0; i < nmsg; ++i ) {
+            H_LOG((*logger), Logger::SEVERE) << "message " << i << std::endl;
+        }
+    };
+    for( int t = 0; t < 2; ++t ) {
+        loggers[t].open( names[t], false, true, Logger::WARNING );
+    }
+    std::thread t1( logMany, &loggers[0] );
+    std::thread t2( logMany, &loggers[1] );
+    t1.join();
+    t2.join();
+
+    for( int t = 0; t < 2; ++t ) {
+        loggers[t].close();
+        const std::string fileName = LOG_DIRECTORY + names[t] + LOG_EXTENSION;
+        std::ifstream logFile( fileName.c_str() );
+        std::string line;
+        int next = 0;
+        while( std::getline( logFile, line ) ) {
+            const std::string expected = ": message " + std::to_string( next );
+            if( line.size() >= expected.size() &&
+               line.compare( line.size() - expected.size(), expected.size(), expected ) == 0 ) {
+                ++next;
+            }
+        }
+        logFile.close();
+        EXPECT_EQ( next, nmsg ) << fileName;
+        remove( fileName.c_str() );
+    }
+}
+
+TEST_F(LoggerTest, ChildWritesToParentsFile) {
+    const std::string name = "logger_test_parent";
+    const std::string fileName = LOG_DIRECTORY + name + LOG_EXTENSION;
+    Logger parent;
+    Logger child;
+    parent.open( name, false, true, Logger::WARNING );
+    child.open( "child", parent );
+    EXPECT_TRUE( child.isEnabled() );
+    EXPECT_EQ( child.getMinLogLevel(), Logger::WARNING );
+
+    H_LOG(parent, Logger::SEVERE) << "from the parent" << std::endl;
+    H_LOG(child, Logger::SEVERE) << "from the child" << std::endl;
+    // the parent can close first; the file stays open until the child closes
+    parent.close();
+    child.close();
+
+    std::ifstream logFile( fileName.c_str() );
+    std::stringstream contents;
+    contents << logFile.rdbuf();
+    logFile.close();
+    testing::internal::RE parentRegex( ":SEVERE:[^:]+: from the parent" );
+    testing::internal::RE childRegex( ":SEVERE:child:[^:]+: from the child" );
+    EXPECT_TRUE( testing::internal::RE::PartialMatch( contents.str(), parentRegex ) ) << contents.str();
+    EXPECT_TRUE( testing::internal::RE::PartialMatch( contents.str(), childRegex ) ) << contents.str();
+    remove( fileName.c_str() );
+}
+
+TEST_F(LoggerTest, ChildProcessCanLogAfterFork) {
+    // Log to a file before forking (as an R session might before
+    // parallel::mclapply); the child must still be able to fill the queue
+    // and close its own log without hanging
+    const std::string name = "logger_test_fork";
+    const std::string fileName = LOG_DIRECTORY + name + LOG_EXTENSION;
+    Logger parent;
+    parent.open( name, false, true, Logger::WARNING );
+    H_LOG(parent, Logger::SEVERE) << "before fork" << std::endl;
+
+    const pid_t pid = fork();
+    ASSERT_NE( pid, -1 );
+    if( pid == 0 ) {
+        alarm( 20 );  // a hang kills the child, and the test fails
+        const std::string childName = "logger_test_fork_child";
+        const std::string childFile = LOG_DIRECTORY + childName + LOG_EXTENSION;
+        Logger child;
+        child.open( childName, false, true, Logger::WARNING );
+        const int nmsg = 10000;  // more than the writer's queue holds
+        for( int i = 0; i < nmsg; ++i ) {
+            H_LOG(child, Logger::SEVERE) << "message " << i << std::endl;
+        }
+        child.close();
+        std::ifstream logFile( childFile.c_str() );
+        std::string line;
+        int nlines = 0;
+        while( std::getline( logFile, line ) ) {
+            ++nlines;
+        }
+        logFile.close();
+        remove( childFile.c_str() );
+        _exit( nlines >= nmsg ? 0 : 1 );
+    }
+
+    int status = 0;
+    ASSERT_EQ( waitpid( pid, &status, 0 ), pid );
+    ASSERT_TRUE( WIFEXITED( status ) ) << "child hung or crashed";
+    EXPECT_EQ( WEXITSTATUS( status ), 0 ) << "child's log is incomplete";
+
+    // The parent's writer carries on as before
+    H_LOG(parent, Logger::SEVERE) << "after fork" << std::endl;
+    parent.close();
+    std::ifstream logFile( fileName.c_str() );
+    std::stringstream contents;
+    contents << logFile.rdbuf();
+    logFile.close();
+    testing::internal::RE beforeRegex( "before fork" );
+    testing::internal::RE afterRegex( "after fork" );
+    EXPECT_TRUE( testing::internal::RE::PartialMatch( contents.str(), beforeRegex ) ) << contents.str();
+    EXPECT_TRUE( testing::internal::RE::PartialMatch( contents.str(), afterRegex ) ) << contents.str();
+    remove( fileName.c_str() );
+}
+
+TEST_F(LoggerTest, SameNameGetsSeparateFiles) {
+    const std::string name = "logger_test_same";
+    Logger first;
+    Logger second;
+    first.open( name, false, true, Logger::WARNING );
+    second.open( name, false, true, Logger::WARNING );
+    first.close();
+    second.close();
+
+    const std::string firstFile = LOG_DIRECTORY + name + LOG_EXTENSION;
+    const std::string secondFile = LOG_DIRECTORY + name + "_2" + LOG_EXTENSION;
+    EXPECT_TRUE( fileExists( firstFile.c_str() ) );
+    EXPECT_TRUE( fileExists( secondFile.c_str() ) );
+    remove( firstFile.c_str() );
+    remove( secondFile.c_str() );
+}
+
+TEST_F(LoggerTest, RecentRecordsInMemory) {
+    Logger logger;
+    Logger child;
+    logger.open( "logger_test_memory", false, false, Logger::WARNING, 3 );
+    child.open( "child", logger );
+    EXPECT_TRUE( logger.isEnabled() );
+    EXPECT_TRUE( child.isEnabled() );
+
+    for( int i = 0; i < 4; ++i ) {
+        H_LOG(logger, Logger::SEVERE) << "message " << i << std::endl;
+    }
+    H_LOG(logger, Logger::DEBUG) << "too low to keep" << std::endl;
+    H_LOG(child, Logger::WARNING) << "child message" << std::endl;
+
+    const std::vector<std::string> recent = logger.getRecentRecords();
+    ASSERT_EQ( recent.size(), 3 );
+    testing::internal::RE regex2( "message 2$" );
+    testing::internal::RE regex3( "message 3$" );
+    testing::internal::RE regexChild( ":child:.*child message$" );
+    EXPECT_TRUE( testing::internal::RE::PartialMatch( recent[0], regex2 ) ) << recent[0];
+    EXPECT_TRUE( testing::internal::RE::PartialMatch( recent[1], regex3 ) ) << recent[1];
+    EXPECT_TRUE( testing::internal::RE::PartialMatch( recent[2], regexChild ) ) << recent[2];
+    EXPECT_EQ( child.getRecentRecords(), recent );
+}
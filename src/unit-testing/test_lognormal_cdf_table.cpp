@@ -0,0 +1,70 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_lognormal_cdf_table.cpp
+ *  hector
+ *
+ *  Unit tests for the tabulated lognormal CDF.
+ *
+ */
+
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "h_exception.hpp"
+#include "lognormal_cdf_table.hpp"
+
+using namespace Hector;
+
+TEST(TestLognormalCDFTable, MatchesExactCDF) {
+    // Default permafrost parameters, and a narrow and a wide distribution
+    const double params[][2] = { { 1.67, 0.986 }, { 0.5, 0.2 }, { 2.5, 2.0 } };
+    for( auto p : params ) {
+        auto table = LognormalCDFTable::get( p[0], p[1] );
+        for( double x = -1.0; x < 100.0; x += 0.0137 ) {
+            EXPECT_NEAR( table->cdf( x ), table->exact_cdf( x ),
+                         LognormalCDFTable::maxError ) << x;
+        }
+    }
+}
+
+TEST(TestLognormalCDFTable, ZeroAtAndBelowZero) {
+    auto table = LognormalCDFTable::get( 1.67, 0.986 );
+    EXPECT_EQ( table->cdf( 0.0 ), 0.0 );
+    EXPECT_EQ( table->cdf( -3.0 ), 0.0 );
+}
+
+TEST(TestLognormalCDFTable, RejectsNaN) {
+    // As the exact CDF does, rather than reading outside the table
+    auto table = LognormalCDFTable::get( 1.67, 0.986 );
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_ANY_THROW( table->exact_cdf( nan ) );
+    EXPECT_ANY_THROW( table->cdf( nan ) );
+}
+
+TEST(TestLognormalCDFTable, DistributionBeyondTableRange) {
+    // mu - 8.5 sigma is above log(60), so there is nothing to tabulate
+    auto table = LognormalCDFTable::get( 5.0, 0.1 );
+    EXPECT_EQ( table->size(), 0u );
+    for( double x = -1.0; x < 400.0; x += 0.37 ) {
+        EXPECT_NEAR( table->cdf( x ), table->exact_cdf( x ),
+                     LognormalCDFTable::maxError ) << x;
+    }
+    EXPECT_GT( table->cdf( 200.0 ), 0.5 );
+}
+
+TEST(TestLognormalCDFTable, SharedBetweenUsers) {
+    auto a = LognormalCDFTable::get( 1.67, 0.986 );
+    auto b = LognormalCDFTable::get( 1.67, 0.986 );
+    auto c = LognormalCDFTable::get( 1.67, 0.5 );
+    EXPECT_EQ( a.get(), b.get() );
+    EXPECT_NE( a.get(), c.get() );
+    EXPECT_EQ( c->get_sigma(), 0.5 );
+
+    EXPECT_THROW( LognormalCDFTable::get( 1.67, 0.0 ), h_exception );
+}
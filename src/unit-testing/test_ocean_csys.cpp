@@ -0,0 +1,80 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_ocean_csys.cpp
+ *  hector
+ *
+ *  Unit tests for the ocean carbon chemistry.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "ocean_csys.hpp"
+
+using namespace Hector;
+
+/*! \brief Unit tests for the oceancsys class.
+ */
+class TestOceanCsys : public testing::Test {
+protected:
+    // A surface box set up like the model's low-latitude box
+    static void setup( oceancsys& csys ) {
+        csys.S = 34.5;
+        csys.volumeofbox = 3.6e15;
+        csys.As = 2.9e14;
+        csys.U = 6.7;
+        csys.set_alk( 2.3e-3 );
+    }
+
+    // Check that two runs give exactly the same results
+    static void expectSame( const oceancsys& a, const oceancsys& b ) {
+        EXPECT_EQ( a.pH.value( U_PH ), b.pH.value( U_PH ) );
+        EXPECT_EQ( a.PCO2o.value(), b.PCO2o.value() );
+        EXPECT_EQ( a.CO3.value( U_UMOL_KG ), b.CO3.value( U_UMOL_KG ) );
+        EXPECT_EQ( a.OmegaAr.value( U_UNITLESS ), b.OmegaAr.value( U_UNITLESS ) );
+        EXPECT_EQ( a.get_K0().value( U_MOL_L_ATM ), b.get_K0().value( U_MOL_L_ATM ) );
+        EXPECT_EQ( a.get_Tr().value( U_gC_m2_month_uatm ),
+                   b.get_Tr().value( U_gC_m2_month_uatm ) );
+    }
+};
+
+TEST_F(TestOceanCsys, ConstantsFollowTemperature) {
+    oceancsys cached, fresh;
+    setup( cached );
+    setup( fresh );
+    const unitval carbon( 140.0, U_PGC );
+
+    // Run at one temperature, then another: the constants must be updated
+    cached.ocean_csys_run( unitval( 20.0, U_DEGC ), carbon );
+    cached.ocean_csys_run( unitval( 22.0, U_DEGC ), carbon );
+    fresh.ocean_csys_run( unitval( 22.0, U_DEGC ), carbon );
+    expectSame( cached, fresh );
+    EXPECT_GT( cached.get_K0().value( U_MOL_L_ATM ), 0.0 );
+
+    // Same temperature, different carbon: only the speciation changes
+    const unitval more_carbon( 150.0, U_PGC );
+    oceancsys fresh2;
+    setup( fresh2 );
+    cached.ocean_csys_run( unitval( 22.0, U_DEGC ), more_carbon );
+    fresh2.ocean_csys_run( unitval( 22.0, U_DEGC ), more_carbon );
+    expectSame( cached, fresh2 );
+    EXPECT_NE( cached.pH.value( U_PH ), fresh.pH.value( U_PH ) );
+}
+
+TEST_F(TestOceanCsys, ConstantsFollowSalinity) {
+    oceancsys cached, fresh;
+    setup( cached );
+    setup( fresh );
+    const unitval carbon( 140.0, U_PGC );
+
+    cached.ocean_csys_run( unitval( 20.0, U_DEGC ), carbon );
+    cached.S = fresh.S = 35.5;
+    cached.ocean_csys_run( unitval( 20.0, U_DEGC ), carbon );
+    fresh.ocean_csys_run( unitval( 20.0, U_DEGC ), carbon );
+    expectSame( cached, fresh );
+}
@@ -0,0 +1,183 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_output_subscriptions.cpp
+ *  hector
+ *
+ *  Unit tests for writing only selected outputs.
+ *
+ */
+
+#include <memory>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include "component_data.hpp"
+#include "component_names.hpp"
+#include "core.hpp"
+#include "csv_outputstream_visitor.hpp"
+#include "h_exception.hpp"
+#include "imodel_component.hpp"
+#include "message_data.hpp"
+#include "ssp245_test.hpp"
+
+using namespace Hector;
+
+/*! \brief Unit tests for output subscriptions.
+ */
+class TestOutputSubscriptions : public SSP245Test {
+protected:
+    void SetUp() override {
+        core = makeCore();
+    }
+
+    // Subscribe as an [output] line in an INI file would
+    void subscribe( const std::string &datum, const std::string &years ) {
+        core->setData( OUTPUT_SECTION_NAME, datum, message_data( years ) );
+    }
+
+    // Run the model, returning the CSV output lines (without a header)
+    std::vector<std::string> run() {
+        std::ostringstream out;
+        CSVOutputStreamVisitor visitor( out, false );
+        core->addVisitor( &visitor );
+        core->prepareToRun();
+        core->run( 2010 );
+        visitor.flush();
+
+        std::vector<std::string> lines;
+        std::istringstream in( out.str() );
+        std::string line;
+        while( std::getline( in, line ) ) {
+            lines.push_back( line );
+        }
+        return lines;
+    }
+
+    std::unique_ptr<Core> core;
+
+    // A component whose output can be fetched by date only through 1800
+    class ShortSeriesComponent: public IModelComponent {
+    public:
+        virtual std::string getComponentName() const { return "short-series"; }
+        virtual void init( Core* core ) {}
+        virtual unitval sendMessage( const std::string& message, const std::string& datum,
+                                     const message_data info = message_data() ) {
+            return getData( datum, info.date );
+        }
+        virtual void setData( const std::string& varName, const message_data& data ) {}
+        virtual void prepareToRun() {}
+        virtual void run( const double runToDate ) {}
+        virtual void reset( double time ) {}
+        virtual void shutDown() {}
+        virtual void accept( AVisitor* visitor ) {}
+    private:
+        virtual unitval getData( const std::string& varName, const double date ) {
+            H_ASSERT( date <= 1800, "no value for this date" );
+            return unitval( date, U_UNITLESS );
+        }
+    };
+
+    // A visitor that checks what the core's current date is when it's called
+    class CurrentDateVisitor: public AVisitor {
+    public:
+        virtual bool shouldVisit( const bool in_spinup, const double date ) {
+            if( !in_spinup ) {
+                dates.push_back( date );
+                currentDates.push_back( core->getCurrentDate() );
+            }
+            return false;
+        }
+        virtual void visit( Core* c ) { core = c; }
+
+        std::vector<double> dates;
+        std::vector<double> currentDates;
+    private:
+        Core* core;
+    };
+};
+
+TEST_F(TestOutputSubscriptions, WritesOnlySubscribed) {
+    subscribe( D_GLOBAL_TAS, "2001 - 2003" );
+    subscribe( D_CO2_CONC, "2005" );
+    subscribe( std::string( OCEAN_COMPONENT_NAME ) + "/" + D_REVELLE_HL,
+               "2010-2100" );
+    const std::vector<std::string> lines = run();
+    ASSERT_EQ( lines.size(), 5u );
+    EXPECT_EQ( lines[0].rfind( "2001,ssp245,0,temperature,global_tas,", 0 ), 0u );
+    EXPECT_EQ( lines[2].rfind( "2003,ssp245,0,temperature,global_tas,", 0 ), 0u );
+    EXPECT_EQ( lines[3].rfind( "2005,ssp245,0,simpleNbox,CO2_concentration,", 0 ), 0u );
+    EXPECT_EQ( lines[4].rfind( "2010,ssp245,0,ocean,HL_Revelle,", 0 ), 0u );
+
+    // Values are the same as fetching them
+    std::vector<double> values;
+    std::vector<std::string> units;
+    core->getDataBlock( { D_GLOBAL_TAS }, { 2002 }, values, units );
+    const std::string value = lines[1].substr( lines[1].find( "global_tas," ) + 11 );
+    EXPECT_NEAR( std::stod( value ), values[0], 1e-5 );
+    EXPECT_EQ( value.substr( value.find( ',' ) + 1 ), units[0] );
+}
+
+TEST_F(TestOutputSubscriptions, AllYears) {
+    subscribe( D_GLOBAL_TAS, "all" );
+    // The starting state, then 1746 through 2010; none from spinup
+    EXPECT_EQ( run().size(), 2010u - 1745u + 1u );
+}
+
+TEST_F(TestOutputSubscriptions, BadSubscriptions) {
+    EXPECT_THROW( subscribe( D_GLOBAL_TAS, "2000-" ), h_exception );
+    EXPECT_THROW( subscribe( D_GLOBAL_TAS, "soon" ), h_exception );
+    EXPECT_THROW( subscribe( D_GLOBAL_TAS, "2000-1900" ), h_exception );
+    // Unknown outputs are found when the model is set up
+    subscribe( "no_such_output", "all" );
+    EXPECT_THROW( core->prepareToRun(), h_exception );
+}
+
+TEST_F(TestOutputSubscriptions, DatingIsFoundAtSetup) {
+    subscribe( D_GLOBAL_TAS, "all" );
+    subscribe( std::string( OCEAN_COMPONENT_NAME ) + "/" + D_REVELLE_HL, "1746-2100" );
+    std::ostringstream out;
+    CSVOutputStreamVisitor visitor( out, false );
+    core->addVisitor( &visitor );
+    core->prepareToRun();
+    ASSERT_EQ( core->getOutputSubscriptions().size(), 2u );
+    EXPECT_EQ( core->getOutputSubscriptions()[0].dating, Core::OutputSubscription::DATED );
+    // The Revelle factor can't be computed until the model has run a year
+    EXPECT_EQ( core->getOutputSubscriptions()[1].dating, Core::OutputSubscription::DATING_UNKNOWN );
+    core->run( 1746 );
+    // and is only kept as its current value
+    EXPECT_EQ( core->getOutputSubscriptions()[1].dating, Core::OutputSubscription::UNDATED );
+}
+
+TEST_F(TestOutputSubscriptions, FetchErrorsAreReported) {
+    // An output that can be fetched by date at the start, but not later, is
+    // an error rather than quietly switching to its current value
+    core.reset( new Core( Logger::SEVERE, false, false ) );
+    core->addModelComponent( new ShortSeriesComponent );
+    core->init();
+    core->applyScenario( scenario() );
+    subscribe( "short-series/x", "all" );
+    std::ostringstream out;
+    CSVOutputStreamVisitor visitor( out, false );
+    core->addVisitor( &visitor );
+    core->prepareToRun();
+    EXPECT_EQ( core->getOutputSubscriptions()[0].dating, Core::OutputSubscription::DATED );
+    EXPECT_THROW( core->run( 1810 ), h_exception );
+    EXPECT_EQ( core->getCurrentDate(), 1801 );
+}
+
+TEST_F(TestOutputSubscriptions, VisitorsSeeTheirDate) {
+    // Core::run advances the current date before calling the visitors
+    CurrentDateVisitor visitor;
+    core->addVisitor( &visitor );
+    core->prepareToRun();
+    core->run( 1800 );
+    core->run( 1810 );
+    // The starting state is visited as part of spinup
+    ASSERT_EQ( visitor.dates.size(), 1810u - 1746u + 1u );
+    EXPECT_EQ( visitor.currentDates, visitor.dates );
+}
@@ -0,0 +1,85 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_quantity.cpp
+ *  hector
+ *
+ *  Unit tests for quantities with compile-time units.
+ *
+ */
+
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <gtest/gtest.h>
+
+#include "h_exception.hpp"
+#include "quantity.hpp"
+
+using namespace Hector;
+
+namespace {
+
+// Whether a + b, a / b compile
+template <class A, class B, class = void> struct can_add : std::false_type {};
+template <class A, class B>
+struct can_add<A, B, std::void_t<decltype( std::declval<A>() + std::declval<B>() )>>
+    : std::true_type {};
+template <class A, class B, class = void> struct can_divide : std::false_type {};
+template <class A, class B>
+struct can_divide<A, B, std::void_t<decltype( std::declval<A>() / std::declval<B>() )>>
+    : std::true_type {};
+
+}
+
+TEST(TestQuantity, UnitsCheckedAtCompileTime) {
+    static_assert( can_add<quantity<U_PGC>, quantity<U_PGC>>::value, "" );
+    static_assert( !can_add<quantity<U_PGC>, quantity<U_PGC_YR>>::value, "" );
+    static_assert( can_divide<quantity<U_PGC>, quantity<U_PGC>>::value, "" );
+    static_assert( !can_divide<quantity<U_PGC>, quantity<U_PGC_YR>>::value, "" );
+    static_assert( !std::is_convertible<double, quantity<U_PGC>>::value, "" );
+    static_assert( !std::is_convertible<unitval, quantity<U_PGC>>::value, "" );
+    static_assert( sizeof( quantity<U_PGC> ) == sizeof( double ), "" );
+}
+
+TEST(TestQuantity, Arithmetic) {
+    const quantity<U_PGC> a( 3.0 ), b( 1.5 );
+    EXPECT_EQ( ( a + b ).value(), 4.5 );
+    EXPECT_EQ( ( a - b ).value(), 1.5 );
+    EXPECT_EQ( ( -a ).value(), -3.0 );
+    EXPECT_EQ( ( 2.0 * a ).value(), 6.0 );
+    EXPECT_EQ( ( a * 2.0 ).value(), 6.0 );
+    EXPECT_EQ( ( a / 2.0 ).value(), 1.5 );
+    EXPECT_EQ( a / b, 2.0 );
+    EXPECT_TRUE( b < a );
+    EXPECT_TRUE( a == quantity<U_PGC>( 3.0 ) );
+
+    quantity<U_PGC> c;
+    EXPECT_EQ( c.value(), 0.0 );
+    c += a;
+    c -= b;
+    c *= 4.0;
+    c /= 2.0;
+    EXPECT_EQ( c.value(), 3.0 );
+}
+
+TEST(TestQuantity, ConvertsToAndFromUnitval) {
+    const quantity<U_PGC_YR> q( unitval( 2.5, U_PGC_YR ) );
+    EXPECT_EQ( q.value(), 2.5 );
+#if HECTOR_CHECKED
+    EXPECT_THROW( quantity<U_PGC_YR>( unitval( 2.5, U_PGC ) ), h_exception );
+#endif
+
+    const unitval u = q;
+    EXPECT_EQ( u.units(), U_PGC_YR );
+    EXPECT_EQ( u.value( U_PGC_YR ), 2.5 );
+
+    std::ostringstream a, b;
+    a << q;
+    b << u;
+    EXPECT_EQ( a.str(), b.str() );
+}
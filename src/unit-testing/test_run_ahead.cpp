@@ -0,0 +1,104 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_run_ahead.cpp
+ *  hector
+ *
+ *  Unit tests for computing constrained components ahead of the run.
+ *
+ */
+
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "component_data.hpp"
+#include "component_names.hpp"
+#include "core.hpp"
+#include "message_data.hpp"
+#include "ssp245_test.hpp"
+
+using namespace Hector;
+
+/*! \brief Unit tests for IModelComponent::runAhead().
+ */
+class TestRunAhead : public SSP245Test {
+protected:
+    // Record an unconstrained run's CH4, N2O, and CFC11, to use as constraints
+    void SetUp() {
+        std::unique_ptr<Core> reference = makeCore();
+        reference->prepareToRun();
+        reference->run( lastConstrained );
+        reference->getDataBlock( constrainedVars, dates(), constraints, units );
+    }
+
+    // Create a core with CH4, N2O, and CFC11 constrained through lastConstrained
+    std::unique_ptr<Core> makeConstrainedCore() {
+        std::unique_ptr<Core> core = makeCore();
+        const std::vector<double> d = dates();
+        for( std::size_t i = 0; i < d.size(); ++i ) {
+            for( std::size_t v = 0; v < constrainedVars.size(); ++v ) {
+                message_data data( d[i], unitval( constraints[v * d.size() + i],
+                                                  unitval::parseUnitsName( units[v * d.size() + i] ) ) );
+                core->setData( constrainedComponents[v], constraintNames[v], data );
+            }
+        }
+        core->prepareToRun();
+        return core;
+    }
+
+    std::vector<double> dates() const {
+        std::vector<double> d;
+        for( double date = 1746; date <= lastConstrained; ++date ) {
+            d.push_back( date );
+        }
+        return d;
+    }
+
+    // The results through the constrained years
+    std::vector<double> results( Core &core ) {
+        return fetch( core, vars, 1746, lastConstrained );
+    }
+
+    const double lastConstrained = 2014;
+    const std::vector<std::string> constrainedVars = { D_CH4_CONC, D_N2O_CONC,
+        CFC11_COMPONENT_BASE CONCENTRATION_EXTENSION };
+    const std::vector<std::string> constrainedComponents = { CH4_COMPONENT_NAME,
+        N2O_COMPONENT_NAME, CFC11_COMPONENT_BASE HALOCARBON_EXTENSION };
+    const std::vector<std::string> constraintNames = { D_CONSTRAINT_CH4,
+        D_CONSTRAINT_N2O, D_CONSTRAINT_CFC11 };
+    std::vector<double> constraints;
+    std::vector<std::string> units;
+
+    const std::vector<std::string> vars = { D_CH4_CONC, D_N2O_CONC, D_RF_CH4,
+        D_RF_N2O, D_RF_CFC11, D_RF_TOTAL, D_GLOBAL_TAS };
+};
+
+TEST_F(TestRunAhead, MatchesYearByYear) {
+    // Running only through the constrained years lets the constrained
+    // components compute every year up front; running one year past them
+    // doesn't
+    std::unique_ptr<Core> ahead = makeConstrainedCore();
+    std::unique_ptr<Core> yearly = makeConstrainedCore();
+    ahead->run( lastConstrained );
+    yearly->run( lastConstrained + 1 );
+
+    // Results must be identical, not just close
+    EXPECT_EQ( results( *ahead ), results( *yearly ) );
+}
+
+TEST_F(TestRunAhead, ResetAndContinue) {
+    std::unique_ptr<Core> ahead = makeConstrainedCore();
+    std::unique_ptr<Core> yearly = makeConstrainedCore();
+    ahead->run( lastConstrained );
+    yearly->run( lastConstrained + 1 );
+    const std::vector<double> expected = results( *yearly );
+
+    ahead->reset( 1900 );
+    ahead->run( 1950 );
+    ahead->run( lastConstrained );
+    EXPECT_EQ( results( *ahead ), expected );
+}
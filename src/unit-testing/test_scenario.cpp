@@ -0,0 +1,106 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_scenario.cpp
+ *  hector
+ *
+ *  Unit tests for setting up cores from a scenario.
+ *
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "component_data.hpp"
+#include "component_names.hpp"
+#include "core.hpp"
+#include "h_exception.hpp"
+#include "ini_to_core_reader.hpp"
+#include "message_data.hpp"
+#include "scenario.hpp"
+#include "ssp245_test.hpp"
+
+using namespace Hector;
+
+/*! \brief Unit tests for the Scenario class and Core::applyScenario().
+ */
+class TestScenario : public SSP245Test {
+protected:
+    std::unique_ptr<Core> newCore() {
+        std::unique_ptr<Core> core( new Core( Logger::SEVERE, false, false ) );
+        core->init();
+        return core;
+    }
+
+    // Run a core that has been given its inputs, and fetch some results
+    std::vector<double> results( Core &core ) {
+        core.prepareToRun();
+        core.run( 1950 );
+        std::vector<double> values;
+        std::vector<std::string> units;
+        core.getDataBlock( { D_GLOBAL_TAS, D_CO2_CONC, D_RF_TOTAL },
+                           { 1800, 1900, 1950 }, values, units );
+        return values;
+    }
+};
+
+TEST_F(TestScenario, SameAsParsing) {
+    std::unique_ptr<Core> parsed = newCore();
+    INIToCoreReader reader( parsed.get() );
+    reader.parse( iniFile() );
+
+    const Scenario scenario( iniFile() );
+    EXPECT_EQ( scenario.getFileName(), iniFile() );
+    std::unique_ptr<Core> applied = newCore();
+    applied->applyScenario( scenario );
+
+    EXPECT_EQ( results( *applied ), results( *parsed ) );
+    EXPECT_EQ( applied->getRun_name(), parsed->getRun_name() );
+}
+
+TEST_F(TestScenario, Overrides) {
+    const message_data ecs( unitval( 4.5, U_DEGC ) );
+
+    std::unique_ptr<Core> parsed = newCore();
+    INIToCoreReader reader( parsed.get() );
+    reader.parse( iniFile() );
+    parsed->setData( TEMPERATURE_COMPONENT_NAME, D_ECS, ecs );
+
+    std::unique_ptr<Core> applied = makeCore(
+        { ScenarioSetting( TEMPERATURE_COMPONENT_NAME, D_ECS, ecs ) } );
+    const std::vector<double> overridden = results( *applied );
+    EXPECT_EQ( overridden, results( *parsed ) );
+
+    // The scenario itself is unchanged
+    std::unique_ptr<Core> plain = makeCore();
+    EXPECT_NE( results( *plain ), overridden );
+}
+
+TEST_F(TestScenario, CopiesShareSettings) {
+    const Scenario copy = scenario();
+    EXPECT_GT( scenario().getSettings().size(), 1000u );
+    EXPECT_EQ( &copy.getSettings(), &scenario().getSettings() );
+}
+
+TEST_F(TestScenario, Errors) {
+    EXPECT_THROW( Scenario( "no_such_file.ini" ), h_exception );
+
+    // Values are checked when the scenario is read
+    const std::string bad = "scenario_test_file.ini";
+    {
+        std::ofstream ini( bad.c_str() );
+        ini << "[" << TEMPERATURE_COMPONENT_NAME << "]" << std::endl;
+        ini << D_ECS << "=3.0,W/m2" << std::endl;
+    }
+    EXPECT_THROW( Scenario( bad.c_str() ), h_exception );
+    std::remove( bad.c_str() );
+
+    Core core( Logger::SEVERE, false, false );
+    EXPECT_THROW( core.applyScenario( scenario() ), h_exception );
+}
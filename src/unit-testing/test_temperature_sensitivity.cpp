@@ -0,0 +1,115 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2022  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+/*
+ *  test_temperature_sensitivity.cpp
+ *  hector
+ *
+ *  Unit tests for temperature trajectories with parameter derivatives.
+ *
+ */
+
+#include <cmath>
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "component_data.hpp"
+#include "component_names.hpp"
+#include "core.hpp"
+#include "h_exception.hpp"
+#include "message_data.hpp"
+#include "scenario.hpp"
+#include "ssp245_test.hpp"
+#include "temperature_component.hpp"
+#include "temperature_sensitivity.hpp"
+
+using namespace Hector;
+
+/*! \brief Unit tests for the TemperatureSensitivity class.
+ */
+class TestTemperatureSensitivity : public SSP245Test {
+protected:
+    // A core prepared to run through 2100, with a parameter of the
+    // temperature component changed
+    std::unique_ptr<Core> newCore( const std::vector<ScenarioSetting> &overrides = {} ) {
+        std::vector<ScenarioSetting> settings = { endDate( 2100 ) };
+        settings.insert( settings.end(), overrides.begin(), overrides.end() );
+        std::unique_ptr<Core> core = makeCore( settings );
+        core->prepareToRun();
+        return core;
+    }
+
+    static const TemperatureComponent &temperature( Core &core ) {
+        return *dynamic_cast<TemperatureComponent *>(
+            core.getComponentByName( TEMPERATURE_COMPONENT_NAME ) );
+    }
+};
+
+TEST_F(TestTemperatureSensitivity, ValuesMatchRun) {
+    std::unique_ptr<Core> core = newCore();
+    core->run();
+    std::vector<double> forcing = fetch( *core, { D_RF_TOTAL } );
+    const std::vector<double> expected = fetch( *core, { D_GLOBAL_TAS } );
+    forcing.insert( forcing.begin(), 0.0 );
+
+    const TemperatureSensitivity sensitivity( temperature( *core ) );
+    TemperatureSensitivity::Trajectories values, derivs[TemperatureSensitivity::N_PARAMETERS];
+    sensitivity.compute( forcing, values, derivs );
+    ASSERT_EQ( values.temp.size(), forcing.size() );
+    for( size_t i = 0; i < expected.size(); ++i ) {
+        EXPECT_NEAR( values.temp[i + 1], expected[i], 1e-10 ) << i;
+    }
+    // More sensitive climate, warmer; more diffusive ocean, cooler
+    EXPECT_GT( derivs[TemperatureSensitivity::ECS].temp.back(), 0.0 );
+    EXPECT_LT( derivs[TemperatureSensitivity::DIFFUSIVITY].temp.back(), 0.0 );
+}
+
+TEST_F(TestTemperatureSensitivity, DerivativesMatchFiniteDifferences) {
+    std::vector<double> forcing( 300 );
+    for( size_t i = 1; i < forcing.size(); ++i ) {
+        forcing[i] = 0.01 * i + 0.5 * std::sin( 0.3 * i );
+    }
+    std::unique_ptr<Core> core = newCore();
+    TemperatureSensitivity::Trajectories values, derivs[TemperatureSensitivity::N_PARAMETERS];
+    TemperatureSensitivity( temperature( *core ) ).compute( forcing, values, derivs );
+
+    // q2co2 is reported in W/m2, but read without units
+    const struct { TemperatureSensitivity::Parameter p; const char *name; unit_types getUnits, units; } params[] = {
+        { TemperatureSensitivity::ECS, D_ECS, U_DEGC, U_DEGC },
+        { TemperatureSensitivity::DIFFUSIVITY, D_DIFFUSIVITY, U_CM2_S, U_CM2_S },
+        { TemperatureSensitivity::QCO2, D_QCO2, U_W_M2, U_UNITLESS } };
+    for( auto &param : params ) {
+        const double x = core->sendMessage( M_GETDATA, param.name ).value( param.getUnits );
+        const double h = 1e-4 * x;
+        TemperatureSensitivity::Trajectories up, down, unused[TemperatureSensitivity::N_PARAMETERS];
+        std::unique_ptr<Core> coreUp = newCore(
+            { ScenarioSetting( TEMPERATURE_COMPONENT_NAME, param.name, message_data( unitval( x + h, param.units ) ) ) } );
+        TemperatureSensitivity( temperature( *coreUp ) ).compute( forcing, up, unused );
+        std::unique_ptr<Core> coreDown = newCore(
+            { ScenarioSetting( TEMPERATURE_COMPONENT_NAME, param.name, message_data( unitval( x - h, param.units ) ) ) } );
+        TemperatureSensitivity( temperature( *coreDown ) ).compute( forcing, down, unused );
+
+        for( size_t i = 0; i < forcing.size(); ++i ) {
+            const double fdTemp = ( up.temp[i] - down.temp[i] ) / ( 2 * h );
+            EXPECT_NEAR( derivs[param.p].temp[i], fdTemp, 1e-6 * ( 1 + std::fabs( fdTemp ) ) )
+                << param.name << " " << i;
+            const double fdHeat = ( up.heat_interior[i] - down.heat_interior[i] ) / ( 2 * h );
+            EXPECT_NEAR( derivs[param.p].heat_interior[i], fdHeat, 1e-6 * ( 1 + std::fabs( fdHeat ) ) )
+                << param.name << " " << i;
+        }
+    }
+}
+
+TEST_F(TestTemperatureSensitivity, Errors) {
+    std::unique_ptr<Core> core = newCore();
+    const TemperatureSensitivity sensitivity( temperature( *core ) );
+    TemperatureSensitivity::Trajectories values, derivs[TemperatureSensitivity::N_PARAMETERS];
+    EXPECT_THROW( sensitivity.compute( std::vector<double>( sensitivity.maxYears() + 1 ), values, derivs ),
+                  h_exception );
+
+    TemperatureComponent unprepared;
+    EXPECT_THROW( TemperatureSensitivity sensitivity2( unprepared ), h_exception );
+}